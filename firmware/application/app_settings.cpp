@@ -26,7 +26,6 @@
 
 #include "convert.hpp"
 #include "file.hpp"
-#include "file_reader.hpp"
 #include "portapack.hpp"
 #include "portapack_persistent_memory.hpp"
 #include "utility.hpp"
@@ -45,67 +44,6 @@ fs::path get_settings_path(const std::string& app_name) {
 }
 }  // namespace
 
-void BoundSetting::parse(std::string_view value) {
-    switch (type_) {
-        case SettingType::I64:
-            parse_int(value, as<int64_t>());
-            break;
-        case SettingType::I32:
-            parse_int(value, as<int32_t>());
-            break;
-        case SettingType::U32:
-            parse_int(value, as<uint32_t>());
-            break;
-        case SettingType::U8:
-            parse_int(value, as<uint8_t>());
-            break;
-        case SettingType::String:
-            as<std::string>() = trim(value);
-            break;
-        case SettingType::Bool: {
-            int parsed = 0;
-            parse_int(value, parsed);
-            as<bool>() = (parsed != 0);
-            break;
-        }
-    };
-}
-
-void BoundSetting::write(File& file) const {
-    // NB: Write directly without allocations. This happens on every
-    // app exit when enabled so should be fast to keep the UX responsive.
-    StringFormatBuffer buffer;
-    size_t length = 0;
-
-    file.write(name_.data(), name_.length());
-    file.write("=", 1);
-
-    switch (type_) {
-        case SettingType::I64:
-            file.write(to_string_dec_int(as<int64_t>(), buffer, length), length);
-            break;
-        case SettingType::I32:
-            file.write(to_string_dec_int(as<int32_t>(), buffer, length), length);
-            break;
-        case SettingType::U32:
-            file.write(to_string_dec_uint(as<uint32_t>(), buffer, length), length);
-            break;
-        case SettingType::U8:
-            file.write(to_string_dec_uint(as<uint8_t>(), buffer, length), length);
-            break;
-        case SettingType::String: {
-            const auto& str = as<std::string>();
-            file.write(str.data(), str.length());
-            break;
-        }
-        case SettingType::Bool:
-            file.write(as<bool>() ? "1" : "0", 1);
-            break;
-    }
-
-    file.write("\r\n", 2);
-}
-
 SettingsStore::SettingsStore(std::string_view store_name, SettingBindings bindings)
     : store_name_{store_name}, bindings_{bindings} {
     reload();
@@ -116,44 +54,41 @@ SettingsStore::~SettingsStore() {
 }
 
 void SettingsStore::reload() {
-    load_settings(store_name_, bindings_);
+    load_settings(store_name_, bindings_, &saved_hash_);
 }
 
 void SettingsStore::save() const {
-    save_settings(store_name_, bindings_);
+    save_settings(store_name_, bindings_, &saved_hash_);
 }
 
-bool load_settings(std::string_view store_name, SettingBindings& bindings) {
+bool load_settings(std::string_view store_name, SettingBindings& bindings, uint32_t* saved_hash) {
     File f;
     auto path = get_settings_path(std::string{store_name});
 
+    if (saved_hash)
+        *saved_hash = 0;
+
     auto error = f.open(path);
     if (error)
         return false;
 
-    auto reader = FileLineReader(f);
-    for (const auto& line : reader) {
-        auto cols = split_string(line, '=');
+    auto bound = read_settings(f, bindings);
 
-        if (cols.size() != 2)
-            continue;
-
-        // Find a binding with the name.
-        auto it = std::find_if(
-            bindings.begin(), bindings.end(),
-            [name = cols[0]](auto& bound_setting) {
-                return name == bound_setting.name();
-            });
-
-        // If found, parse the value.
-        if (it != bindings.end())
-            it->parse(cols[1]);
-    }
+    // A file missing settings is rewritten on the next save.
+    if (saved_hash && bound >= bindings.size())
+        *saved_hash = hash_settings(bindings);
 
     return true;
 }
 
-bool save_settings(std::string_view store_name, const SettingBindings& bindings) {
+bool save_settings(std::string_view store_name, const SettingBindings& bindings, uint32_t* saved_hash) {
+    uint32_t hash = 0;
+    if (saved_hash) {
+        hash = hash_settings(bindings);
+        if (hash == *saved_hash)
+            return true;  // Unchanged since loaded or last saved.
+    }
+
     File f;
     auto path = get_settings_path(std::string{store_name});
 
@@ -162,8 +97,11 @@ bool save_settings(std::string_view store_name, const SettingBindings& bindings)
     if (error)
         return false;
 
-    for (const auto& bound_setting : bindings)
-        bound_setting.write(f);
+    if (!write_settings(f, bindings))
+        return false;
+
+    if (saved_hash)
+        *saved_hash = hash;
 
     return true;
 }
@@ -242,7 +180,8 @@ SettingsManager::SettingsManager(
     : app_name_{app_name},
       settings_{},
       bindings_{},
-      loaded_{false} {
+      loaded_{false},
+      saved_hash_{0} {
     settings_.mode = mode;
     settings_.options = options;
 
@@ -285,7 +224,7 @@ SettingsManager::SettingsManager(
     // or doesn't include all parameters). Settings in the file can overwrite all, or a subset of parameters.
     copy_from_radio_model(settings_);
 
-    loaded_ = load_settings(app_name_, bindings_);
+    loaded_ = load_settings(app_name_, bindings_, &saved_hash_);
 
     // Only copy to the radio if load was successful.
     if (loaded_)
@@ -295,7 +234,7 @@ SettingsManager::SettingsManager(
 SettingsManager::~SettingsManager() {
     copy_from_radio_model(settings_);
 
-    save_settings(app_name_, bindings_);
+    save_settings(app_name_, bindings_, &saved_hash_);
 }
 
 }  // namespace app_settings
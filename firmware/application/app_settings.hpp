@@ -32,6 +32,7 @@
 #include <utility>
 #include <variant>
 
+#include "bound_setting.hpp"
 #include "file.hpp"
 #include "max283x.hpp"
 #include "string_format.hpp"
@@ -41,55 +42,6 @@ using std::literals::operator""sv;
 
 #define COMMON_APP_SETTINGS_COUNT 19
 
-/* Represents a named setting bound to a variable instance. */
-/* Using void* instead of std::variant, because variant is a pain to dispatch over. */
-class BoundSetting {
-    /* The type of bound setting. */
-    enum class SettingType : uint8_t {
-        I64,
-        I32,
-        U32,
-        U8,
-        String,
-        Bool,
-    };
-
-   public:
-    BoundSetting(std::string_view name, int64_t* target)
-        : name_{name}, target_{target}, type_{SettingType::I64} {}
-
-    BoundSetting(std::string_view name, int32_t* target)
-        : name_{name}, target_{target}, type_{SettingType::I32} {}
-
-    BoundSetting(std::string_view name, uint32_t* target)
-        : name_{name}, target_{target}, type_{SettingType::U32} {}
-
-    BoundSetting(std::string_view name, uint8_t* target)
-        : name_{name}, target_{target}, type_{SettingType::U8} {}
-
-    BoundSetting(std::string_view name, std::string* target)
-        : name_{name}, target_{target}, type_{SettingType::String} {}
-
-    BoundSetting(std::string_view name, bool* target)
-        : name_{name}, target_{target}, type_{SettingType::Bool} {}
-
-    std::string_view name() const { return name_; }
-    void parse(std::string_view value);
-    void write(File& file) const;
-
-   private:
-    template <typename T>
-    constexpr auto& as() const {
-        return *reinterpret_cast<T*>(target_);
-    }
-
-    std::string_view name_;
-    void* target_;
-    SettingType type_;
-};
-
-using SettingBindings = std::vector<BoundSetting>;
-
 /* RAII wrapper for Settings that loads/saves to the SD card. */
 class SettingsStore {
    public:
@@ -102,10 +54,14 @@ class SettingsStore {
    private:
     std::string_view store_name_;
     SettingBindings bindings_;
+    mutable uint32_t saved_hash_{0};
 };
 
-bool load_settings(std::string_view store_name, SettingBindings& bindings);
-bool save_settings(std::string_view store_name, const SettingBindings& bindings);
+/* With saved_hash, load_settings records the hash of the loaded settings
+ * (0 if any were missing from the file) and save_settings skips writing
+ * when the settings still match it. */
+bool load_settings(std::string_view store_name, SettingBindings& bindings, uint32_t* saved_hash = nullptr);
+bool save_settings(std::string_view store_name, const SettingBindings& bindings, uint32_t* saved_hash = nullptr);
 
 namespace app_settings {
 
@@ -179,6 +135,7 @@ class SettingsManager {
     AppSettings settings_;
     SettingBindings bindings_;
     bool loaded_;
+    uint32_t saved_hash_;
 };
 
 }  // namespace app_settings
@@ -27,6 +27,7 @@
 #include "file_path.hpp"
 
 #include "baseband_api.hpp"
+#include "ais_baseband.hpp"
 
 #include "portapack.hpp"
 using namespace portapack;
@@ -199,8 +200,9 @@ void AISLogger::on_packet(const ais::Packet& packet) {
     }
 }
 
-void AISRecentEntry::update(const ais::Packet& packet) {
+void AISRecentEntry::update(const ais::Packet& packet, const uint32_t channel) {
     received_count++;
+    last_channel = channel;
 
     switch (packet.message_id()) {
         case 1:
@@ -366,6 +368,7 @@ void AISRecentEntryDetailView::paint(Painter& painter) {
     field_rect = draw_field(painter, field_rect, s, "CoG ", ais::format::course_over_ground(entry_.last_position.course_over_ground));
     field_rect = draw_field(painter, field_rect, s, "Head", ais::format::true_heading(entry_.last_position.true_heading));
     field_rect = draw_field(painter, field_rect, s, "Rx #", to_string_dec_uint(entry_.received_count));
+    field_rect = draw_field(painter, field_rect, s, "Ch  ", (entry_.last_channel == 0) ? "87B" : "88B");
 }
 
 void AISRecentEntryDetailView::set_entry(const AISRecentEntry& entry) {
@@ -379,7 +382,7 @@ AISAppView::AISAppView(NavigationView& nav)
 
     add_children({
         &label_channel,
-        &options_channel,
+        &text_channel,
         &field_rf_amp,
         &field_lna,
         &field_vga,
@@ -394,10 +397,7 @@ AISAppView::AISAppView(NavigationView& nav)
 
     receiver_model.enable();
 
-    options_channel.on_change = [this](size_t, OptionsField::value_t v) {
-        receiver_model.set_target_frequency(v);
-    };
-    options_channel.set_by_value(receiver_model.target_frequency());
+    receiver_model.set_target_frequency(baseband::ais::center_frequency);
 
     recent_entries_view.on_select = [this](const AISRecentEntry& entry) {
         on_show_detail(entry);
@@ -424,7 +424,7 @@ AISAppView::~AISAppView() {
 }
 
 void AISAppView::focus() {
-    options_channel.focus();
+    field_rf_amp.focus();
 }
 
 void AISAppView::set_parent_rect(const Rect new_parent_rect) {
@@ -434,13 +434,13 @@ void AISAppView::set_parent_rect(const Rect new_parent_rect) {
     recent_entry_detail_view.set_parent_rect(content_rect);
 }
 
-void AISAppView::on_packet(const ais::Packet& packet) {
+void AISAppView::on_packet(const ais::Packet& packet, const uint32_t channel) {
     if (logger) {
         logger->on_packet(packet);
     }
 
     auto& entry = ::on_packet(recent, packet.source_id());
-    entry.update(packet);
+    entry.update(packet, channel);
     recent_entries_view.set_dirty();
 
     // TODO: Crude hack, should be a more formal listener arrangement...
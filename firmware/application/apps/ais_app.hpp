@@ -72,6 +72,7 @@ struct AISRecentEntry {
     AISPosition last_position;
     size_t received_count;
     int8_t navigational_status;
+    uint32_t last_channel;
 
     AISRecentEntry()
         : AISRecentEntry{0} {
@@ -85,14 +86,15 @@ struct AISRecentEntry {
           destination{},
           last_position{},
           received_count{0},
-          navigational_status{-1} {
+          navigational_status{-1},
+          last_channel{0} {
     }
 
     Key key() const {
         return mmsi;
     }
 
-    void update(const ais::Packet& packet);
+    void update(const ais::Packet& packet, const uint32_t channel);
 };
 
 using AISRecentEntries = RecentEntries<AISRecentEntry>;
@@ -188,13 +190,10 @@ class AISAppView : public View {
         {0 * 8, 0 * 16, 2 * 8, 1 * 16},
         "Ch"};
 
-    OptionsField options_channel{
-        {3 * 8, 0 * 16},
-        3,
-        {
-            {"87B", 161975000},
-            {"88B", 162025000},
-        }};
+    // Both channels are received at once.
+    Text text_channel{
+        {3 * 8, 0 * 16, 7 * 8, 1 * 16},
+        "87B+88B"};
 
     RFAmpField field_rf_amp{
         {13 * 8, 0 * 16}};
@@ -222,11 +221,11 @@ class AISAppView : public View {
             const auto message = static_cast<const AISPacketMessage*>(p);
             const ais::Packet packet{message->packet};
             if (packet.is_valid()) {
-                this->on_packet(packet);
+                this->on_packet(packet, message->channel);
             }
         }};
 
-    void on_packet(const ais::Packet& packet);
+    void on_packet(const ais::Packet& packet, const uint32_t channel);
     void on_show_list();
     void on_show_detail(const AISRecentEntry& entry);
 };
@@ -139,6 +139,54 @@ SPECOptionsView::SPECOptionsView(
     view->set_spec_iq_phase_calibration_value(view->get_spec_iq_phase_calibration_value());  // initialize iq_phase_calibration in radio
 }
 
+/* WaterfallOptionsView **************************************************/
+
+WaterfallOptionsView::WaterfallOptionsView(
+    AnalogAudioView* view,
+    Rect parent_rect,
+    const Style* style)
+    : View{parent_rect} {
+    set_style(style);
+
+    add_children({
+        &label_zoom,
+        &options_zoom,
+        &label_persistence,
+        &options_persistence,
+        &label_rows,
+        &field_rows,
+        &label_fft,
+        &options_fft,
+        &label_averaging,
+        &options_averaging,
+    });
+
+    options_zoom.set_by_value(view->get_waterfall_zoom());
+    options_zoom.on_change = [this, view](size_t, OptionsField::value_t v) {
+        view->set_waterfall_zoom(v);
+    };
+
+    options_persistence.set_by_value(view->get_waterfall_persistence());
+    options_persistence.on_change = [this, view](size_t, OptionsField::value_t v) {
+        view->set_waterfall_persistence(v);
+    };
+
+    field_rows.set_value(view->get_waterfall_rows());
+    field_rows.on_change = [this, view](int32_t v) {
+        view->set_waterfall_rows(v);
+    };
+
+    options_fft.set_by_value(view->get_waterfall_fft_size_log2());
+    options_fft.on_change = [this, view](size_t, OptionsField::value_t v) {
+        view->set_waterfall_fft_size_log2(v);
+    };
+
+    options_averaging.set_by_value(view->get_waterfall_averaging());
+    options_averaging.on_change = [this, view](size_t, OptionsField::value_t v) {
+        view->set_waterfall_averaging(v);
+    };
+}
+
 /* AnalogAudioView *******************************************************/
 
 AnalogAudioView::AnalogAudioView(
@@ -194,6 +242,11 @@ AnalogAudioView::AnalogAudioView(
     waterfall.on_select = [this](int32_t offset) {
         field_frequency.set_value(receiver_model.target_frequency() + offset);
     };
+    waterfall.on_show_options = [this]() {
+        this->on_show_options_waterfall();
+    };
+    update_waterfall_spectrum();
+    update_waterfall_display();
 
     audio::output::start();
 
@@ -245,6 +298,90 @@ void AnalogAudioView::set_spec_trigger(uint16_t trigger) {
     baseband::set_spectrum(spec_bw, spec_trigger);
 }
 
+uint8_t AnalogAudioView::get_waterfall_fft_size_log2() {
+    return waterfall_fft_size_log2;
+}
+
+void AnalogAudioView::set_waterfall_fft_size_log2(uint8_t fft_size_log2) {
+    waterfall_fft_size_log2 = fft_size_log2;
+    update_waterfall_spectrum();
+    update_waterfall_display();
+}
+
+uint8_t AnalogAudioView::get_waterfall_averaging() {
+    return waterfall_averaging;
+}
+
+void AnalogAudioView::set_waterfall_averaging(uint8_t averaging) {
+    waterfall_averaging = averaging;
+    update_waterfall_spectrum();
+    update_waterfall_display();
+}
+
+void AnalogAudioView::update_waterfall_spectrum() {
+    using Averaging = SpectrumStreamingConfigMessage::Averaging;
+
+    // Values may come from an edited settings file.
+    waterfall_fft_size_log2 = clip(waterfall_fft_size_log2, SpectrumStreamingConfigMessage::fft_size_log2_min, SpectrumStreamingConfigMessage::fft_size_log2_max);
+    if (waterfall_averaging > toUType(Averaging::MinHold))
+        waterfall_averaging = toUType(Averaging::None);
+
+    // Means over 4 spectra, holds over 8.
+    const auto averaging = static_cast<Averaging>(waterfall_averaging);
+    uint8_t average_count = 1;
+    if ((averaging == Averaging::Linear) || (averaging == Averaging::Log))
+        average_count = 4;
+    else if (averaging != Averaging::None)
+        average_count = 8;
+
+    waterfall.set_spectrum_options(waterfall_fft_size_log2, averaging, average_count);
+}
+
+uint8_t AnalogAudioView::get_waterfall_zoom() {
+    return waterfall_zoom;
+}
+
+void AnalogAudioView::set_waterfall_zoom(uint8_t zoom) {
+    waterfall_zoom = zoom;
+    update_waterfall_display();
+}
+
+uint8_t AnalogAudioView::get_waterfall_persistence() {
+    return waterfall_persistence;
+}
+
+void AnalogAudioView::set_waterfall_persistence(uint8_t persistence) {
+    waterfall_persistence = persistence;
+    update_waterfall_display();
+}
+
+uint8_t AnalogAudioView::get_waterfall_rows() {
+    return waterfall_rows;
+}
+
+void AnalogAudioView::set_waterfall_rows(uint8_t rows) {
+    waterfall_rows = rows;
+    update_waterfall_display();
+}
+
+void AnalogAudioView::update_waterfall_display() {
+    using Persistence = spectrum::WaterfallWidget::Persistence;
+
+    // Values may come from an edited settings file.
+    // Zoom rounds down to one options_zoom offers: fit, 1x, 2x or 4x.
+    if (waterfall_zoom >= 4)
+        waterfall_zoom = 4;
+    else if (waterfall_zoom == 3)
+        waterfall_zoom = 2;
+    if (waterfall_persistence > toUType(Persistence::PeakHold))
+        waterfall_persistence = toUType(Persistence::None);
+    waterfall_rows = clip<uint8_t>(waterfall_rows, 1, spectrum::WaterfallWidget::max_rows);
+
+    waterfall.set_zoom(waterfall_zoom);
+    waterfall.set_persistence(static_cast<Persistence>(waterfall_persistence));
+    waterfall.set_rows_per_spectrum(waterfall_rows);
+}
+
 AnalogAudioView::~AnalogAudioView() {
     audio::output::stop();
     receiver_model.disable();
@@ -271,10 +408,10 @@ void AnalogAudioView::on_modulation_changed(ReceiverModel::Mode modulation) {
     if (modulation > ReceiverModel::Mode::SpectrumAnalysis)
         modulation = ReceiverModel::Mode::SpectrumAnalysis;
 
-    baseband::spectrum_streaming_stop();
+    waterfall.stop();
     update_modulation(modulation);
     on_show_options_modulation();
-    baseband::spectrum_streaming_start();
+    waterfall.start();
 }
 
 void AnalogAudioView::remove_options_widget() {
@@ -361,6 +498,13 @@ void AnalogAudioView::on_show_options_modulation() {
     options_modulation.set_style(Theme::getInstance()->option_active);
 }
 
+void AnalogAudioView::on_show_options_waterfall() {
+    auto widget = std::make_unique<WaterfallOptionsView>(this, options_view_rect, Theme::getInstance()->option_active);
+    text_ctcss.hidden(true);
+
+    set_options_widget(std::move(widget));
+}
+
 void AnalogAudioView::on_frequency_step_changed(rf::Frequency f) {
     receiver_model.set_frequency_step(f);
     field_frequency.set_step(f);
@@ -431,8 +575,8 @@ void AnalogAudioView::update_modulation(ReceiverModel::Mode modulation) {
     }
 }
 
-void AnalogAudioView::handle_coded_squelch(uint32_t value) {
-    text_ctcss.set(tone_key_string_by_value(value, text_ctcss.parent_rect().width() / 8));
+void AnalogAudioView::handle_coded_squelch(const CodedSquelchMessage& message) {
+    text_ctcss.set(coded_squelch_string(message, text_ctcss.parent_rect().width() / 8));
 }
 
 void AnalogAudioView::on_freqchg(int64_t freq) {
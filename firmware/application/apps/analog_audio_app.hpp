@@ -144,6 +144,81 @@ class SPECOptionsView : public View {
     };
 };
 
+/* Display and spectrum options of the waterfall, shown while its cursor has the focus. */
+class WaterfallOptionsView : public View {
+   public:
+    WaterfallOptionsView(AnalogAudioView* view, Rect parent_rect, const Style* style);
+
+   private:
+    Text label_zoom{
+        {0 * 8, 0 * 16, 2 * 8, 1 * 16},
+        "Zm",
+    };
+    OptionsField options_zoom{
+        {2 * 8, 0 * 16},
+        3,
+        {
+            {"fit", 0},
+            {" 1x", 1},
+            {" 2x", 2},
+            {" 4x", 4},
+        }};
+
+    Text label_persistence{
+        {6 * 8, 0 * 16, 2 * 8, 1 * 16},
+        "Tr",
+    };
+    OptionsField options_persistence{
+        {8 * 8, 0 * 16},
+        4,
+        {
+            {"off ", toUType(spectrum::WaterfallWidget::Persistence::None)},
+            {"fade", toUType(spectrum::WaterfallWidget::Persistence::Decay)},
+            {"avg ", toUType(spectrum::WaterfallWidget::Persistence::Average)},
+            {"peak", toUType(spectrum::WaterfallWidget::Persistence::PeakHold)},
+        }};
+
+    Text label_rows{
+        {13 * 8, 0 * 16, 2 * 8, 1 * 16},
+        "Rw",
+    };
+    NumberField field_rows{
+        {15 * 8, 0 * 16},
+        1,
+        {1, spectrum::WaterfallWidget::max_rows},
+        1,
+        ' ',
+    };
+
+    Text label_fft{
+        {18 * 8, 0 * 16, 3 * 8, 1 * 16},
+        "FFT",
+    };
+    OptionsField options_fft{
+        {21 * 8, 0 * 16},
+        3,
+        {
+            {"256", 8},
+            {"128", 7},
+            {" 64", 6},
+        }};
+
+    Text label_averaging{
+        {25 * 8, 0 * 16, 2 * 8, 1 * 16},
+        "Av",
+    };
+    OptionsField options_averaging{
+        {27 * 8, 0 * 16},
+        3,
+        {
+            {"off", toUType(SpectrumStreamingConfigMessage::Averaging::None)},
+            {"lin", toUType(SpectrumStreamingConfigMessage::Averaging::Linear)},
+            {"log", toUType(SpectrumStreamingConfigMessage::Averaging::Log)},
+            {"pk ", toUType(SpectrumStreamingConfigMessage::Averaging::PeakHold)},
+            {"min", toUType(SpectrumStreamingConfigMessage::Averaging::MinHold)},
+        }};
+};
+
 class AnalogAudioView : public View {
    public:
     AnalogAudioView(NavigationView& nav);
@@ -164,17 +239,42 @@ class AnalogAudioView : public View {
     uint8_t get_spec_iq_phase_calibration_value();
     void set_spec_iq_phase_calibration_value(uint8_t cal_value);
 
+    uint8_t get_waterfall_fft_size_log2();
+    void set_waterfall_fft_size_log2(uint8_t fft_size_log2);
+
+    uint8_t get_waterfall_averaging();
+    void set_waterfall_averaging(uint8_t averaging);
+
+    uint8_t get_waterfall_zoom();
+    void set_waterfall_zoom(uint8_t zoom);
+
+    uint8_t get_waterfall_persistence();
+    void set_waterfall_persistence(uint8_t persistence);
+
+    uint8_t get_waterfall_rows();
+    void set_waterfall_rows(uint8_t rows);
+
    private:
     static constexpr ui::Dim header_height = 3 * 16;
 
     NavigationView& nav_;
     RxRadioState radio_state_{};
     uint8_t iq_phase_calibration_value{15};  // initial default RX IQ phase calibration value , used for both max2837 & max2839
+    uint8_t waterfall_fft_size_log2{SpectrumStreamingConfigMessage::fft_size_log2_max};
+    uint8_t waterfall_averaging{toUType(SpectrumStreamingConfigMessage::Averaging::None)};
+    uint8_t waterfall_zoom{1};  // 1:1 bins to pixels, as before the zoom setting
+    uint8_t waterfall_persistence{toUType(spectrum::WaterfallWidget::Persistence::None)};
+    uint8_t waterfall_rows{1};
     app_settings::SettingsManager settings_{
         "rx_audio",
         app_settings::Mode::RX,
         {
             {"iq_phase_calibration"sv, &iq_phase_calibration_value},  // we are saving and restoring that CAL from Settings.
+            {"waterfall_fft"sv, &waterfall_fft_size_log2},
+            {"waterfall_avg"sv, &waterfall_averaging},
+            {"waterfall_zoom"sv, &waterfall_zoom},
+            {"waterfall_trail"sv, &waterfall_persistence},
+            {"waterfall_rows"sv, &waterfall_rows},
         }};
 
     const Rect options_view_rect{0 * 8, 1 * 16, 30 * 8, 1 * 16};
@@ -237,6 +337,7 @@ class AnalogAudioView : public View {
     void on_show_options_frequency();
     void on_show_options_rf_gain();
     void on_show_options_modulation();
+    void on_show_options_waterfall();
     void on_frequency_step_changed(rf::Frequency f);
     void on_reference_ppm_correction_changed(int32_t v);
 
@@ -244,16 +345,18 @@ class AnalogAudioView : public View {
     void set_options_widget(std::unique_ptr<Widget> new_widget);
 
     void update_modulation(ReceiverModel::Mode modulation);
+    void update_waterfall_spectrum();
+    void update_waterfall_display();
 
-    void handle_coded_squelch(uint32_t value);
+    void handle_coded_squelch(const CodedSquelchMessage& message);
 
     void on_freqchg(int64_t freq);
 
     MessageHandlerRegistration message_handler_coded_squelch{
         Message::ID::CodedSquelch,
         [this](const Message* p) {
-            const auto message = *reinterpret_cast<const CodedSquelchMessage*>(p);
-            this->handle_coded_squelch(message.value);
+            const auto& message = *reinterpret_cast<const CodedSquelchMessage*>(p);
+            this->handle_coded_squelch(message);
         }};
 
     MessageHandlerRegistration message_handler_freqchg{
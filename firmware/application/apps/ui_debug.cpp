@@ -27,6 +27,7 @@
 #include "ch.h"
 
 #include "radio.hpp"
+#include "core_control.hpp"
 #include "string_format.hpp"
 #include "crc.hpp"
 
@@ -41,6 +42,7 @@
 
 #include "portapack.hpp"
 #include "portapack_persistent_memory.hpp"
+#include "portapack_shared_memory.hpp"
 using namespace portapack;
 
 #include "irq_controls.hpp"
@@ -421,6 +423,7 @@ void DebugMenuView::on_populate() {
         {"Buttons Test", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_controls, [this]() { nav_.push<DebugControlsView>(); }},
         {"Debug Dump", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_memory, [this]() { portapack::persistent_memory::debug_dump(); }},
         {"M0 Stack Dump", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_memory, [this]() { stack_dump(); }},
+        {"M4 Profile", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_memory, [this]() { nav_.push<DebugM4ProfileView>(); }},
         {"Memory Dump", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_memory, [this]() { nav_.push<DebugMemoryDumpView>(); }},
         {"Peripherals", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_peripherals, [this]() { nav_.push<DebugPeripheralsMenuView>(); }},
         {"Pers. Memory", ui::Theme::getInstance()->fg_darkcyan->foreground, &bitmap_icon_memory, [this]() { nav_.push<DebugPmemView>(); }},
@@ -511,6 +514,75 @@ void DebugPmemView::update() {
     registers_widget.update();
 }
 
+/* DebugM4ProfileView ****************************************************/
+
+DebugM4ProfileView::DebugM4ProfileView(NavigationView& nav) {
+    for (size_t i = 0; i < row_count; i++) {
+        row_texts[i].set_parent_rect({0 * 8, static_cast<int>((i + 5) * 16), 30 * 8, 16});
+        add_child(&row_texts[i]);
+    }
+
+    add_children({&check_profile, &text_rate, &labels, &text_loads, &text_load_time, &button_done});
+
+    check_profile.set_value(shared_memory.request_m4_profile);
+    check_profile.on_select = [this](Checkbox&, bool v) {
+        shared_memory.request_m4_profile = v;
+        if (!v)
+            shared_memory.m4_profile.sequence = 0;
+        update();
+    };
+
+    button_done.on_select = [&nav](Button&) {
+        nav.pop();
+    };
+
+    update();
+}
+
+void DebugM4ProfileView::focus() {
+    check_profile.focus();
+}
+
+void DebugM4ProfileView::on_frame_sync() {
+    if (++frames >= update_frames) {
+        frames = 0;
+        update();
+    }
+}
+
+void DebugM4ProfileView::update() {
+    const auto& loads = m4_load::stats();
+    text_loads.set("Loads " + to_string_dec_uint(loads.count) +
+                   " kept " + to_string_dec_uint(loads.resident_hits) +
+                   " recent " + to_string_dec_uint(loads.recent_hits));
+    text_load_time.set("Load " + to_string_dec_uint(loads.last_us) +
+                       "us max " + to_string_dec_uint(loads.max_us) + "us");
+
+    baseband::profile::Snapshot snapshot;
+    if (!baseband::profile::read(shared_memory.m4_profile, snapshot)) {
+        text_rate.set(shared_memory.request_m4_profile ? "No data, run an RX app." : "Profiling is off.");
+        for (auto& text : row_texts)
+            text.set("");
+        return;
+    }
+
+    text_rate.set(to_string_dec_uint(snapshot.sampling_rate) + " Hz " + to_string_dec_uint(snapshot.budget) + " cyc/buf");
+
+    const auto row = [&snapshot](const char* name, const uint32_t average, const uint32_t peak) {
+        std::string line{name};
+        line.resize(9, ' ');
+        return line +
+               to_string_dec_uint(snapshot.percent(average), 4) + "%" +
+               to_string_dec_uint(snapshot.percent(peak), 5) + "%" +
+               to_string_dec_uint(average, 9);
+    };
+
+    for (size_t i = 0; i < baseband::profile::stage_count; i++)
+        row_texts[i].set(row(baseband::profile::stage_name(i), snapshot.average[i], snapshot.peak[i]));
+
+    row_texts[row_count - 1].set(row("total", snapshot.total_average, snapshot.total_peak));
+}
+
 /* DebugScreenTest ****************************************************/
 
 DebugScreenTest::DebugScreenTest(NavigationView& nav)
@@ -34,6 +34,7 @@
 #include "portapack.hpp"
 #include "memory_map.hpp"
 #include "irq_controls.hpp"
+#include "baseband_profile.hpp"
 
 #include <functional>
 #include <utility>
@@ -339,6 +340,51 @@ class DebugPmemView : public View {
     void update();
 };
 
+class DebugM4ProfileView : public View {
+   public:
+    DebugM4ProfileView(NavigationView& nav);
+    void focus() override;
+    std::string title() const override { return "M4 Profile"; };
+
+   private:
+    static constexpr size_t row_count = baseband::profile::stage_count + 1;
+    static constexpr uint32_t update_frames = 30;
+
+    Checkbox check_profile{
+        {0 * 8, 0 * 16},
+        20,
+        "Profile M4 stages"};
+
+    Text text_rate{{0 * 8, 2 * 16, 30 * 8, 16}};
+
+    Labels labels{
+        {{0 * 8, 4 * 16}, "Stage", Theme::getInstance()->fg_yellow->foreground},
+        {{10 * 8, 4 * 16}, "avg", Theme::getInstance()->fg_yellow->foreground},
+        {{15 * 8, 4 * 16}, "peak", Theme::getInstance()->fg_yellow->foreground},
+        {{21 * 8, 4 * 16}, "cycles", Theme::getInstance()->fg_yellow->foreground}};
+
+    std::array<Text, row_count> row_texts{};
+
+    /* Baseband image loads on the M0 side, see m4_load::stats(). */
+    Text text_loads{{0 * 8, 15 * 16, 30 * 8, 16}};
+    Text text_load_time{{0 * 8, 16 * 16, 30 * 8, 16}};
+
+    Button button_done{
+        {72, 280, 96, 24},
+        "Done"};
+
+    uint32_t frames{0};
+
+    MessageHandlerRegistration message_handler_frame_sync{
+        Message::ID::DisplayFrameSync,
+        [this](const Message* const) {
+            this->on_frame_sync();
+        }};
+
+    void on_frame_sync();
+    void update();
+};
+
 class DebugScreenTest : public View {
    public:
     DebugScreenTest(NavigationView& nav);
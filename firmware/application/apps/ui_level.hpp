@@ -186,7 +186,7 @@ class LevelView : public View {
         {240 - 5 * 8, 6 * 16 + 8, 5 * 8, 320 - (6 * 16)},
     };
 
-    void handle_coded_squelch(const uint32_t value);
+    void handle_coded_squelch(const CodedSquelchMessage& message);
 
     void on_freqchg(int64_t freq);
 
@@ -200,8 +200,8 @@ class LevelView : public View {
     MessageHandlerRegistration message_handler_coded_squelch{
         Message::ID::CodedSquelch,
         [this](const Message* const p) {
-            const auto message = *reinterpret_cast<const CodedSquelchMessage*>(p);
-            this->handle_coded_squelch(message.value);
+            const auto& message = *reinterpret_cast<const CodedSquelchMessage*>(p);
+            this->handle_coded_squelch(message);
         }};
 
     MessageHandlerRegistration message_handler_stats{
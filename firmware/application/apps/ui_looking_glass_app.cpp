@@ -107,17 +107,47 @@ void GlassView::on_marker_change() {
     plot_marker(marker_pixel_index);  // Refresh marker on screen
 }
 
-void GlassView::retune() {
-    // Start a new sweep.
-    // Tune rx for this new slice directly because the model
-    // saves to persistent memory which is slower.
-    radio::set_tuning_frequency(f_center);
-    chThdSleepMilliseconds(5);             // stabilize freq
-    baseband::spectrum_streaming_start();  // Do the RX
+void GlassView::restart_sweep() {
+    sweep_slice = 0;
+    if (mode == LOOKING_GLASS_SINGLEPASS) {
+        sweep.stop();
+        if (live_frequency_view == 0)
+            freq_stats.hidden(true);
+        return;
+    }
+
+    // Enough slices to complete a waterfall line, plus a spare one so the
+    // line always completes before the plan wraps around.
+    const rf::Frequency line_bins = (SCREEN_W * marker_pixel_step + each_bin_size - 1) / each_bin_size;
+    const rf::Frequency slice_bins = bin_length + ignore_dc;
+    const size_t slices = (line_bins + slice_bins - 1) / slice_bins + 1;
+
+    // The baseband drops ~1ms of buffers after each retune to let the PLL settle.
+    const uint32_t settle_buffers = looking_glass_sampling_rate / (2048 * 1000) + 1;
+
+    sweep.start(f_center_ini, looking_glass_step, slices, settle_buffers);
+    if (live_frequency_view == 0)
+        freq_stats.hidden(false);
+}
+
+void GlassView::update_sweep_stats() {
+    // The line is shared with the max hold frequency of the live views.
+    if (live_frequency_view == 0 && sweep.is_running())
+        freq_stats.set("SWEEP: " + to_string_decimal(sweep.sweeps_per_second(), 1) + "/s");
+}
+
+void GlassView::drain_spectrum_fifo() {
+    if (fifo) {
+        ChannelSpectrum channel_spectrum;
+        while (fifo->out(channel_spectrum)) {
+            on_channel_spectrum(channel_spectrum);
+        }
+    }
 }
 
 void GlassView::reset_live_view() {
     max_freq_hold = 0;
+    last_max_freq = 0;
     max_freq_power = -1000;
 
     // Clear screen in peak mode.
@@ -182,9 +212,9 @@ bool GlassView::process_bins(uint8_t* powerlevel) {
         if (!pixel_index)  // Received indication that a waterfall line has been completed
         {
             bins_hz_size = 0;  // Since this is an entire pixel line, we don't carry "Pixels into next bin"
-            if (mode != LOOKING_GLASS_SINGLEPASS) {
-                f_center = f_center_ini;
-                retune();
+            if (sweep.is_running()) {
+                sweep_slice = 0;
+                update_sweep_stats();
             } else
                 baseband::spectrum_streaming_start();
             return true;  // signal a new line
@@ -197,7 +227,12 @@ bool GlassView::process_bins(uint8_t* powerlevel) {
 // Apparently, the spectrum object returns an array of SPEC_NB_BINS (256) bins
 // Each having the radio signal power for its corresponding frequency slot
 void GlassView::on_channel_spectrum(const ChannelSpectrum& spectrum) {
-    baseband::spectrum_streaming_stop();
+    if (sweep.is_running()) {
+        // Slices captured past the end of the line (or before a restart) are dropped.
+        if (spectrum.sweep_slice != sweep_slice)
+            return;
+    } else
+        baseband::spectrum_streaming_stop();
     // Convert bins of this spectrum slice into a representative max_power and when enough, into pixels
     // we actually need SCREEN_W (240) of those bins
     for (uint8_t bin = 0; bin < bin_length; bin++) {
@@ -224,15 +259,16 @@ void GlassView::on_channel_spectrum(const ChannelSpectrum& spectrum) {
             return;  // new line signaled, return
         }
     }
-    if (mode != LOOKING_GLASS_SINGLEPASS) {
-        f_center += looking_glass_step;
-        retune();
+    if (sweep.is_running()) {
+        if (++sweep_slice >= sweep.slices())
+            sweep_slice = 0;
     } else {
         baseband::spectrum_streaming_start();
     }
 }
 
 void GlassView::on_hide() {
+    sweep.stop();
     baseband::spectrum_streaming_stop();
     display.scroll_disable();
 }
@@ -240,6 +276,7 @@ void GlassView::on_hide() {
 void GlassView::on_show() {
     display.scroll_set_area(109, 319);  // Restart scroll on the correct coordinates
     baseband::spectrum_streaming_start();
+    restart_sweep();
 }
 
 void GlassView::on_range_changed() {
@@ -296,6 +333,7 @@ void GlassView::on_range_changed() {
     f_center = f_center_ini;  // Reset sweep into first slice
     baseband::set_spectrum(looking_glass_bandwidth, trigger);
     receiver_model.set_target_frequency(f_center);  // tune rx for this slice
+    restart_sweep();
 }
 
 void GlassView::plot_marker(uint8_t pos) {
@@ -430,7 +468,8 @@ GlassView::GlassView(
         switch (v) {
             case 0:  // SPEC
                 level_integration.hidden(true);
-                freq_stats.hidden(true);
+                freq_stats.set("");
+                freq_stats.hidden(!sweep.is_running());
                 button_jump.hidden(true);
                 button_rst.hidden(true);
                 display.scroll_set_area(109, 319);  // Restart scroll on the correct coordinates.
@@ -529,10 +568,10 @@ GlassView::GlassView(
 
     display.scroll_set_area(109, 319);
 
-    // trigger:
-    // Discord User jteich:  WidebandSpectrum::on_message to set the trigger value. In WidebandSpectrum::execute,
-    // it keeps adding the output of the fft to the buffer until "trigger" number of calls are made,
-    // at which time it pushes the buffer up with channel_spectrum.feed
+    // trigger (RES):
+    // WidebandSpectrum averages the power of up to 16 windowed frames over "trigger" buffers, then publishes.
+    // It no longer sums samples coherently across the buffers, so a steady tone reads about 24 dB lower than
+    // it used to at trigger 127 (less at lower triggers), while the noise floor stays where it was.
     baseband::set_spectrum(looking_glass_bandwidth, trigger);
 
     marker_pixel_index = SCREEN_W / 2;
@@ -36,6 +36,7 @@
 #include "string_format.hpp"
 #include "analog_audio_app.hpp"
 #include "spectrum_color_lut.hpp"
+#include "frequency_sweep.hpp"
 
 namespace ui {
 
@@ -121,7 +122,9 @@ class GlassView : public View {
     void get_max_power(const ChannelSpectrum& spectrum, uint8_t bin, uint8_t& max_power);
     rf::Frequency get_freq_from_bin_pos(uint8_t pos);
     void on_marker_change();
-    void retune();
+    void restart_sweep();
+    void update_sweep_stats();
+    void drain_spectrum_fifo();
     bool process_bins(uint8_t* powerlevel);
     void on_channel_spectrum(const ChannelSpectrum& spectrum);
     void do_timers();
@@ -158,6 +161,10 @@ class GlassView : public View {
     std::array<uint8_t, SCREEN_W> spectrum_data{};
     ChannelSpectrumFIFO* fifo{};
 
+    // Multi-pass views sweep the slices through the baseband sweep mode.
+    FrequencySweep sweep{};
+    size_t sweep_slice{0};  // Slice expected next from the FIFO.
+
     int32_t steps = 1;
     bool locked_range = false;
 
@@ -313,12 +320,14 @@ class GlassView : public View {
     MessageHandlerRegistration message_handler_frame_sync{
         Message::ID::DisplayFrameSync,
         [this](const Message* const) {
-            if (this->fifo) {
-                ChannelSpectrum channel_spectrum;
-                while (fifo->out(channel_spectrum)) {
-                    this->on_channel_spectrum(channel_spectrum);
-                }
-            }
+            this->drain_spectrum_fifo();
+        }};
+
+    MessageHandlerRegistration message_handler_sweep_captured{
+        Message::ID::SpectrumSweepCaptured,
+        [this](const Message* const) {
+            this->drain_spectrum_fifo();
+            this->sweep.on_captured();
         }};
 
     MessageHandlerRegistration message_handler_freqchg{
@@ -832,6 +832,7 @@ void ReconView::on_statistics_update(const ChannelStatistics& statistics) {
     chrono_end = chTimeNow();
     systime_t time_interval = chrono_end - chrono_start;
     chrono_start = chrono_end;
+    bool window_start = false;
 
     // hack to reload the list if it was cleared by going into CONFIG
     if (freqlist_cleared_for_ui_action) {
@@ -1082,6 +1083,8 @@ void ReconView::on_statistics_update(const ChannelStatistics& statistics) {
                             default:
                                 break;
                         }
+                        // Automatic steps watch the entries around the new one at once
+                        window_start = recon && !stepper && !index_stepper;
                     }
                     if (has_looped && !continuous) {
                         recon_pause();
@@ -1094,6 +1097,67 @@ void ReconView::on_statistics_update(const ChannelStatistics& statistics) {
         }          /* on_statistics_updates */
     }
     handle_retune();
+    if (window_start)
+        monitor_window_start();  // After the retune, the monitor settles on the new window
+    recon_redraw();
+}
+
+// Send the consecutive Single entries (in scanning direction, without wrapping) that fit
+// around the tuned one to the baseband. Only the NFM baseband has a channel monitor
+void ReconView::monitor_window_start() {
+    std::array<int32_t, ChannelMonitorConfigMessage::max_channels> offsets{};
+    const int32_t direction = fwd ? 1 : -1;
+    const auto& tuned = current_entry();
+
+    monitor_count = 0;
+    if (recon && !manual_mode && field_mode.selected_index_value() == NFM_MODULATION) {
+        for (int32_t index = current_index; (index >= 0) && ((size_t)index < frequency_list.size()); index += direction) {
+            const auto& entry = *frequency_list[index];
+            const int64_t offset = entry.frequency_a - freq;
+            if ((entry.type != freqman_type::Single) || (entry.modulation != tuned.modulation) || (entry.bandwidth != tuned.bandwidth) ||
+                (offset < -ChannelMonitorConfigMessage::max_offset) || (offset > ChannelMonitorConfigMessage::max_offset))
+                break;
+
+            offsets[monitor_count] = offset;
+            monitor_indexes[monitor_count++] = index;
+            if (monitor_count == monitor_indexes.size())
+                break;
+        }
+    }
+
+    if (monitor_count < 2) {  // Nothing to skip
+        monitor_window_stop();
+        return;
+    }
+
+    monitor_pending = true;
+    baseband::channel_monitor_start(offsets, monitor_count, receiver_model.nbfm_channel_bandwidth(), squelch, ++monitor_sequence);
+}
+
+void ReconView::monitor_window_stop() {
+    if (monitor_pending)
+        baseband::channel_monitor_stop();
+    monitor_pending = false;
+}
+
+// One report per window. Without activity recon moves to the window's last entry, else to its
+// first active one; the statistics then lock or step on as usual
+void ReconView::on_channel_monitor(const ChannelMonitorMessage& message) {
+    if (!monitor_pending || (message.sequence != monitor_sequence))
+        return;
+
+    monitor_window_stop();
+    if (!recon || recon_tx || is_repeat_active() || (freq_lock > 0) || (current_index != monitor_indexes[0]))  // Stepped or locking meanwhile
+        return;
+
+    const size_t channel = message.active ? __builtin_ctz(message.active) : monitor_count - 1;
+    if ((channel == 0) || (channel >= monitor_count))
+        return;
+
+    current_index = monitor_indexes[channel];
+    freq = current_entry().frequency_a;
+    timer = 0;
+    handle_retune();
     recon_redraw();
 }
 
@@ -1101,6 +1165,7 @@ void ReconView::recon_pause() {
     timer = 0;
     freq_lock = 0;
     recon = false;
+    monitor_window_stop();
 
     if (field_mode.selected_index_value() != SPEC_MODULATION)
         audio_output_start();
@@ -1135,6 +1200,7 @@ void ReconView::on_index_delta(int32_t v) {
 
     freq_lock = 0;
     timer = 0;
+    monitor_window_stop();
 }
 
 void ReconView::on_stepper_delta(int32_t v) {
@@ -1151,6 +1217,7 @@ void ReconView::on_stepper_delta(int32_t v) {
 
     freq_lock = 0;
     timer = 0;
+    monitor_window_stop();
 }
 
 size_t ReconView::change_mode(freqman_index_t new_mod) {
@@ -1269,9 +1336,9 @@ size_t ReconView::change_mode(freqman_index_t new_mod) {
     return freqman_entry_get_step_value(def_step);
 }
 
-void ReconView::handle_coded_squelch(const uint32_t value) {
+void ReconView::handle_coded_squelch(const CodedSquelchMessage& message) {
     if (field_mode.selected_index() == NFM_MODULATION)
-        text_ctcss.set(tone_key_string_by_value(value, text_ctcss.parent_rect().width() / 8));
+        text_ctcss.set(coded_squelch_string(message, text_ctcss.parent_rect().width() / 8));
     else
         text_ctcss.set("        ");
 }
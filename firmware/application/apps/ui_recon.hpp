@@ -103,7 +103,10 @@ class ReconView : public View {
     void colorize_waits();
     void recon_redraw();
     void handle_retune();
-    void handle_coded_squelch(const uint32_t value);
+    void monitor_window_start();
+    void monitor_window_stop();
+    void on_channel_monitor(const ChannelMonitorMessage& message);
+    void handle_coded_squelch(const CodedSquelchMessage& message);
     void handle_remove_current_item();
     void load_persisted_settings();
     bool recon_save_freq(const std::filesystem::path& path, size_t index, bool warn_if_exists);
@@ -161,6 +164,10 @@ class ReconView : public View {
     freqman_entry last_entry{};
     bool entry_has_changed{false};
     uint32_t freq_lock{0};
+    bool monitor_pending{false};  // A channel monitor window waits for its report
+    uint8_t monitor_sequence{0};
+    size_t monitor_count{0};
+    std::array<int32_t, ChannelMonitorConfigMessage::max_channels> monitor_indexes{};
     int64_t minfreq{0};
     int64_t maxfreq{0};
     bool has_looped{false};
@@ -401,8 +408,8 @@ class ReconView : public View {
     MessageHandlerRegistration message_handler_coded_squelch{
         Message::ID::CodedSquelch,
         [this](const Message* const p) {
-            const auto message = *reinterpret_cast<const CodedSquelchMessage*>(p);
-            handle_coded_squelch(message.value);
+            const auto& message = *reinterpret_cast<const CodedSquelchMessage*>(p);
+            handle_coded_squelch(message);
         }};
 
     MessageHandlerRegistration message_handler_stats{
@@ -411,6 +418,12 @@ class ReconView : public View {
             on_statistics_update(static_cast<const ChannelStatisticsMessage*>(p)->statistics);
         }};
 
+    MessageHandlerRegistration message_handler_monitor{
+        Message::ID::ChannelMonitor,
+        [this](const Message* const p) {
+            on_channel_monitor(*reinterpret_cast<const ChannelMonitorMessage*>(p));
+        }};
+
     MessageHandlerRegistration message_handler_replay_thread_error{
         Message::ID::ReplayThreadDone,
         [this](const Message* p) {
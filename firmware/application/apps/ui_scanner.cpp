@@ -58,6 +58,9 @@ void ScannerThread::stop() {
         chThdTerminate(thread);
         chThdWait(thread);
         thread = nullptr;
+
+        if (_monitor)
+            baseband::channel_monitor_stop();
     }
 }
 
@@ -100,6 +103,90 @@ void ScannerThread::set_scanning_direction(bool fwd) {
     }
 }
 
+// Only for frequency lists in NFM; OK to do this without pausing scan_thread
+// Call again after each baseband restart, a pending window is dropped with the old baseband
+void ScannerThread::set_channel_monitor(const bool v, const int32_t squelch_db) {
+    _monitor_squelch = squelch_db;
+    _monitor_wait = 0;
+    _monitor = v && !_manual_search;
+}
+
+void ScannerThread::set_monitor_squelch(const int32_t squelch_db) {
+    _monitor_squelch = squelch_db;
+}
+
+// Called from the UI thread with each baseband report
+void ScannerThread::on_channel_monitor(const ChannelMonitorMessage& message) {
+    if ((_monitor_wait != 0) && (message.sequence == _monitor_sequence) && !_monitor_reported) {
+        _monitor_active = message.active;
+        _monitor_reported = true;
+    }
+}
+
+// Send the consecutive entries (in scanning direction) that fit around the tuned one to the baseband
+void ScannerThread::monitor_window_start(const int32_t frequency_index, const int32_t step) {
+    const int32_t size = frequency_list_.size();
+    const rf::Frequency center = frequency_list_[frequency_index];
+    ChannelMonitorConfigMessage message{};
+
+    int32_t index = frequency_index;
+    _monitor_count = 0;
+    do {
+        const rf::Frequency offset = frequency_list_[index] - center;
+        if ((offset < -ChannelMonitorConfigMessage::max_offset) || (offset > ChannelMonitorConfigMessage::max_offset))
+            break;
+
+        message.offsets[_monitor_count] = offset;
+        _monitor_indexes[_monitor_count++] = index;
+
+        index += step;
+        if (index >= size)  // Wrap
+            index = 0;
+        else if (index < 0)
+            index = size - 1;
+    } while ((_monitor_count < _monitor_indexes.size()) && (index != frequency_index));
+
+    message.channel_count = _monitor_count;
+    message.bandwidth = receiver_model.nbfm_channel_bandwidth();
+    message.squelch_db = _monitor_squelch;
+    message.sequence = ++_monitor_sequence;
+
+    _monitor_reported = false;
+    _monitor_wait = monitor_timeout;
+    EventDispatcher::send_message(message);  // Forwarded to the baseband by the view
+}
+
+// True when the scan can step past the window, false while waiting for its report
+// or after tuning to an active channel of it (the statistics then decide to lock as usual)
+bool ScannerThread::monitor_window_done(int32_t& frequency_index) {
+    if (_monitor_wait == 0)  // No window pending
+        return true;
+
+    if (!_monitor_reported) {
+        if (--_monitor_wait > 0)
+            return false;
+        // No report in time, the baseband doesn't monitor: step one entry, and scan
+        // channel by channel until set_channel_monitor() is called again
+        _monitor_wait = 0;
+        _monitor = false;
+        return true;
+    }
+
+    _monitor_wait = 0;
+    const uint32_t active = _monitor_active;
+    if (active == 0) {
+        frequency_index = _monitor_indexes[_monitor_count - 1];  // Nothing on the air in the whole window
+        return true;
+    }
+
+    const size_t channel = __builtin_ctz(active);
+    if (channel < _monitor_count) {
+        frequency_index = _monitor_indexes[channel];
+        receiver_model.set_target_frequency(frequency_list_[frequency_index]);  // Retune to the active channel
+    }
+    return false;
+}
+
 msg_t ScannerThread::static_fn(void* arg) {
     auto obj = static_cast<ScannerThread*>(arg);
     obj->run();
@@ -118,7 +205,7 @@ void ScannerThread::run() {
             int32_t step = force_one_step ? _index_stepper : _stepper;  //_index_stepper direction takes priority
 
             if (_scanning || force_one_step) {              // Scanning, or paused and using rotary encoder
-                if ((_freq_lock == 0) || force_one_step) {  // normal scanning (not performing freq_lock)
+                if (((_freq_lock == 0) && (!_monitor || monitor_window_done(frequency_index))) || force_one_step) {  // normal scanning (not performing freq_lock)
                     frequency_index += step;
                     if (frequency_index >= size)  // Wrap
                         frequency_index = 0;
@@ -129,6 +216,10 @@ void ScannerThread::run() {
                         _index_stepper = 0;
 
                     receiver_model.set_target_frequency(frequency_list_[frequency_index]);  // Retune
+
+                    _monitor_wait = 0;
+                    if (_monitor && !force_one_step)
+                        monitor_window_start(frequency_index, step);  // Watch the following entries too
                 }
                 message.freq = frequency_list_[frequency_index];
                 message.range = frequency_index;  // Inform freq (for coloring purposes also!)
@@ -141,7 +232,8 @@ void ScannerThread::run() {
                         break;
                     }
                 }
-                _freq_del = 0;  // deleted.
+                _freq_del = 0;      // deleted.
+                _monitor_wait = 0;  // Indexes of a pending window are stale now
             }
 
             chThdSleepMilliseconds(SCANNER_SLEEP_MS);  // Needed to (eventually) stabilize the receiver into new freq
@@ -529,7 +621,11 @@ ScannerView::ScannerView(
     field_lock_wait.on_change = [this](int32_t v) { lock_wait = v; };
     field_lock_wait.set_value(lock_wait);
 
-    field_squelch.on_change = [this](int32_t v) { squelch = v; };
+    field_squelch.on_change = [this](int32_t v) {
+        squelch = v;
+        if (scan_thread)
+            scan_thread->set_monitor_squelch(v);
+    };
     field_squelch.set_value(squelch);
 
     // Disable squelch on the model because RSSI handler is where the
@@ -728,6 +824,14 @@ void ScannerView::change_mode(freqman_index_t new_mod) {
         default:
             break;
     }
+
+    update_channel_monitor();  // New baseband
+}
+
+// Only the NFM baseband reports ChannelMonitor messages
+void ScannerView::update_channel_monitor() {
+    if (scan_thread)
+        scan_thread->set_channel_monitor(receiver_model.modulation() == ReceiverModel::Mode::NarrowbandFMAudio, squelch);
 }
 
 void ScannerView::start_scan_thread() {
@@ -750,6 +854,7 @@ void ScannerView::start_scan_thread() {
             frequency_list.push_back(entry.freq);
 
         scan_thread = std::make_unique<ScannerThread>(std::move(frequency_list));
+        update_channel_monitor();
     }
 
     scan_thread->set_scanning_direction(fwd);
@@ -75,6 +75,12 @@ class ScannerThread {
     void set_index_stepper(const int32_t v);
     void set_scanning_direction(bool fwd);
 
+    /* Monitor mode: retune once per window of the list, the baseband
+     * reports which of its channels are active. */
+    void set_channel_monitor(const bool v, const int32_t squelch_db);
+    void set_monitor_squelch(const int32_t squelch_db);
+    void on_channel_monitor(const ChannelMonitorMessage& message);
+
     void stop();
 
     ScannerThread(const ScannerThread&) = delete;
@@ -95,9 +101,22 @@ class ScannerThread {
     uint32_t _freq_idx{0};
     int32_t _stepper{1};
     int32_t _index_stepper{0};
+
+    static constexpr uint32_t monitor_timeout{8};  // # of loops to wait for a window report
+    bool _monitor{false};
+    int32_t _monitor_squelch{0};
+    uint8_t _monitor_sequence{0};
+    uint32_t _monitor_wait{0};  // 0 when no window is pending
+    volatile bool _monitor_reported{false};
+    volatile uint32_t _monitor_active{0};
+    size_t _monitor_count{0};
+    std::array<int32_t, ChannelMonitorConfigMessage::max_channels> _monitor_indexes{};
+
     static msg_t static_fn(void* arg);
     void run();
     void create_thread();
+    void monitor_window_start(const int32_t frequency_index, const int32_t step);
+    bool monitor_window_done(int32_t& frequency_index);
 };
 
 class ScannerView : public View {
@@ -137,6 +156,7 @@ class ScannerView : public View {
     void start_scan_thread();
     void restart_scan();
     void change_mode(freqman_index_t mod_type);
+    void update_channel_monitor();
     void show_max_index();
     void scan_pause();
     void scan_resume();
@@ -313,6 +333,21 @@ class ScannerView : public View {
         [this](const Message* const p) {
             this->on_statistics_update(static_cast<const ChannelStatisticsMessage*>(p)->statistics);
         }};
+
+    // Sent by the scanner thread, forwarded to the baseband from this thread.
+    MessageHandlerRegistration message_handler_monitor_config{
+        Message::ID::ChannelMonitorConfig,
+        [this](const Message* const p) {
+            const auto& message = *reinterpret_cast<const ChannelMonitorConfigMessage*>(p);
+            baseband::channel_monitor_start(message.offsets, message.channel_count, message.bandwidth, message.squelch_db, message.sequence);
+        }};
+
+    MessageHandlerRegistration message_handler_monitor{
+        Message::ID::ChannelMonitor,
+        [this](const Message* const p) {
+            if (scan_thread)
+                scan_thread->on_channel_monitor(*reinterpret_cast<const ChannelMonitorMessage*>(p));
+        }};
 };
 
 } /* namespace ui */
@@ -149,9 +149,10 @@ void set_aprs(const uint32_t baudrate) {
     send_message(&message);
 }
 
-void set_btlerx(uint8_t channel_number) {
+void set_btlerx(uint8_t channel_number, uint8_t access_address_tolerance) {
     const BTLERxConfigureMessage message{
-        channel_number};
+        channel_number,
+        access_address_tolerance};
     send_message(&message);
 }
 
@@ -304,6 +305,16 @@ void set_spectrum(const size_t sampling_rate, const size_t trigger) {
     send_message(&message);
 }
 
+void set_spectrum_sweep(const bool enabled, const uint32_t settle_buffers) {
+    const SpectrumSweepConfigMessage message{enabled, settle_buffers};
+    send_message(&message);
+}
+
+void spectrum_sweep_step(const uint32_t slice) {
+    const SpectrumSweepStepMessage message{slice};
+    send_message(&message);
+}
+
 void set_siggen_tone(const uint32_t tone) {
     const SigGenToneMessage message{
         TONES_F2D(tone, TONES_SAMPLERATE)};
@@ -387,6 +398,7 @@ void shutdown() {
     send_message(&message);
 
     shared_memory.application_queue.reset();
+    shared_memory.m4_profile.sequence = 0;  // The profile was of this image.
 
     baseband_image_running = false;
 }
@@ -397,12 +409,46 @@ void spectrum_streaming_start() {
     send_message(&message);
 }
 
+void spectrum_streaming_start(
+    const uint8_t fft_size_log2,
+    const SpectrumStreamingConfigMessage::Window window,
+    const SpectrumStreamingConfigMessage::Averaging averaging,
+    const uint8_t average_count) {
+    SpectrumStreamingConfigMessage message{
+        SpectrumStreamingConfigMessage::Mode::Running,
+        fft_size_log2,
+        window,
+        averaging,
+        average_count};
+    send_message(&message);
+}
+
 void spectrum_streaming_stop() {
     SpectrumStreamingConfigMessage message{
         SpectrumStreamingConfigMessage::Mode::Stopped};
     send_message(&message);
 }
 
+void channel_monitor_start(
+    const std::array<int32_t, ChannelMonitorConfigMessage::max_channels>& offsets,
+    const uint8_t channel_count,
+    const uint32_t bandwidth,
+    const int32_t squelch_db,
+    const uint8_t sequence) {
+    const ChannelMonitorConfigMessage message{
+        offsets,
+        channel_count,
+        bandwidth,
+        squelch_db,
+        sequence};
+    send_message(&message);
+}
+
+void channel_monitor_stop() {
+    const ChannelMonitorConfigMessage message{};
+    send_message(&message);
+}
+
 void set_sample_rate(uint32_t sample_rate, OversampleRate oversample_rate) {
     SampleRateConfigMessage message{sample_rate, oversample_rate};
     send_message(&message);
@@ -428,6 +474,11 @@ void replay_stop() {
     send_message(&message);
 }
 
+void set_replay_packing(const uint8_t bits) {
+    ReplayPackingMessage message{bits};
+    send_message(&message);
+}
+
 void request_beep(RequestSignalMessage::Signal beep_type) {
     RequestSignalMessage message{beep_type};
     send_message(&message);
@@ -72,7 +72,7 @@ void set_afsk(const uint32_t baudrate, const uint32_t word_length, const uint32_
 void set_fsk(const size_t deviation);
 void set_aprs(const uint32_t baudrate);
 
-void set_btlerx(uint8_t channel_number);
+void set_btlerx(uint8_t channel_number, uint8_t access_address_tolerance = 1);
 void set_btletx(uint8_t channel_number, char* macAddress, char* advertisementData, uint8_t pduType);
 
 void set_nrf(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word);
@@ -85,6 +85,8 @@ void set_adsb();
 void set_jammer(const bool run, const jammer::JammerType type, const uint32_t speed);
 void set_rds_data(const uint16_t message_length);
 void set_spectrum(const size_t sampling_rate, const size_t trigger);
+void set_spectrum_sweep(const bool enabled, const uint32_t settle_buffers = 0);
+void spectrum_sweep_step(const uint32_t slice);
 void set_siggen_tone(const uint32_t tone);
 void set_siggen_config(const uint32_t bw, const uint32_t shape, const uint32_t duration);
 void set_spectrum_painter_config(const uint16_t width, const uint16_t height, bool update, int32_t bw);
@@ -100,14 +102,31 @@ void run_prepared_image(const uint32_t m4_code);
 void shutdown();
 
 void spectrum_streaming_start();
+/* FFT of 2^fft_size_log2 points, spectra reduced on the M4 over average_count frames. */
+void spectrum_streaming_start(
+    const uint8_t fft_size_log2,
+    const SpectrumStreamingConfigMessage::Window window,
+    const SpectrumStreamingConfigMessage::Averaging averaging,
+    const uint8_t average_count);
 void spectrum_streaming_stop();
 
+/* Power of up to max_channels channels at offsets from the tuned frequency,
+ * reported as ChannelMonitorMessage. NFM image only. */
+void channel_monitor_start(
+    const std::array<int32_t, ChannelMonitorConfigMessage::max_channels>& offsets,
+    const uint8_t channel_count,
+    const uint32_t bandwidth,
+    const int32_t squelch_db,
+    const uint8_t sequence);
+void channel_monitor_stop();
+
 /* NB: sample_rate should be desired rate. Don't pre-scale. */
 void set_sample_rate(uint32_t sample_rate, OversampleRate oversample_rate = OversampleRate::None);
 void capture_start(CaptureConfig* const config);
 void capture_stop();
 void replay_start(ReplayConfig* const config);
 void replay_stop();
+void set_replay_packing(const uint8_t bits);
 
 } /* namespace baseband */
 
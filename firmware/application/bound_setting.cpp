@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "bound_setting.hpp"
+
+#include "convert.hpp"
+
+void BoundSetting::parse(std::string_view value) {
+    switch (type_) {
+        case SettingType::I64:
+            parse_int(value, as<int64_t>());
+            break;
+        case SettingType::I32:
+            parse_int(value, as<int32_t>());
+            break;
+        case SettingType::U32:
+            parse_int(value, as<uint32_t>());
+            break;
+        case SettingType::U8:
+            parse_int(value, as<uint8_t>());
+            break;
+        case SettingType::String:
+            as<std::string>() = trim(value);
+            break;
+        case SettingType::Bool: {
+            int parsed = 0;
+            parse_int(value, parsed);
+            as<bool>() = (parsed != 0);
+            break;
+        }
+    };
+}
+
+std::string_view BoundSetting::format(StringFormatBuffer& buffer) const {
+    // NB: Format without allocations. This happens on every
+    // app exit when enabled so should be fast to keep the UX responsive.
+    size_t length = 0;
+
+    switch (type_) {
+        case SettingType::I64:
+            return {to_string_dec_int(as<int64_t>(), buffer, length), length};
+        case SettingType::I32:
+            return {to_string_dec_int(as<int32_t>(), buffer, length), length};
+        case SettingType::U32:
+            return {to_string_dec_uint(as<uint32_t>(), buffer, length), length};
+        case SettingType::U8:
+            return {to_string_dec_uint(as<uint8_t>(), buffer, length), length};
+        case SettingType::String:
+            return as<std::string>();
+        case SettingType::Bool:
+            return as<bool>() ? "1" : "0";
+    }
+
+    return {};
+}
+
+bool bind_setting(std::string_view line, SettingBindings& bindings, size_t& hint) {
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+
+    // Exactly one separator.
+    const auto separator = line.find('=');
+    if (separator == line.npos || line.find('=', separator + 1) != line.npos)
+        return false;
+
+    const auto name = line.substr(0, separator);
+    const auto value = line.substr(separator + 1);
+
+    // Settings are written in binding order, so the hint usually matches.
+    const auto count = bindings.size();
+    for (size_t i = 0; i < count; i++) {
+        auto index = hint + i;
+        if (index >= count)
+            index -= count;
+
+        if (bindings[index].name() == name) {
+            bindings[index].parse(value);
+            hint = index + 1;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint32_t hash_settings(const SettingBindings& bindings) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+
+    format_settings(bindings, [&hash](std::string_view text) {
+        for (const auto c : text)
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    });
+
+    return (hash != 0) ? hash : 1;
+}
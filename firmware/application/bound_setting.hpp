@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BOUND_SETTING_H__
+#define __BOUND_SETTING_H__
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "file.hpp"
+#include "string_format.hpp"
+
+/* Represents a named setting bound to a variable instance. */
+/* Using void* instead of std::variant, because variant is a pain to dispatch over. */
+class BoundSetting {
+    /* The type of bound setting. */
+    enum class SettingType : uint8_t {
+        I64,
+        I32,
+        U32,
+        U8,
+        String,
+        Bool,
+    };
+
+   public:
+    BoundSetting(std::string_view name, int64_t* target)
+        : name_{name}, target_{target}, type_{SettingType::I64} {}
+
+    BoundSetting(std::string_view name, int32_t* target)
+        : name_{name}, target_{target}, type_{SettingType::I32} {}
+
+    BoundSetting(std::string_view name, uint32_t* target)
+        : name_{name}, target_{target}, type_{SettingType::U32} {}
+
+    BoundSetting(std::string_view name, uint8_t* target)
+        : name_{name}, target_{target}, type_{SettingType::U8} {}
+
+    BoundSetting(std::string_view name, std::string* target)
+        : name_{name}, target_{target}, type_{SettingType::String} {}
+
+    BoundSetting(std::string_view name, bool* target)
+        : name_{name}, target_{target}, type_{SettingType::Bool} {}
+
+    std::string_view name() const { return name_; }
+    void parse(std::string_view value);
+
+    /* Returns the value as text, formatted into buffer when needed. */
+    std::string_view format(StringFormatBuffer& buffer) const;
+
+   private:
+    template <typename T>
+    constexpr auto& as() const {
+        return *reinterpret_cast<T*>(target_);
+    }
+
+    std::string_view name_;
+    void* target_;
+    SettingType type_;
+};
+
+using SettingBindings = std::vector<BoundSetting>;
+
+/* Settings are stored as "name=value" lines, in binding order. */
+
+/* Size of the read/write buffers. Longer lines are read through a string. */
+constexpr size_t setting_buffer_size = 256;
+
+/* Parses one line into the binding with a matching name. The binding at
+ * hint (the one after the previous match) is tried first. */
+bool bind_setting(std::string_view line, SettingBindings& bindings, size_t& hint);
+
+/* Hash of the settings as write_settings would write them, used to skip
+ * writing settings that haven't changed. Never 0. */
+uint32_t hash_settings(const SettingBindings& bindings);
+
+/* Passes the formatted settings to sink(std::string_view) in pieces. */
+template <typename Sink>
+void format_settings(const SettingBindings& bindings, Sink&& sink) {
+    StringFormatBuffer buffer;
+
+    for (const auto& setting : bindings) {
+        sink(setting.name());
+        sink(std::string_view{"="});
+        sink(setting.format(buffer));
+        sink(std::string_view{"\r\n"});
+    }
+}
+
+/* BufferType requires the following members
+ * Result<Size> read(void* data, Size bytes_to_read) (read_settings)
+ * Result<Size> write(const void* data, Size bytes_to_write) (write_settings)
+ */
+
+/* Reads the settings through a single fixed buffer, only lines that don't
+ * fit in it are allocated. Returns the number of lines bound to a setting. */
+template <typename BufferType>
+size_t read_settings(BufferType& buffer, SettingBindings& bindings) {
+    std::array<char, setting_buffer_size> data;
+    std::string long_line{};
+    size_t used = 0;
+    size_t bound = 0;
+    size_t hint = 0;
+    bool end = false;
+
+    while (!end) {
+        auto result = buffer.read(&data[used], data.size() - used);
+        if (!result || *result == 0)
+            end = true;
+        else
+            used += *result;
+
+        size_t start = 0;
+        while (start < used) {
+            auto newline = static_cast<const char*>(memchr(&data[start], '\n', used - start));
+            if (!newline) {
+                if (!end)
+                    break;
+                newline = &data[used];  // Last line, no newline.
+            }
+
+            const size_t length = newline - &data[start];
+            std::string_view line{&data[start], length};
+            if (!long_line.empty()) {
+                long_line.append(line);
+                line = long_line;
+            }
+
+            if (bind_setting(line, bindings, hint))
+                bound++;
+
+            long_line.clear();
+            start += length + 1;
+        }
+
+        if (start == 0 && used == data.size()) {
+            // Line doesn't fit, carry it over in the string.
+            long_line.append(&data[0], used);
+            used = 0;
+        } else if (start < used) {
+            memmove(&data[0], &data[start], used - start);
+            used -= start;
+        } else {
+            used = 0;
+        }
+    }
+
+    // A long last line without a newline ends exactly at the end of the buffer.
+    if (!long_line.empty() && bind_setting(long_line, bindings, hint))
+        bound++;
+
+    return bound;
+}
+
+/* Writes the settings through a single fixed buffer, in as few writes
+ * as the length allows. */
+template <typename BufferType>
+bool write_settings(BufferType& buffer, const SettingBindings& bindings) {
+    std::array<char, setting_buffer_size> data;
+    size_t used = 0;
+    bool ok = true;
+
+    auto flush = [&]() {
+        if (used > 0) {
+            auto result = buffer.write(&data[0], used);
+            ok = ok && result && (*result == used);
+            used = 0;
+        }
+    };
+
+    format_settings(bindings, [&](std::string_view text) {
+        while (!text.empty()) {
+            if (used == data.size())
+                flush();
+
+            const auto count = std::min(text.size(), data.size() - used);
+            memcpy(&data[used], text.data(), count);
+            used += count;
+            text.remove_prefix(count);
+        }
+    });
+    flush();
+
+    return ok;
+}
+
+#endif /*__BOUND_SETTING_H__*/
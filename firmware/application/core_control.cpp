@@ -26,40 +26,102 @@
 #include "lpc43xx_cpp.hpp"
 #include "lz4.h"
 #include "message.hpp"
+#include "utility.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 
 using namespace lpc43xx;
 using namespace portapack;
 
+/* Chunks of the recently loaded images, most recent first. Saves walking
+ * the chunk list in SPI flash when hopping between a few apps.
+ * NB: Decompressed images can't be kept, there's no spare RAM for copies. */
+static std::array<const spi_flash::chunk_t*, 8> recent_chunks{};
+static m4_load::Stats load_stats{};
+
+/* The image last decompressed into M4 code RAM. The M4 only reads its code
+ * region (.data is copied out to local SRAM 0 at startup), so reloading the
+ * same image can reuse it, as long as the checksum shows nothing else wrote
+ * there (external apps, a stray M4 write through address 0). */
+static spi_flash::image_tag_t resident_tag{};
+static uint32_t resident_base{0};
+static uint32_t resident_checksum{0};
+
+static bool is_resident(const spi_flash::image_tag_t image_tag, const memory::region_t to) {
+    return (resident_tag == image_tag) && (resident_base == to.base()) &&
+           (simple_checksum(to.base(), to.size()) == resident_checksum);
+}
+
+static const spi_flash::chunk_t* find_chunk(const spi_flash::image_tag_t image_tag) {
+    auto it = std::find_if(recent_chunks.begin(), recent_chunks.end(), [&image_tag](const spi_flash::chunk_t* c) {
+        return c && (c->tag == image_tag);
+    });
+
+    const spi_flash::chunk_t* chunk = nullptr;
+    if (it != recent_chunks.end()) {
+        chunk = *it;
+        load_stats.recent_hits++;
+    } else {
+        chunk = reinterpret_cast<const spi_flash::chunk_t*>(spi_flash::images.base());
+        while (chunk->tag && (chunk->tag != image_tag))
+            chunk = chunk->next();
+
+        if (!chunk->tag)
+            return nullptr;
+
+        it = recent_chunks.end() - 1;
+    }
+
+    // Move to the front.
+    std::move_backward(recent_chunks.begin(), it, it + 1);
+    recent_chunks[0] = chunk;
+    return chunk;
+}
+
 void m4_init(const spi_flash::image_tag_t image_tag, const memory::region_t to, const bool full_reset) {
-    const spi_flash::chunk_t* chunk = reinterpret_cast<const spi_flash::chunk_t*>(spi_flash::images.base());
-    while (chunk->tag) {
-        if (chunk->tag == image_tag) {
-            const void* src = &chunk->data[0];
-            void* dst = reinterpret_cast<void*>(to.base());
-
-            /* extract and initialize M4 code RAM */
-            unlz4_len(src, dst, chunk->compressed_data_size);
-
-            /* M4 core is assumed to be sleeping with interrupts off, so we can mess
-             * with its address space and RAM without concern.
-             */
-            LPC_CREG->M4MEMMAP = to.base();
-
-            /* Reset M4 core and optionally all peripherals */
-            LPC_RGU->RESET_CTRL[0] = (full_reset) ? (1 << 1)    // PERIPH_RST
-                                                  : (1 << 13);  // M4_RST
-
-            return;
-        }
-        chunk = chunk->next();
+    const halrtcnt_t load_start = halGetCounterValue();
+
+    if (is_resident(image_tag, to)) {
+        load_stats.resident_hits++;
+    } else {
+        const spi_flash::chunk_t* chunk = find_chunk(image_tag);
+        if (!chunk)
+            chDbgPanic("NoImg");
+
+        const void* src = &chunk->data[0];
+        void* dst = reinterpret_cast<void*>(to.base());
+
+        /* extract and initialize M4 code RAM */
+        unlz4_len(src, dst, chunk->compressed_data_size);
+
+        resident_tag = image_tag;
+        resident_base = to.base();
+        resident_checksum = simple_checksum(to.base(), to.size());
+        load_stats.last_compressed_size = chunk->compressed_data_size;
     }
 
-    chDbgPanic("NoImg");
+    const uint32_t load_us = RTT2US(halGetCounterValue() - load_start);
+    load_stats.count++;
+    load_stats.last_us = load_us;
+    load_stats.max_us = std::max(load_stats.max_us, load_us);
+    load_stats.total_us += load_us;
+
+    /* M4 core is assumed to be sleeping with interrupts off, so we can mess
+     * with its address space and RAM without concern.
+     */
+    LPC_CREG->M4MEMMAP = to.base();
+
+    /* Reset M4 core and optionally all peripherals */
+    LPC_RGU->RESET_CTRL[0] = (full_reset) ? (1 << 1)    // PERIPH_RST
+                                          : (1 << 13);  // M4_RST
 }
 
 void m4_init_prepared(const uint32_t m4_code, const bool full_reset) {
+    // An external image replaced whatever was loaded.
+    resident_tag = {};
+
     /* M4 core is assumed to be sleeping with interrupts off, so we can mess
      * with its address space and RAM without concern.
      */
@@ -76,6 +138,18 @@ void m4_request_shutdown() {
     baseband::shutdown();
 }
 
+namespace m4_load {
+
+const Stats& stats() {
+    return load_stats;
+}
+
+void reset_stats() {
+    load_stats = {};
+}
+
+} /* namespace m4_load */
+
 void m0_halt() {
     rgu::reset(rgu::Reset::M0APP);
     while (true) {
@@ -23,6 +23,7 @@
 #define __CORE_CONTROL_H__
 
 #include <cstddef>
+#include <cstdint>
 
 #include "memory_map.hpp"
 #include "spi_image.hpp"
@@ -31,6 +32,24 @@ void m4_init(const portapack::spi_flash::image_tag_t image_tag, const portapack:
 void m4_init_prepared(const uint32_t m4_code, const bool full_reset);
 void m4_request_shutdown();
 
+namespace m4_load {
+
+/* Timing of m4_init() image loads (lookup and decompression), in microseconds. */
+struct Stats {
+    uint32_t count;
+    uint32_t recent_hits;    // Loads that found the image among the recent ones.
+    uint32_t resident_hits;  // Loads skipped, the image was still in M4 code RAM.
+    uint32_t last_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint32_t last_compressed_size;
+};
+
+const Stats& stats();
+void reset_stats();
+
+} /* namespace m4_load */
+
 void m0_halt();
 
 #endif /*__CORE_CONTROL_H__*/
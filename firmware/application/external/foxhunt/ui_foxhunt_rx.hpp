@@ -109,6 +109,11 @@ class FoxhuntRxView : public View {
             const auto message = static_cast<const FreqChangeCommandMessage*>(p);
             this->on_freqchg(message->freq);
         }};
+    MessageHandlerRegistration message_handler_frame_sync{
+        Message::ID::DisplayFrameSync,
+        [this](const Message* const) {
+            geomap.on_frame_sync();
+        }};
 
     void on_freqchg(int64_t freq);
 
@@ -29,6 +29,7 @@
 #include "metadata_file.hpp"
 #include "utility.hpp"
 #include "file_path.hpp"
+#include "packed_iq.hpp"
 
 #include "baseband_api.hpp"
 #include "portapack.hpp"
@@ -44,20 +45,40 @@ void GpsSimAppView::set_ready() {
 }
 
 void GpsSimAppView::on_file_changed(const fs::path& new_file_path) {
-    file_path = new_file_path;
     File::Size file_size{};
+    packed_iq::Header header{};
 
-    {  // Get the size of the data file.
+    {  // Get the size of the data file and its packing.
         File data_file;
-        auto error = data_file.open(file_path);
+        auto error = data_file.open(new_file_path);
         if (error) {
             file_error();
             return;
         }
 
         file_size = data_file.size();
+
+        auto read_result = data_file.read(&header, sizeof(header));
+        if (read_result.is_error()) {
+            file_error();
+            return;
+        }
+        if (*read_result < sizeof(header))
+            header = {};
     }
 
+    if (packed_iq::is_valid(header)) {
+        packing_bits = header.bits;
+        data_offset = sizeof(header);
+    } else if (capture_file_sample_size(new_file_path) == sizeof(complex8_t)) {
+        packing_bits = 8;
+        data_offset = 0;
+    } else {
+        nav_.display_modal("Error", "Not a C8 or packed IQ file.");
+        return;
+    }
+    file_path = new_file_path;
+
     // Get original record frequency if available.
     auto metadata_path = get_metadata_path(file_path);
     auto metadata = read_metadata_file(metadata_path);
@@ -65,14 +86,17 @@ void GpsSimAppView::on_file_changed(const fs::path& new_file_path) {
     if (metadata) {
         field_frequency.set_value(metadata->center_frequency);
         transmitter_model.set_sampling_rate(metadata->sample_rate);
+    } else if (header.sample_rate != 0) {
+        transmitter_model.set_sampling_rate(header.sample_rate);
     }
 
     // UI Fixup.
     text_sample_rate.set(unit_auto_scale(transmitter_model.sampling_rate(), 3, 1) + "Hz");
-    progressbar.set_max(file_size);
+    const auto data_size = file_size - data_offset;
+    progressbar.set_max(data_size);
     text_filename.set(truncate(file_path.filename().string(), 12));
 
-    auto duration = ms_duration(file_size, transmitter_model.sampling_rate(), 2);
+    auto duration = ms_duration(packed_iq::sample_count(data_size, packing_bits), transmitter_model.sampling_rate(), 1);
     text_duration.set(to_string_time_ms(duration));
 
     // TODO: fix in UI framework with 'try_focus()'?
@@ -115,12 +139,19 @@ void GpsSimAppView::start() {
     if (open_error.is_valid()) {
         file_error();
     } else {
-        reader = std::move(p);
+        // Skip the packed IQ header, the baseband only gets samples.
+        packed_iq::Header header;
+        if ((data_offset > 0) && p->read(&header, data_offset).is_error())
+            file_error();
+        else
+            reader = std::move(p);
     }
 
     if (reader) {
         button_play.set_bitmap(&bitmap_stop);
 
+        baseband::set_replay_packing(packing_bits);
+
         replay_thread = std::make_unique<ReplayThread>(
             std::move(reader),
             read_size, buffer_count,
@@ -185,7 +216,8 @@ GpsSimAppView::GpsSimAppView(
     };
 
     button_open.on_select = [this, &nav](Button&) {
-        auto open_view = nav.push<FileLoadView>(".C8");
+        // C8 captures and packed IQ files.
+        auto open_view = nav.push<FileLoadView>("");
         ensure_directory(gps_dir);
         open_view->push_dir(gps_dir);
         open_view->on_changed = [this](std::filesystem::path new_file_path) {
@@ -78,6 +78,8 @@ class GpsSimAppView : public View {
     void file_error();
 
     std::filesystem::path file_path{};
+    uint8_t packing_bits{8};
+    File::Size data_offset{0};
     std::unique_ptr<ReplayThread> replay_thread{};
     bool ready_signal{false};
 
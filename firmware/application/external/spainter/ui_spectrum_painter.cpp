@@ -146,12 +146,12 @@ void SpectrumPainterView::frame_sync() {
             bool is_pausing = sequence_time > field_duration.value() * 1000;
 
             if (is_pausing) {
-                fifo->in(std::vector<uint8_t>(tx_current_width));
+                push_line({});
             } else {
                 auto current_time_line = sequence_time * tx_current_max_lines / (field_duration.value() * 1000);
 
                 if (tx_current_line > current_time_line && !check_loop.value()) {
-                    fifo->in(std::vector<uint8_t>(tx_current_width));
+                    push_line({});
                     stop_tx();
                     return;
                 }
@@ -159,18 +159,28 @@ void SpectrumPainterView::frame_sync() {
                 tx_current_line = current_time_line;
                 progressbar.set_value(current_time_line);
 
-                if (tx_mode == 0) {
-                    std::vector<uint8_t> line = input_image.get_line(current_time_line);
-                    fifo->in(line);
-                } else {
-                    std::vector<uint8_t> line = input_text.get_line(current_time_line);
-                    fifo->in(line);
-                }
+                if (tx_mode == 0)
+                    push_line(input_image.get_line(current_time_line));
+                else
+                    push_line(input_text.get_line(current_time_line));
             }
         }
     }
 }
 
+/* Lines wider than the baseband's line slots are resampled, an empty one is black. */
+void SpectrumPainterView::push_line(const std::vector<uint8_t>& pixels) {
+    SpectrumPainterLine line{};
+    line.width = std::min<size_t>(tx_current_width, SpectrumPainterLine::max_width);
+
+    if (!pixels.empty()) {
+        for (size_t x = 0; x < line.width; x++)
+            line.pixels[x] = pixels[x * pixels.size() / line.width];
+    }
+
+    fifo->in(line);
+}
+
 SpectrumPainterView::~SpectrumPainterView() {
     transmitter_model.disable();
     baseband::shutdown();
@@ -149,6 +149,7 @@ class SpectrumPainterView : public View {
     void start_tx();
     void frame_sync();
     void stop_tx();
+    void push_line(const std::vector<uint8_t>& pixels);
 
     MessageHandlerRegistration message_handler_fifo_signal{
         Message::ID::SpectrumPainterBufferResponseConfigure,
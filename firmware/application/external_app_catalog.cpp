@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "external_app_catalog.hpp"
+
+#include "file_path.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const fs::path catalog_path = apps_dir / u"APPS.CAT";
+
+/* FNV-1a of the UTF-16 file name. */
+uint32_t name_hash(const TCHAR* name) {
+    uint32_t hash = 2166136261u;
+    for (; *name; name++) {
+        hash = (hash ^ static_cast<uint32_t>(*name)) * 16777619u;
+    }
+    return hash;
+}
+
+}  // namespace
+
+ExternalAppCatalog::~ExternalAppCatalog() {
+    if (!loaded_)
+        return;
+
+    // Drop the apps that have been removed from the SD card.
+    size_t kept = 0;
+    for (size_t i = 0; i < entries_.size(); i++) {
+        if (seen_[i])
+            entries_[kept++] = entries_[i];
+    }
+    if (kept != entries_.size()) {
+        entries_.resize(kept);
+        dirty_ = true;
+    }
+
+    if (dirty_)
+        save();
+}
+
+const ExternalAppCatalog::Entry* ExternalAppCatalog::lookup(
+    const fs::directory_entry& entry,
+    const fs::path& file_path,
+    Kind kind) {
+    if (!loaded_)
+        load();
+
+    const auto hash = name_hash(entry.fname);
+    const uint32_t size = entry.size();
+    const uint32_t timestamp = (static_cast<uint32_t>(entry.fdate) << 16) | entry.ftime;
+
+    auto it = std::find_if(entries_.begin(), entries_.end(), [hash, kind](const Entry& e) {
+        return (e.name_hash == hash) && (e.kind == kind);
+    });
+
+    if (it == entries_.end()) {
+        entries_.push_back({});
+        seen_.push_back(false);
+        it = entries_.end() - 1;
+    }
+
+    auto& cached = *it;
+    seen_[it - entries_.begin()] = true;
+
+    if ((cached.name_hash != hash) || (cached.kind != kind) ||
+        (cached.size != size) || (cached.timestamp != timestamp)) {
+        cached = {};
+        cached.name_hash = hash;
+        cached.size = size;
+        cached.timestamp = timestamp;
+        cached.kind = kind;
+        cached.valid = read_header(file_path, kind, cached);
+        dirty_ = true;
+    }
+
+    return cached.valid ? &cached : nullptr;
+}
+
+void ExternalAppCatalog::load() {
+    loaded_ = true;
+
+    File file;
+    if (file.open(catalog_path))
+        return;
+
+    Header header{};
+    auto result = file.read(&header, sizeof(header));
+    if (!result || *result != sizeof(header) ||
+        header.magic != catalog_magic || header.version != catalog_version) {
+        dirty_ = true;  // Rewrite it in the current format.
+        return;
+    }
+
+    entries_.resize(header.count);
+    result = file.read(entries_.data(), header.count * sizeof(Entry));
+    if (!result || *result != header.count * sizeof(Entry)) {
+        entries_.clear();
+        dirty_ = true;
+    }
+
+    seen_.assign(entries_.size(), false);
+}
+
+void ExternalAppCatalog::save() {
+    File file;
+    if (file.create(catalog_path))
+        return;
+
+    const Header header{catalog_magic, catalog_version, static_cast<uint32_t>(entries_.size())};
+    file.write(&header, sizeof(header));
+    file.write(entries_.data(), entries_.size() * sizeof(Entry));
+}
+
+bool ExternalAppCatalog::read_header(const fs::path& file_path, Kind kind, Entry& entry) {
+    File app;
+    if (app.open(file_path))
+        return false;
+
+    if (kind == Kind::Ppma) {
+        application_information_t info = {};
+        auto result = app.read(&info, sizeof(info));
+        if (!result || *result != sizeof(info))
+            return false;
+
+        entry.header_version = info.header_version;
+        entry.app_version = info.app_version;
+        memcpy(entry.app_name, info.app_name, sizeof(entry.app_name));
+        memcpy(entry.bitmap_data, info.bitmap_data, sizeof(entry.bitmap_data));
+        entry.icon_color = info.icon_color;
+        entry.menu_location = info.menu_location;
+        entry.desired_menu_position = info.desired_menu_position;
+    } else {
+        standalone_application_information_t info = {};
+        auto result = app.read(&info, sizeof(info));
+        if (!result || *result != sizeof(info))
+            return false;
+
+        entry.header_version = info.header_version;
+        entry.app_version = 0;
+        memcpy(entry.app_name, info.app_name, sizeof(entry.app_name));
+        memcpy(entry.bitmap_data, info.bitmap_data, sizeof(entry.bitmap_data));
+        entry.icon_color = info.icon_color;
+        entry.menu_location = info.menu_location;
+        entry.desired_menu_position = -1;
+    }
+
+    return true;
+}
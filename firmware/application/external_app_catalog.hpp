@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __EXTERNAL_APP_CATALOG_H__
+#define __EXTERNAL_APP_CATALOG_H__
+
+#include "standalone_app.hpp"
+#include "external_app.hpp"
+#include "file.hpp"
+
+#include <cstdint>
+#include <vector>
+
+/* Cache of the headers of the external apps in the APPS directory.
+ * Entries are keyed by file name, size and modification time, all of which
+ * come with the directory listing, so an app file is only opened when it
+ * is new or has changed. The catalog is kept on the SD card next to the
+ * apps; when an entry was added, changed or removed it is rewritten as the
+ * ExternalAppCatalog goes out of scope. */
+class ExternalAppCatalog {
+   public:
+    enum class Kind : uint8_t {
+        Ppma = 0,  // External app, application_information_t header.
+        Ppmp = 1,  // Standalone app, standalone_application_information_t header.
+    };
+
+    /* Header fields needed to build the menus. */
+    struct Entry {
+        uint32_t name_hash;
+        uint32_t size;
+        uint32_t timestamp;
+        Kind kind;
+        bool valid;  // False when the header couldn't be read.
+        uint16_t reserved;
+        uint32_t header_version;
+        uint32_t app_version;  // 0 for standalone apps.
+        uint8_t app_name[16];
+        uint8_t bitmap_data[32];
+        uint32_t icon_color;
+        app_location_t menu_location;
+        int32_t desired_menu_position;  // -1 for standalone apps.
+    };
+
+    ExternalAppCatalog() = default;
+    ~ExternalAppCatalog();
+
+    ExternalAppCatalog(const ExternalAppCatalog&) = delete;
+    ExternalAppCatalog& operator=(const ExternalAppCatalog&) = delete;
+
+    /* Returns the header of the app file listed by entry, reading it from the
+     * file only if it isn't in the catalog. nullptr if it can't be read.
+     * The entry is valid until the next lookup. */
+    const Entry* lookup(
+        const std::filesystem::directory_entry& entry,
+        const std::filesystem::path& file_path,
+        Kind kind);
+
+   private:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t count;
+    };
+
+    static constexpr uint32_t catalog_magic = 0x43415050;  // "PPAC"
+    static constexpr uint32_t catalog_version = 1;
+
+    std::vector<Entry> entries_{};
+    std::vector<bool> seen_{};
+    bool loaded_{false};
+    bool dirty_{false};
+
+    void load();
+    void save();
+    bool read_header(const std::filesystem::path& file_path, Kind kind, Entry& entry);
+};
+
+#endif /*__EXTERNAL_APP_CATALOG_H__*/
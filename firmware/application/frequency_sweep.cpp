@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "frequency_sweep.hpp"
+
+#include "baseband_api.hpp"
+#include "radio.hpp"
+
+void FrequencySweep::start(rf::Frequency first_center, rf::Frequency step, size_t slices, uint32_t settle_buffers) {
+    first_center_frequency = first_center;
+    step_frequency = step;
+    slice_count = (slices > 0) ? slices : 1;
+    running = true;
+    sweep_start = chTimeNow();
+    sweep_duration = 0;
+
+    baseband::set_spectrum_sweep(true, settle_buffers);
+    prepare(0);
+    this->step();
+}
+
+void FrequencySweep::stop() {
+    if (running)
+        baseband::set_spectrum_sweep(false);
+    running = false;
+}
+
+void FrequencySweep::prepare(size_t slice) {
+    next_slice = slice;
+    next_config = radio::tuning_config(center_frequency(slice));
+}
+
+void FrequencySweep::step() {
+    if (next_slice == 0) {
+        const auto now = chTimeNow();
+        sweep_duration = now - sweep_start;
+        sweep_start = now;
+    }
+
+    radio::set_tuning_config(next_config);
+    baseband::spectrum_sweep_step(next_slice);
+
+    // Work out the following slice while this one is captured.
+    prepare((next_slice + 1 < slice_count) ? next_slice + 1 : 0);
+}
+
+void FrequencySweep::on_captured() {
+    if (running)
+        step();
+}
+
+float FrequencySweep::sweeps_per_second() const {
+    return (sweep_duration > 0) ? (float)CH_FREQUENCY / sweep_duration : 0.0f;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __FREQUENCY_SWEEP_H__
+#define __FREQUENCY_SWEEP_H__
+
+#include "rf_path.hpp"
+#include "tuning.hpp"
+
+#include <ch.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/* Drives the wideband spectrum baseband through a frequency plan:
+ * slice n is centered on first_center + n * step, n = 0..slices-1, and the
+ * plan wraps around. Each step retunes the radio directly (bypassing the
+ * receiver model) and tells the baseband to capture; the baseband drops the
+ * settle buffers itself and sends SpectrumSweepCapturedMessage as soon as the
+ * radio may be retuned, so no streaming stop/start or sleep is needed per
+ * slice. Spectra come back through the ChannelSpectrum FIFO tagged with their
+ * slice while the next slice is already being captured.
+ *
+ * The tuning of the next slice is prepared while the current one is being
+ * captured, so a step only writes the synthesizer registers that change. */
+class FrequencySweep {
+   public:
+    /* Starts sweep mode in the baseband and steps the first slice. */
+    void start(rf::Frequency first_center, rf::Frequency step, size_t slices, uint32_t settle_buffers);
+    void stop();
+    bool is_running() const { return running; }
+
+    size_t slices() const { return slice_count; }
+    rf::Frequency center_frequency(size_t slice) const { return first_center_frequency + step_frequency * slice; }
+
+    /* Call on SpectrumSweepCapturedMessage, steps to the next slice. */
+    void on_captured();
+
+    /* Full sweeps per second, measured over the last sweep. */
+    float sweeps_per_second() const;
+
+   private:
+    rf::Frequency first_center_frequency{0};
+    rf::Frequency step_frequency{0};
+    size_t slice_count{0};
+    bool running{false};
+    size_t next_slice{0};
+    tuning::config::Config next_config{};
+    systime_t sweep_start{0};
+    systime_t sweep_duration{0};
+
+    void prepare(size_t slice);
+    void step();
+};
+
+#endif /*__FREQUENCY_SWEEP_H__*/
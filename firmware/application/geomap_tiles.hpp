@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GEOMAP_TILES_H__
+#define __GEOMAP_TILES_H__
+
+#include "file.hpp"
+#include "ui.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace geomap {
+
+/* Tiled map file, generated from world_map.bin by tools/generate_world_map_tiles.py.
+ * All values little endian. Layout:
+ *   TileFileHeader
+ *   TileLevelHeader[level_count]
+ *   tiles, level by level, row-major; each tile is tile_size * tile_size RGB565
+ *   pixels (edge tiles are padded).
+ * Level 0 is the full resolution map, other levels are box-filtered copies where
+ * one pixel covers scale x scale level 0 pixels. */
+struct TileFileHeader {
+    char magic[4];  // "PPMT"
+    uint16_t version;
+    uint16_t tile_size;
+    uint16_t width;  // Level 0 size, same as world_map.bin.
+    uint16_t height;
+    uint16_t level_count;
+    uint16_t reserved;
+};
+
+struct TileLevelHeader {
+    uint16_t scale;
+    uint16_t tiles_x;
+    uint16_t tiles_y;
+    uint16_t reserved;
+    uint32_t offset;  // File offset of tile (0, 0).
+};
+
+static_assert(sizeof(TileFileHeader) == 16, "TileFileHeader size wrong");
+static_assert(sizeof(TileLevelHeader) == 12, "TileLevelHeader size wrong");
+
+/* FileType requires the following members
+ * Result<Offset> seek(uint32_t offset)
+ * Result<Size> read(void* data, Size bytes_to_read)
+ */
+
+/* Reads tiles from a tiled map file through a small LRU cache. The cache
+ * holds one row of tiles across the view, which is what fits the M0 with the
+ * default 16 x 16 tiles. for_each_tile() draws the cached tiles first and ends
+ * on the middle row, so a pan by one tile in any direction reuses the row. */
+template <typename FileType>
+class TiledMap {
+   public:
+    static constexpr uint16_t file_version = 1;
+    static constexpr uint16_t min_tile_size = 8;
+    static constexpr uint16_t max_tile_size = 64;
+    static constexpr size_t max_levels = 16;
+    static constexpr size_t cache_budget_bytes = 8192;
+    static constexpr size_t max_cache_entries = 32;
+
+    TiledMap(FileType& file)
+        : file_{file} {}
+
+    TiledMap(const TiledMap&) = delete;
+    TiledMap& operator=(const TiledMap&) = delete;
+
+    /* Reads the headers of the opened file. The cache is sized for a row of
+     * tiles across view_width pixels, within cache_budget_bytes. */
+    bool init(const size_t view_width) {
+        cache_entries_ = 0;
+        cache_pixels_.reset();
+
+        if (!file_.seek(0))
+            return false;
+
+        auto result = file_.read(&header_, sizeof(header_));
+        if (!result || *result != sizeof(header_))
+            return false;
+
+        if (std::memcmp(header_.magic, "PPMT", 4) != 0 ||
+            header_.version != file_version ||
+            header_.tile_size < min_tile_size || header_.tile_size > max_tile_size ||
+            header_.level_count == 0 || header_.level_count > max_levels)
+            return false;
+
+        const auto levels_size = header_.level_count * sizeof(TileLevelHeader);
+        result = file_.read(levels_.data(), levels_size);
+        if (!result || *result != levels_size || levels_[0].scale != 1)
+            return false;
+
+        // A row of tiles not aligned to the view spans one more tile.
+        const size_t row_tiles = (view_width + header_.tile_size - 1) / header_.tile_size + 1;
+        const size_t budget_tiles = cache_budget_bytes / (tile_pixels() * sizeof(ui::Color));
+        const auto entries = std::clamp<size_t>(std::min(row_tiles, budget_tiles), 1, max_cache_entries);
+        cache_pixels_ = std::make_unique<ui::Color[]>(entries * tile_pixels());
+        cache_.fill({});
+        cache_entries_ = entries;
+        cache_hits_ = 0;
+        cache_misses_ = 0;
+
+        return true;
+    }
+
+    bool is_open() const { return cache_entries_ > 0; }
+
+    uint16_t width() const { return header_.width; }
+    uint16_t height() const { return header_.height; }
+    uint16_t tile_size() const { return header_.tile_size; }
+    size_t cache_entries() const { return cache_entries_; }
+
+    /* Level with the largest scale that evenly divides the requested scale. */
+    size_t level_for_scale(uint16_t scale) const {
+        size_t best = 0;
+        for (size_t i = 1; i < header_.level_count; i++) {
+            const auto s = levels_[i].scale;
+            if (s != 0 && (scale % s) == 0 && s > levels_[best].scale)
+                best = i;
+        }
+        return best;
+    }
+
+    uint16_t level_scale(size_t level) const { return levels_[level].scale; }
+
+    /* Returns the tile pixels or nullptr if the tile is outside the level or
+     * could not be read. Valid until the next call. */
+    const ui::Color* tile(size_t level, int32_t tx, int32_t ty) {
+        if (!is_open() || level >= header_.level_count)
+            return nullptr;
+
+        const auto& lvl = levels_[level];
+        if (tx < 0 || ty < 0 || tx >= lvl.tiles_x || ty >= lvl.tiles_y)
+            return nullptr;
+
+        const uint32_t key = tile_key(level, tx, ty);
+        use_counter_++;
+
+        size_t victim = 0;
+        for (size_t i = 0; i < cache_entries_; i++) {
+            auto& entry = cache_[i];
+            if (entry.valid && entry.key == key) {
+                entry.last_used = use_counter_;
+                cache_hits_++;
+                return &cache_pixels_[i * tile_pixels()];
+            }
+
+            // Prefer empty slots, then tiles outside the kept row, then the
+            // least recently used.
+            const auto& v = cache_[victim];
+            const auto rank = eviction_rank(entry);
+            const auto victim_rank = eviction_rank(v);
+            if (rank < victim_rank || (rank == victim_rank && entry.last_used < v.last_used))
+                victim = i;
+        }
+
+        cache_misses_++;
+        auto& entry = cache_[victim];
+        auto* pixels = &cache_pixels_[victim * tile_pixels()];
+        const auto tile_bytes = tile_pixels() * sizeof(ui::Color);
+        const uint64_t offset = lvl.offset + static_cast<uint64_t>(ty * lvl.tiles_x + tx) * tile_bytes;
+
+        entry.valid = false;
+        if (!file_.seek(offset))
+            return nullptr;
+
+        auto result = file_.read(pixels, tile_bytes);
+        if (!result || *result != tile_bytes)
+            return nullptr;
+
+        entry.key = key;
+        entry.last_used = use_counter_;
+        entry.valid = true;
+        return pixels;
+    }
+
+    /* Calls fn(tx, ty) once for each tile of the level in [tx0, tx1) x [ty0, ty1).
+     * Cached tiles come first, before reading the others evicts them. The rest
+     * goes row by row from the edges in and the middle row is never evicted
+     * for another row, so it is what stays cached for the next call. */
+    template <typename Fn>
+    void for_each_tile(size_t level, int32_t tx0, int32_t ty0, int32_t tx1, int32_t ty1, Fn fn) {
+        std::array<uint32_t, max_cache_entries> cached{};
+        size_t cached_count = 0;
+
+        for (size_t i = 0; i < cache_entries_; i++) {
+            const auto& entry = cache_[i];
+            if (!entry.valid || (entry.key >> 28) != level)
+                continue;
+
+            const int32_t tx = entry.key & 0x3fff;
+            const int32_t ty = (entry.key >> 14) & 0x3fff;
+            if (tx >= tx0 && tx < tx1 && ty >= ty0 && ty < ty1) {
+                cached[cached_count++] = entry.key;
+                fn(tx, ty);
+            }
+        }
+
+        // Keep the cached tiles of the last row while reading the others.
+        const int32_t rows = ty1 - ty0;
+        const int32_t last_row = (rows > 0) ? row_at(ty0, ty1, rows - 1) : -1;
+        keep_row_ = (last_row >= 0) ? (tile_key(level, 0, last_row) >> 14) : no_row;
+
+        const auto cached_end = cached.begin() + cached_count;
+        for (int32_t k = 0; k < rows; k++) {
+            const int32_t ty = row_at(ty0, ty1, k);
+            for (int32_t tx = tx0; tx < tx1; tx++) {
+                if (tx < 0 || ty < 0 || std::find(cached.begin(), cached_end, tile_key(level, tx, ty)) == cached_end)
+                    fn(tx, ty);
+            }
+        }
+
+        keep_row_ = no_row;
+    }
+
+    uint32_t cache_hits() const { return cache_hits_; }
+    uint32_t cache_misses() const { return cache_misses_; }
+
+   private:
+    static constexpr uint32_t no_row = 0xffffffff;
+
+    struct CacheEntry {
+        uint32_t key{0};
+        uint32_t last_used{0};
+        bool valid{false};
+    };
+
+    FileType& file_;
+    TileFileHeader header_{};
+    std::array<TileLevelHeader, max_levels> levels_{};
+    std::unique_ptr<ui::Color[]> cache_pixels_{};
+    std::array<CacheEntry, max_cache_entries> cache_{};
+    size_t cache_entries_{0};
+    uint32_t use_counter_{0};
+    uint32_t keep_row_{no_row};  // Level and row bits of a tile key.
+    uint32_t cache_hits_{0};
+    uint32_t cache_misses_{0};
+
+    size_t tile_pixels() const { return header_.tile_size * header_.tile_size; }
+
+    int eviction_rank(const CacheEntry& entry) const {
+        if (!entry.valid)
+            return 0;
+        return ((entry.key >> 14) == keep_row_) ? 2 : 1;
+    }
+
+    /* Rows from the edges in, ending on the middle row. */
+    static int32_t row_at(int32_t ty0, int32_t ty1, int32_t k) {
+        return (k & 1) ? (ty1 - 1 - k / 2) : (ty0 + k / 2);
+    }
+
+    /* Only valid for tiles inside the level. */
+    static uint32_t tile_key(size_t level, int32_t tx, int32_t ty) {
+        return (level << 28) | (ty << 14) | tx;
+    }
+};
+
+} /* namespace geomap */
+
+#endif /*__GEOMAP_TILES_H__*/
@@ -237,6 +237,9 @@ void MAX2837::flush_one(const Register reg) {
 }
 
 void MAX2837::write(const address_t reg_num, const reg_t value) {
+    /* Keep the shadow in step so set_frequency() diffs against what the chip holds. */
+    if (reg_num < reg_count)
+        _map.w[reg_num] = value & 0x3ffU;
     uint16_t t = (0U << 15) | (reg_num << 10) | (value & 0x3ffU);
     _target.transfer(&t, 1);
 }
@@ -298,6 +301,11 @@ void MAX2837::set_lpf_rf_bandwidth_tx(const uint32_t bandwidth_minimum) {
 }
 
 bool MAX2837::set_frequency(const rf::Frequency lo_frequency) {
+    const reg_t rxrf_1 = _map.w[toUType(Register::RXRF_1)];
+    const reg_t syn_int_div = _map.w[toUType(Register::SYN_INT_DIV)];
+    const reg_t syn_fr_div_2 = _map.w[toUType(Register::SYN_FR_DIV_2)];
+    const reg_t syn_fr_div_1 = _map.w[toUType(Register::SYN_FR_DIV_1)];
+
     /* TODO: This is a sad implementation. Refactor. */
     if (lo::band[0].contains(lo_frequency)) {
         _map.r.syn_int_div.LOGEN_BSW = 0b00; /* 2300 - 2399.99MHz */
@@ -314,24 +322,34 @@ bool MAX2837::set_frequency(const rf::Frequency lo_frequency) {
     } else {
         return false;
     }
-    _dirty[Register::SYN_INT_DIV] = 1;
-    _dirty[Register::RXRF_1] = 1;
 
     const uint64_t div_q20 = (lo_frequency * (1 << 20)) / pll_factor;
 
     _map.r.syn_int_div.SYN_INTDIV = div_q20 >> 20;
-    _dirty[Register::SYN_INT_DIV] = 1;
     _map.r.syn_fr_div_2.SYN_FRDIV_19_10 = (div_q20 >> 10) & 0x3ff;
-    _dirty[Register::SYN_FR_DIV_2] = 1;
-    /* flush to commit high FRDIV first, as low FRDIV commits the change */
-    flush();
-
     _map.r.syn_fr_div_1.SYN_FRDIV_9_0 = (div_q20 & 0x3ff);
-    _dirty[Register::SYN_FR_DIV_1] = 1;
+
+    /* Only write registers that changed, retuning to the same LO costs no SPI traffic. */
+    mark_if_changed(Register::RXRF_1, rxrf_1);
+    const bool synth_changed = mark_if_changed(Register::SYN_INT_DIV, syn_int_div) |
+                               mark_if_changed(Register::SYN_FR_DIV_2, syn_fr_div_2) |
+                               (_map.w[toUType(Register::SYN_FR_DIV_1)] != syn_fr_div_1);
+
+    /* flush to commit high FRDIV first, as low FRDIV commits the change */
     flush();
+    if (synth_changed)
+        flush_one(Register::SYN_FR_DIV_1);
 
     return true;
 }
+
+bool MAX2837::mark_if_changed(const Register reg, const reg_t previous) {
+    const bool changed = (_map.w[toUType(reg)] != previous);
+    if (changed)
+        _dirty[reg] = 1;
+    return changed;
+}
+
 /*
 void MAX2837::set_rx_lo_iq_calibration(const size_t v) {        // Original code , rewritten below
     _map.r.rx_top_rx_bias.RX_IQERR_SPI_EN = 1;
@@ -847,6 +847,7 @@ class MAX2837 : public MAX283x {
     DirtyRegisters<Register, reg_count> _dirty{};
 
     void flush_one(const Register reg);
+    bool mark_if_changed(const Register reg, const reg_t previous);
 
     void write(const Register reg, const reg_t value);
     reg_t read(const Register reg);
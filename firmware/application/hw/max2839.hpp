@@ -706,6 +706,7 @@ class MAX2839 : public MAX283x {
     DirtyRegisters<Register, reg_count> _dirty{};
 
     void flush_one(const Register reg);
+    bool mark_if_changed(const Register reg, const reg_t previous);
 
     void write(const Register reg, const reg_t value);
     reg_t read(const Register reg);
@@ -176,6 +176,9 @@ void RFFC507x::flush() {
 }
 
 void RFFC507x::write(const address_t reg_num, const spi::reg_t value) {
+    /* Keep the shadow in step so set_frequency() diffs against what the chip holds. */
+    if (reg_num < reg_count)
+        _map.w[reg_num] = value;
     _bus.write(reg_num, value);
 }
 
@@ -236,21 +239,28 @@ void RFFC507x::set_frequency(const rf::Frequency lo_frequency) {
     /* Boost charge pump leakage if VCO frequency > 3.2GHz, indicated by
      * prescaler divider set to 4 (log2=2) instead of 2 (log2=1).
      */
-    if (synth_config.prescaler_divider_log2 == 2) {
-        _map.r.lf.pllcpl = 3;
-    } else {
-        _map.r.lf.pllcpl = 2;
+    const uint8_t pllcpl = (synth_config.prescaler_divider_log2 == 2) ? 3 : 2;
+    if (_map.r.lf.pllcpl != pllcpl) {
+        _map.r.lf.pllcpl = pllcpl;
+        flush_one(Register::LF);
     }
-    flush_one(Register::LF);
+
+    /* Only write the frequency registers that changed. */
+    const auto p2_freq1 = _map.w[toUType(Register::P2_FREQ1)];
+    const auto p2_freq2 = _map.w[toUType(Register::P2_FREQ2)];
+    const auto p2_freq3 = _map.w[toUType(Register::P2_FREQ3)];
 
     _map.r.p2_freq1.p2n = synth_config.n_divider_q24 >> 24;
     _map.r.p2_freq1.p2lodiv = synth_config.lo_divider_log2;
     _map.r.p2_freq1.p2presc = synth_config.prescaler_divider_log2;
     _map.r.p2_freq2.p2nmsb = (synth_config.n_divider_q24 >> 8) & 0xffff;
     _map.r.p2_freq3.p2nlsb = synth_config.n_divider_q24 & 0xff;
-    _dirty[Register::P2_FREQ1] = 1;
-    _dirty[Register::P2_FREQ2] = 1;
-    _dirty[Register::P2_FREQ3] = 1;
+    if (_map.w[toUType(Register::P2_FREQ1)] != p2_freq1)
+        _dirty[Register::P2_FREQ1] = 1;
+    if (_map.w[toUType(Register::P2_FREQ2)] != p2_freq2)
+        _dirty[Register::P2_FREQ2] = 1;
+    if (_map.w[toUType(Register::P2_FREQ3)] != p2_freq3)
+        _dirty[Register::P2_FREQ3] = 1;
     flush();
 }
 
@@ -0,0 +1,420 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __IO_LZ4_H
+#define __IO_LZ4_H
+
+#include "io.hpp"
+
+#include "file.hpp"
+#include "optional.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+/* BufferType requires the following members
+ * Result<Size> read(void* data, Size bytes_to_read)
+ */
+
+/* Streaming decoder for LZ4 frames (as written by the lz4 command line tool).
+ * The last WindowSize bytes of output are kept for matches, in the reader
+ * itself, so keep it out of small thread stacks. The M0 can't hold the 64 KiB
+ * window of the format, so only frames with 64 KiB blocks (lz4 -B4) and
+ * independent blocks (the default, not -BD) are accepted, other frames fail
+ * with FR_INVALID_PARAMETER. A match reaching back further than the window
+ * fails with FR_NOT_ENOUGH_CORE, which happens only when the output is larger
+ * than the window. Concatenated and skippable frames are supported, checksums
+ * are skipped but not verified and dictionaries are not supported. */
+template <typename BufferType, size_t WindowSize = 4096>
+class BufferLZ4Reader : public stream::Reader {
+    static_assert((WindowSize & (WindowSize - 1)) == 0, "WindowSize must be a power of 2");
+
+   public:
+    using Size = File::Size;
+    template <typename T>
+    using Result = File::Result<T>;
+
+    BufferLZ4Reader(BufferType& buffer)
+        : buffer_{buffer} {}
+
+    BufferLZ4Reader(const BufferLZ4Reader&) = delete;
+    BufferLZ4Reader& operator=(const BufferLZ4Reader&) = delete;
+
+    /* Returns up to bytes of decompressed data, 0 at the end of the stream. */
+    Result<Size> read(void* const buffer, const Size bytes) override {
+        auto out = static_cast<uint8_t*>(buffer);
+        Size produced = 0;
+
+        while (produced < bytes) {
+            if (copy_length_ > 0) {
+                const auto count = std::min<Size>(bytes - produced, copy_length_);
+                if (state_ == State::Match)
+                    copy_match(out + produced, count);
+                else if (!copy_input(out + produced, count))
+                    return failure();
+
+                produced += count;
+                copy_length_ -= count;
+                continue;
+            }
+
+            if (!advance()) {
+                if (state_ == State::End)
+                    break;
+                return failure();
+            }
+        }
+
+        decompressed_bytes_ += produced;
+        return produced;
+    }
+
+    /* Compressed bytes pulled from the buffer so far. */
+    uint64_t compressed_bytes() const { return compressed_bytes_; }
+
+    /* Decompressed bytes returned so far. */
+    uint64_t decompressed_bytes() const { return decompressed_bytes_; }
+
+   private:
+    static constexpr uint32_t frame_magic = 0x184D2204;
+    static constexpr uint32_t skippable_magic = 0x184D2A50;  // Low nibble is user defined.
+    static constexpr size_t input_size = 512;
+    static constexpr uint32_t min_match = 4;
+    static constexpr uint8_t max_block_size_id = 4;  // 64 KiB, the smallest the format offers.
+
+    enum class State : uint8_t {
+        Frame,     // Expecting a frame header or the end of the stream.
+        Block,     // Expecting a block size.
+        Sequence,  // Expecting a sequence token in a compressed block.
+        Literals,  // Copying literals, then an offset follows.
+        Match,     // Copying a match from the window.
+        Raw,       // Copying an uncompressed block.
+        End,
+    };
+
+    BufferType& buffer_;
+    State state_{State::Frame};
+    uint8_t flags_{0};
+    uint8_t match_nibble_{0};
+    uint16_t match_offset_{0};
+    uint32_t block_remaining_{0};
+    uint32_t copy_length_{0};
+    uint32_t window_pos_{0};
+    uint32_t history_{0};
+    uint64_t compressed_bytes_{0};
+    uint64_t decompressed_bytes_{0};
+    size_t input_pos_{0};
+    size_t input_end_{0};
+    Optional<File::Error> error_{};
+    std::array<uint8_t, input_size> input_{};
+    std::array<uint8_t, WindowSize> window_{};
+
+    bool has_independent_blocks() const { return flags_ & 0x20; }
+    bool has_block_checksum() const { return flags_ & 0x10; }
+    bool has_content_size() const { return flags_ & 0x08; }
+    bool has_content_checksum() const { return flags_ & 0x04; }
+    bool has_dictionary() const { return flags_ & 0x01; }
+
+    File::Error failure() {
+        return error_.is_valid() ? error_.value() : File::Error{FR_INT_ERR};
+    }
+
+    bool corrupt() {
+        error_ = File::Error{FR_INT_ERR};
+        return false;
+    }
+
+    bool unsupported(FRESULT reason) {
+        error_ = File::Error{reason};
+        return false;
+    }
+
+    bool refill() {
+        auto result = buffer_.read(input_.data(), input_.size());
+        if (result.is_error()) {
+            error_ = result.error();
+            return false;
+        }
+
+        input_pos_ = 0;
+        input_end_ = *result;
+        compressed_bytes_ += input_end_;
+        return input_end_ > 0;
+    }
+
+    bool get_byte(uint8_t& value) {
+        if (input_pos_ == input_end_ && !refill())
+            return false;
+
+        value = input_[input_pos_++];
+        return true;
+    }
+
+    bool get_u32(uint32_t& value) {
+        value = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            uint8_t b;
+            if (!get_byte(b))
+                return false;
+            value |= static_cast<uint32_t>(b) << (i * 8);
+        }
+        return true;
+    }
+
+    bool skip(uint32_t count) {
+        while (count > 0) {
+            if (input_pos_ == input_end_ && !refill())
+                return false;
+
+            const auto n = std::min<size_t>(count, input_end_ - input_pos_);
+            input_pos_ += n;
+            count -= n;
+        }
+        return true;
+    }
+
+    /* Reads a byte belonging to the current compressed block. */
+    bool get_block_byte(uint8_t& value) {
+        if (block_remaining_ == 0)
+            return corrupt();
+
+        --block_remaining_;
+        return get_byte(value);
+    }
+
+    /* Adds the 255-terminated length extension to a nibble of 15. */
+    bool get_length(uint32_t& length) {
+        if (length != 15)
+            return true;
+
+        uint8_t b;
+        do {
+            if (!get_block_byte(b))
+                return false;
+            length += b;
+        } while (b == 255);
+
+        return true;
+    }
+
+    void append_window(const uint8_t* data, size_t count) {
+        history_ = std::min<uint32_t>(history_ + count, WindowSize);
+
+        while (count > 0) {
+            const auto pos = window_pos_ & (WindowSize - 1);
+            const auto n = std::min<size_t>(count, WindowSize - pos);
+            memcpy(&window_[pos], data, n);
+            window_pos_ += n;
+            data += n;
+            count -= n;
+        }
+    }
+
+    /* Copies literals or a raw block straight from the input buffer. */
+    bool copy_input(uint8_t* out, Size count) {
+        while (count > 0) {
+            if (input_pos_ == input_end_ && !refill())
+                return false;
+
+            const auto n = std::min<size_t>(count, input_end_ - input_pos_);
+            memcpy(out, &input_[input_pos_], n);
+            append_window(out, n);
+            input_pos_ += n;
+            out += n;
+            count -= n;
+        }
+        return true;
+    }
+
+    /* Byte at a time, matches may overlap their own output. */
+    void copy_match(uint8_t* out, Size count) {
+        for (Size i = 0; i < count; ++i) {
+            const auto b = window_[(window_pos_ - match_offset_) & (WindowSize - 1)];
+            window_[window_pos_ & (WindowSize - 1)] = b;
+            ++window_pos_;
+            out[i] = b;
+        }
+        history_ = std::min<uint32_t>(history_ + count, WindowSize);
+    }
+
+    /* Parses the next header, token or offset. Returns false at the end
+     * of the stream (state_ == End) or on error. */
+    bool advance() {
+        switch (state_) {
+            case State::Frame:
+                return parse_frame_header();
+
+            case State::Block:
+                return parse_block_header();
+
+            case State::Sequence:
+                return parse_token();
+
+            case State::Literals:
+                // The last sequence of a block has no match.
+                if (block_remaining_ == 0) {
+                    state_ = State::Sequence;
+                    return true;
+                }
+                return parse_match();
+
+            case State::Match:
+            case State::Raw:
+                state_ = State::Sequence;
+                return true;
+
+            case State::End:
+                return false;
+        }
+        return false;
+    }
+
+    bool parse_frame_header() {
+        uint32_t magic;
+        if (input_pos_ == input_end_ && !refill()) {
+            // A clean end only between frames.
+            if (error_.is_valid())
+                return false;
+            state_ = State::End;
+            return false;
+        }
+        if (!get_u32(magic))
+            return false;
+
+        if ((magic & 0xFFFFFFF0) == skippable_magic) {
+            uint32_t size;
+            return get_u32(size) && skip(size);
+        }
+        if (magic != frame_magic)
+            return corrupt();
+
+        uint8_t bd;
+        if (!get_byte(flags_) || !get_byte(bd))
+            return false;
+        if ((flags_ >> 6) != 0x01)
+            return corrupt();
+        if (has_dictionary() || !has_independent_blocks() || ((bd >> 4) & 0x07) > max_block_size_id)
+            return unsupported(FR_INVALID_PARAMETER);
+
+        // Content size, then the header checksum.
+        if (!skip((has_content_size() ? 8 : 0) + 1))
+            return false;
+
+        state_ = State::Block;
+        return true;
+    }
+
+    bool parse_block_header() {
+        uint32_t size;
+        if (!get_u32(size))
+            return false;
+
+        if (size == 0) {
+            // End mark.
+            if (has_content_checksum() && !skip(4))
+                return false;
+            state_ = State::Frame;
+        } else if (size & 0x80000000) {
+            block_remaining_ = 0;
+            copy_length_ = size & 0x7FFFFFFF;
+            state_ = State::Raw;
+        } else {
+            block_remaining_ = size;
+            state_ = State::Sequence;
+        }
+        return true;
+    }
+
+    bool parse_token() {
+        if (block_remaining_ == 0) {
+            if (has_block_checksum() && !skip(4))
+                return false;
+            state_ = State::Block;
+            return true;
+        }
+
+        uint8_t token;
+        if (!get_block_byte(token))
+            return false;
+
+        uint32_t length = token >> 4;
+        if (!get_length(length))
+            return false;
+        if (length > block_remaining_)
+            return corrupt();
+
+        block_remaining_ -= length;
+        match_nibble_ = token & 0x0F;
+        copy_length_ = length;
+        state_ = State::Literals;
+        return true;
+    }
+
+    bool parse_match() {
+        uint8_t lo, hi;
+        if (!get_block_byte(lo) || !get_block_byte(hi))
+            return false;
+
+        match_offset_ = lo | (hi << 8);
+        if (match_offset_ > WindowSize)
+            return unsupported(FR_NOT_ENOUGH_CORE);
+        if (match_offset_ == 0 || match_offset_ > history_)
+            return corrupt();
+
+        uint32_t length = match_nibble_;
+        if (!get_length(length))
+            return false;
+
+        copy_length_ = length + min_match;
+        state_ = State::Match;
+        return true;
+    }
+};
+
+/* Reads decompressed data from an LZ4 file. */
+class LZ4FileReader : public stream::Reader {
+   public:
+    LZ4FileReader() = default;
+
+    LZ4FileReader(const LZ4FileReader&) = delete;
+    LZ4FileReader& operator=(const LZ4FileReader&) = delete;
+    LZ4FileReader(LZ4FileReader&& file) = delete;
+    LZ4FileReader& operator=(LZ4FileReader&&) = delete;
+
+    Optional<File::Error> open(const std::filesystem::path& filename) {
+        return file_.open(filename);
+    }
+
+    File::Result<File::Size> read(void* const buffer, const File::Size bytes) override {
+        return reader_.read(buffer, bytes);
+    }
+
+    const File& file() const& { return file_; }
+    uint64_t compressed_bytes() const { return reader_.compressed_bytes(); }
+
+   private:
+    File file_{};
+    BufferLZ4Reader<File> reader_{file_};
+};
+
+#endif
@@ -42,6 +42,8 @@ using namespace hackrf::one;
 #include "portapack.hpp"
 #include "portapack_persistent_memory.hpp"
 
+#include <algorithm>
+
 /* Direct access to the radio. Setting values incorrectly can damage
  * the device. Applications should use ReceiverModel or TransmitterModel
  * instead of calling these functions directly. */
@@ -97,6 +99,10 @@ static rf::Direction direction{rf::Direction::Receive};
 static bool baseband_invert = false;
 static bool mixer_invert = false;
 
+// Last programmed tuning, invalid when the synthesizers need a full reprogram.
+static tuning::config::Config current_tuning{};
+static debug::retune::Stats retune_stats{};
+
 void init() {
     if (hackrf_r9) {
         gpio_r9_not_ant_pwr.write(1);
@@ -110,6 +116,7 @@ void init() {
     second_if->init();
     baseband_codec.init();
     baseband_cpld.init();
+    current_tuning = {};
 }
 
 void set_direction(const rf::Direction new_direction) {
@@ -156,7 +163,7 @@ void set_direction(const rf::Direction new_direction) {
         led_tx.on();
 }
 
-bool set_tuning_frequency(const rf::Frequency frequency) {
+tuning::config::Config tuning_config(const rf::Frequency frequency) {
     rf::Frequency final_frequency = frequency;
     // if converter feature is enabled
     if (portapack::persistent_memory::config_converter()) {
@@ -181,8 +188,23 @@ bool set_tuning_frequency(const rf::Frequency frequency) {
             final_frequency = final_frequency + portapack::persistent_memory::config_freq_rx_correction();
     }
 
-    const auto tuning_config = tuning::config::create(final_frequency);
-    if (tuning_config.is_valid()) {
+    return tuning::config::create(final_frequency);
+}
+
+bool set_tuning_frequency(const rf::Frequency frequency) {
+    return set_tuning_config(tuning_config(frequency));
+}
+
+bool set_tuning_config(const tuning::config::Config& tuning_config) {
+    if (!tuning_config.is_valid())
+        return false;
+
+    const halrtcnt_t retune_start = halGetCounterValue();
+
+    // Only touch what differs from the configuration programmed last time.
+    const bool first_lo_changed = !current_tuning.is_valid() ||
+                                  (tuning_config.first_lo_frequency != current_tuning.first_lo_frequency);
+    if (first_lo_changed) {
         first_if.disable();
 
         // Program first local oscillator frequency (if there is one) into RFFC507x
@@ -190,18 +212,30 @@ bool set_tuning_frequency(const rf::Frequency frequency) {
             first_if.set_frequency(tuning_config.first_lo_frequency);
             first_if.enable();
         }
+    }
 
-        // Program second local oscillator frequency into MAX283x
-        const auto result_second_if = second_if->set_frequency(tuning_config.second_lo_frequency);
+    // Program second local oscillator frequency into MAX283x, only changed registers are written
+    const auto result_second_if = second_if->set_frequency(tuning_config.second_lo_frequency);
 
+    if (!current_tuning.is_valid() || (tuning_config.rf_path_band != current_tuning.rf_path_band))
         rf_path.set_band(tuning_config.rf_path_band);
+
+    if (!current_tuning.is_valid() || (tuning_config.mixer_invert != mixer_invert)) {
         mixer_invert = tuning_config.mixer_invert;
         baseband_cpld.set_invert(mixer_invert ^ baseband_invert);
-
-        return result_second_if;
-    } else {
-        return false;
     }
+
+    current_tuning = result_second_if ? tuning_config : tuning::config::Config{};
+
+    const uint32_t retune_us = RTT2US(halGetCounterValue() - retune_start);
+    retune_stats.count++;
+    if (!first_lo_changed)
+        retune_stats.first_lo_skipped++;
+    retune_stats.last_us = retune_us;
+    retune_stats.max_us = std::max(retune_stats.max_us, retune_us);
+    retune_stats.total_us += retune_us;
+
+    return result_second_if;
 }
 
 void set_rf_amp(const bool rf_amp) {
@@ -276,6 +310,7 @@ void disable() {
     baseband_codec.set_mode(max5864::Mode::Shutdown);
     second_if->set_mode(max2837::Mode::Standby);
     first_if.disable();
+    current_tuning = {};
     set_rf_amp(false);
 
     led_rx.off();
@@ -292,6 +327,8 @@ uint32_t register_read(const size_t register_number) {
 
 void register_write(const size_t register_number, uint32_t value) {
     radio::first_if.write(register_number, value);
+    // The register may hold tuning state, force the next retune to reprogram everything.
+    current_tuning = {};
 }
 
 } /* namespace first_if */
@@ -304,6 +341,7 @@ uint32_t register_read(const size_t register_number) {
 
 void register_write(const size_t register_number, uint32_t value) {
     radio::second_if->write(register_number, value);
+    current_tuning = {};
 }
 
 int8_t temp_sense() {
@@ -312,6 +350,18 @@ int8_t temp_sense() {
 
 } /* namespace second_if */
 
+namespace retune {
+
+const Stats& stats() {
+    return retune_stats;
+}
+
+void reset_stats() {
+    retune_stats = {};
+}
+
+} /* namespace retune */
+
 } /* namespace debug */
 
 } /* namespace radio */
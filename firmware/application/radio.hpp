@@ -23,6 +23,7 @@
 #define __RADIO_H__
 
 #include "rf_path.hpp"
+#include "tuning.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -46,6 +47,9 @@ void init();
 
 void set_direction(const rf::Direction new_direction);
 bool set_tuning_frequency(const rf::Frequency frequency);
+/* Synthesizer setup for frequency, with converter and correction applied. */
+tuning::config::Config tuning_config(const rf::Frequency frequency);
+bool set_tuning_config(const tuning::config::Config& tuning_config);
 void set_rf_amp(const bool rf_amp);
 void set_lna_gain(const int_fast8_t db);
 void set_vga_gain(const int_fast8_t db);
@@ -81,6 +85,22 @@ int8_t temp_sense();
 
 } /* namespace second_if */
 
+namespace retune {
+
+/* Timing of set_tuning_frequency(), in microseconds. */
+struct Stats {
+    uint32_t count;
+    uint32_t first_lo_skipped;  // Retunes that left the RFFC507x alone.
+    uint32_t last_us;
+    uint32_t max_us;
+    uint64_t total_us;
+};
+
+const Stats& stats();
+void reset_stats();
+
+} /* namespace retune */
+
 } /* namespace debug */
 
 } /* namespace radio */
@@ -156,6 +156,12 @@ void ReceiverModel::set_nbfm_configuration(uint8_t n) {
     }
 }
 
+// Pass band of the NBFM channel filter, which runs at 48 kHz.
+uint32_t ReceiverModel::nbfm_channel_bandwidth() const {
+    const auto& channel = nbfm_configs[nbfm_configuration()].channel;
+    return (channel.high_frequency_normalized - channel.low_frequency_normalized) * 48000.0f + 0.5f;
+}
+
 uint8_t ReceiverModel::wfm_configuration() const {
     return settings_.wfm_config_index;
 }
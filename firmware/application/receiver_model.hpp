@@ -89,6 +89,7 @@ class ReceiverModel {
 
     uint8_t nbfm_configuration() const;
     void set_nbfm_configuration(uint8_t n);
+    uint32_t nbfm_channel_bandwidth() const;
 
     uint8_t wfm_configuration() const;
     void set_wfm_configuration(uint8_t n);
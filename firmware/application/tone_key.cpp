@@ -174,6 +174,26 @@ tone_index tone_key_index_by_value(uint32_t value) {
         return -1;
 }
 
+// Return DCS code in the usual octal form, e.g. "D023N"
+std::string dcs_code_string(uint32_t code, bool inverted) {
+    std::string str{"D000N"};
+    for (size_t i = 3; i > 0; i--) {
+        str[i] = '0' + (code & 7);
+        code >>= 3;
+    }
+    if (inverted)
+        str[4] = 'I';
+    return str;
+}
+
+// Return string for a coded squelch report from the NFM baseband
+std::string coded_squelch_string(const CodedSquelchMessage& message, size_t max_length) {
+    if (message.type == CodedSquelchMessage::Type::CTCSS)
+        return tone_key_string_by_value(message.value, max_length);
+
+    return dcs_code_string(message.value, message.type == CodedSquelchMessage::Type::DCSInverted);
+}
+
 tone_index tone_key_index_by_string(char* str) {
     if (!str)
         return -1;
@@ -24,6 +24,8 @@
 #ifndef __TONE_KEY_H_
 #define __TONE_KEY_H_
 
+#include "message.hpp"
+
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -47,6 +49,8 @@ std::string tone_key_string(tone_index index);
 std::string tone_key_value_string(tone_index index);
 std::string tone_key_string_by_value(uint32_t value, size_t max_length);
 tone_index tone_key_index_by_value(uint32_t value);
+std::string dcs_code_string(uint32_t code, bool inverted);
+std::string coded_squelch_string(const CodedSquelchMessage& message, size_t max_length);
 
 }  // namespace tonekey
 
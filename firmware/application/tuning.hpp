@@ -51,10 +51,10 @@ struct Config {
         return (second_lo_frequency != 0);
     }
 
-    const rf::Frequency first_lo_frequency;
-    const rf::Frequency second_lo_frequency;
-    const rf::path::Band rf_path_band;
-    const bool mixer_invert;
+    rf::Frequency first_lo_frequency;
+    rf::Frequency second_lo_frequency;
+    rf::path::Band rf_path_band;
+    bool mixer_invert;
 };
 
 Config create(const rf::Frequency target_frequency);
@@ -254,21 +254,329 @@ void GeoMap::map_read_line(ui::Color* buffer, uint16_t pixels) {
     }
 }
 
-void GeoMap::draw_markers(Painter& painter) {
-    for (int i = 0; i < markerListLen; ++i) {
-        draw_marker_item(painter, markerList[i], Color::blue(), Color::blue(), Color::magenta());
+static int32_t floor_div(int32_t a, int32_t b) {
+    return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+}
+
+// Draws the map from the tiled file, one LCD window per tile (or per row of a
+// tile when zoomed in). Zoom-out uses the closest precomputed level so only the
+// pixels actually shown are read from the SD card.
+void GeoMap::draw_map_tiles(const Rect r, int32_t seek_x, int32_t seek_y) {
+    const int32_t zoom_in = (map_zoom > 1) ? map_zoom : 1;
+    const int32_t scale = (map_zoom < 0) ? -map_zoom : 1;
+    const size_t level = map_tiles.level_for_scale(scale);
+    const int32_t level_scale = map_tiles.level_scale(level);
+    const int32_t step = scale / level_scale;  // Level pixels skipped per screen pixel.
+    const int32_t tile_size = map_tiles.tile_size();
+    const auto bg_color = Color::black();
+
+    // Window of the level covered by the screen rect.
+    const int32_t lx0 = floor_div(seek_x, level_scale);
+    const int32_t ly0 = floor_div(seek_y, level_scale);
+    const int32_t lx1 = lx0 + (r.width() / zoom_in) * step;
+    const int32_t ly1 = ly0 + (r.height() / zoom_in) * step;
+
+    // Tiles covering the window; the cache decides the drawing order.
+    const int32_t tx0 = floor_div(lx0, tile_size);
+    const int32_t ty0 = floor_div(ly0, tile_size);
+    const int32_t tx1 = floor_div(lx1 - 1, tile_size) + 1;
+    const int32_t ty1 = floor_div(ly1 - 1, tile_size) + 1;
+
+    map_tiles.for_each_tile(level, tx0, ty0, tx1, ty1, [&](int32_t tx, int32_t ty) {
+        // First sampled row in this tile and count of rows shown.
+        const int32_t y_begin = std::max(ty * tile_size, ly0);
+        const int32_t y_end = std::min((ty + 1) * tile_size, ly1);
+        const int32_t y_first = y_begin + (step - (y_begin - ly0) % step) % step;
+        if (y_first >= y_end) return;
+        const int32_t rows = (y_end - y_first + step - 1) / step;
+        const int32_t sy = r.top() + ((y_first - ly0) / step) * zoom_in;
+
+        const int32_t x_begin = std::max(tx * tile_size, lx0);
+        const int32_t x_end = std::min((tx + 1) * tile_size, lx1);
+        const int32_t x_first = x_begin + (step - (x_begin - lx0) % step) % step;
+        if (x_first >= x_end) return;
+        const int32_t cols = (x_end - x_first + step - 1) / step;
+        const int32_t sx = r.left() + ((x_first - lx0) / step) * zoom_in;
+
+        const auto* tile = map_tiles.tile(level, tx, ty);
+        if (!tile) {
+            display.fill_rectangle({sx, sy, cols * zoom_in, rows * zoom_in}, bg_color);
+            return;
+        }
+
+        const auto* src = &tile[(y_first - ty * tile_size) * tile_size + (x_first - tx * tile_size)];
+        const int32_t src_row_step = tile_size * step;
+
+        if (zoom_in == 1) {
+            // Whole visible part of the tile in a single window.
+            auto* dst = tile_block.get();
+            for (int32_t y = 0; y < rows; y++, src += src_row_step)
+                for (int32_t x = 0; x < cols; x++)
+                    *dst++ = src[x * step];
+
+            display.draw_pixels({sx, sy, cols, rows}, tile_block.get(), rows * cols);
+        } else {
+            // Expand each pixel to zoom_in x zoom_in; one window per source row.
+            // As long as MOD(width,map_zoom)==0 no clipping is needed (see map_read_line()).
+            const int32_t width = cols * zoom_in;
+            for (int32_t y = 0; y < rows; y++, src += src_row_step) {
+                auto* dst = tile_block.get();
+                for (int32_t x = 0; x < cols; x++)
+                    for (int32_t j = 0; j < zoom_in; j++)
+                        *dst++ = src[x];
+
+                const int32_t lines = std::min<int32_t>(zoom_in, tile_block_size / width);
+                for (int32_t j = 1; j < lines; j++)
+                    std::copy_n(tile_block.get(), width, tile_block.get() + j * width);
+
+                for (int32_t j = 0; j < zoom_in; j += lines) {
+                    const int32_t n = std::min(lines, zoom_in - j);
+                    display.draw_pixels({sx, sy + y * zoom_in + j, width, n}, tile_block.get(), width * n);
+                }
+            }
+        }
+    });
+}
+
+// Reads count map pixels of row map_y, starting at map_x and taking every step-th pixel.
+// Pixels outside the map are black.
+void GeoMap::fetch_map_pixels(int32_t map_x, int32_t map_y, int32_t step, ui::Color* buffer, int32_t count) {
+    if (map_tiled) {
+        const size_t level = map_tiles.level_for_scale(step);
+        const int32_t level_scale = map_tiles.level_scale(level);
+        const int32_t level_step = step / level_scale;
+        const int32_t tile_size = map_tiles.tile_size();
+        const int32_t ly = floor_div(map_y, level_scale);
+        const int32_t ty = floor_div(ly, tile_size);
+        int32_t lx = floor_div(map_x, level_scale);
+        int32_t tile_x = floor_div(lx, tile_size);
+        const ui::Color* tile = map_tiles.tile(level, tile_x, ty);
+
+        for (int32_t i = 0; i < count; i++, lx += level_step) {
+            const int32_t tx = floor_div(lx, tile_size);
+            if (tx != tile_x) {
+                tile_x = tx;
+                tile = map_tiles.tile(level, tile_x, ty);
+            }
+            buffer[i] = tile ? tile[(ly - ty * tile_size) * tile_size + (lx - tx * tile_size)] : Color::black();
+        }
+        return;
+    }
+
+    std::array<ui::Color, 64> chunk;
+    int32_t i = 0;
+    while (i < count) {
+        const int32_t x = map_x + i * step;
+        if ((map_y < 0) || (map_y >= map_height) || (x < 0) || (x >= map_width)) {
+            buffer[i++] = Color::black();
+            continue;
+        }
+
+        // Read as many wanted pixels as fit in one chunk with a single seek.
+        const int32_t n = std::min({count - i,
+                                    (int32_t)(chunk.size() - 1) / step + 1,
+                                    (map_width - 1 - x) / step + 1});
+        map_file.seek(4 + ((x + map_width * map_y) << 1));
+        map_file.read(chunk.data(), ((n - 1) * step + 1) << 1);
+
+        for (int32_t k = 0; k < n; k++)
+            buffer[i + k] = chunk[k * step];
+        i += n;
+    }
+}
+
+// Restores the map under clip (used to erase markers).
+void GeoMap::draw_map_rect(const Rect clip) {
+    const auto r = screen_rect();
+    const auto area = clip.intersect(r);
+    if (area.is_empty())
+        return;
+
+    if (!map_visible) {
+        draw_map_grid(area);
+        return;
     }
+
+    std::array<ui::Color, geomap_rect_width> map_line_buffer;
+    const int32_t zoom_in = (map_zoom > 1) ? map_zoom : 1;
+    const int32_t step = (map_zoom < 0) ? -map_zoom : 1;
+
+    // Widen to whole zoomed-in map pixels.
+    const int32_t x0 = ((area.left() - r.left()) / zoom_in) * zoom_in;
+    const int32_t x1 = std::min<int32_t>(r.width(), area.right() - r.left());
+    const int32_t y0 = ((area.top() - r.top()) / zoom_in) * zoom_in;
+    const int32_t y1 = std::min<int32_t>(r.height(), area.bottom() - r.top());
+    const int32_t width = x1 - x0;
+    const int32_t count = (width + zoom_in - 1) / zoom_in;
+
+    for (int32_t y = y0; y < y1; y += zoom_in) {
+        fetch_map_pixels(map_seek_x + (x0 / zoom_in) * step, map_seek_y + (y / zoom_in) * step, step, map_line_buffer.data(), count);
+
+        // Expand in place, from the end so no pixel is overwritten before use.
+        for (int32_t i = width - 1; (zoom_in > 1) && (i >= 0); i--)
+            map_line_buffer[i] = map_line_buffer[i / zoom_in];
+
+        for (int32_t j = 0; (j < zoom_in) && (y + j < y1); j++)
+            display.draw_pixels({r.left() + x0, r.top() + y + j, width, 1}, map_line_buffer.data(), width);
+    }
+}
+
+static uint32_t tag_hash(const std::string& tag) {
+    // FNV-1a, only used to notice a changed tag.
+    uint32_t hash = 2166136261u;
+    for (const auto c : tag)
+        hash = (hash ^ (uint8_t)c) * 16777619u;
+    return hash;
+}
+
+bool GeoMap::OverlayItem::same_as(const OverlayItem& other) const {
+    const auto kind = [](int8_t source) { return (source >= 0) ? 0 : source; };
+    return (point.x() == other.point.x()) && (point.y() == other.point.y()) && (angle == other.angle) && (tag_hash == other.tag_hash) &&
+           (kind(source) == kind(other.source));
 }
 
-void GeoMap::draw_marker_item(Painter& painter, GeoMarker& item, const Color color, const Color fontColor, const Color backColor) {
+// Area drawn by draw_marker(): the symbol and the tag above it.
+Rect GeoMap::marker_footprint(const ui::Point itemPoint, const std::string& itemTag) {
     const auto r = screen_rect();
-    const ui::Point itemPoint = item_rect_pixel(item);
+    Rect footprint;
+    int tagOffset;
 
-    if ((itemPoint.x() >= 0) && (itemPoint.x() < r.width()) &&
-        (itemPoint.y() > 10) && (itemPoint.y() < r.height()))  // Dont draw within symbol size of top
-    {
-        draw_marker(painter, {itemPoint.x(), itemPoint.y() + r.top()}, item.angle, item.tag, color, fontColor, backColor);
+    if (mode_ == PROMPT) {
+        footprint = {itemPoint - Point(16, 16), {32, 32}};
+        tagOffset = 16;
+    } else if (angle_ < 360) {
+        footprint = {itemPoint - Point(11, 11), {23, 23}};
+        tagOffset = 10;
+    } else {
+        footprint = {itemPoint - Point(8, 8), {16, 16}};
+        tagOffset = 8;
     }
+
+    if ((itemPoint.y() - r.top() >= 32) && (itemTag.find_first_not_of(' ') != itemTag.npos)) {
+        const auto& font = style().font;
+        footprint += Rect{itemPoint - Point(((int)itemTag.length() * 8 / 2), 14 + tagOffset),
+                          {(int)itemTag.length() * font.char_width(), font.line_height()}};
+    }
+
+    return footprint.intersect(r);
+}
+
+// Builds the list of markers that should be visible, in drawing order.
+int GeoMap::collect_overlay_items(OverlayItems& items) {
+    const auto r = screen_rect();
+    int count = 0;
+
+    const auto add_item = [this, &items, &count, &r](GeoMarker& item, int8_t source) {
+        const ui::Point itemPoint = item_rect_pixel(item);
+
+        if ((itemPoint.x() >= 0) && (itemPoint.x() < r.width()) &&
+            (itemPoint.y() > 10) && (itemPoint.y() < r.height()))  // Dont draw within symbol size of top
+        {
+            const ui::Point p{itemPoint.x(), itemPoint.y() + r.top()};
+            items[count++] = {marker_footprint(p, item.tag), p, tag_hash(item.tag), item.angle, source, false};
+        }
+    };
+
+    for (int i = 0; i < markerListLen; ++i)
+        add_item(markerList[i], i);
+
+    if ((my_pos.lat < INVALID_LAT_LON) && (my_pos.lon < INVALID_LAT_LON))
+        add_item(my_pos, OverlayItem::SourceMyPos);
+
+    if (!manual_panning_ && !hide_center_marker_) {
+        const ui::Point p = r.center() + Point(zoom_pixel_offset, zoom_pixel_offset);
+        items[count++] = {marker_footprint(p, tag_), p, tag_hash(tag_), angle_, OverlayItem::SourceCenter, false};
+    }
+
+    return count;
+}
+
+void GeoMap::draw_overlay_item(Painter& painter, const OverlayItem& item) {
+    if (item.source >= 0) {
+        draw_marker(painter, item.point, item.angle, markerList[item.source].tag, Color::blue(), Color::blue(), Color::magenta());
+    } else if (item.source == OverlayItem::SourceMyPos) {
+        draw_marker(painter, item.point, item.angle, my_pos.tag, Color::yellow());
+    } else if (item.source == OverlayItem::SourceCenter) {
+        draw_marker(painter, item.point, item.angle, tag_, Color::red(), Color::white(), Color::black());
+    }
+}
+
+// Brings the markers on the LCD in line with the marker list. Markers that
+// moved or went away are erased by restoring only the map under them, so an
+// update costs its marker footprints instead of a full map redraw. At most
+// MaxMarkerUpdatesPerPaint erase/draw operations are done per paint, unless
+// the map itself was just redrawn, and MarkerDrawsPerPaint of them are kept
+// for draws. The rest is done on the following frames.
+void GeoMap::update_overlay(Painter& painter, bool map_redrawn) {
+    OverlayItems desired{};
+    const int desired_count = collect_overlay_items(desired);
+    const auto desired_end = desired.begin() + desired_count;
+
+    OverlayItems kept{};
+    int kept_count = 0;
+    std::array<Rect, MaxMarkerUpdatesPerPaint> restored{};
+    int restored_count = 0;
+    int budget = map_redrawn ? MaxOverlayItems : MaxMarkerUpdatesPerPaint;
+    const int erase_budget = map_redrawn ? MaxOverlayItems : MaxMarkerUpdatesPerPaint - MarkerDrawsPerPaint;
+    bool pending = false;
+
+    for (int i = 0; i < overlay_drawn_count; i++) {
+        auto item = overlay_drawn[i];
+        auto match = std::find_if(desired.begin(), desired_end, [&item](const OverlayItem& d) {
+            return !d.placed && d.same_as(item);
+        });
+
+        if (match != desired_end) {
+            // Unchanged, leave it on screen.
+            match->placed = true;
+            kept[kept_count++] = *match;
+        } else if (restored_count < erase_budget && restored_count < MaxMarkerUpdatesPerPaint) {
+            draw_map_rect(item.footprint);
+            restored[restored_count++] = item.footprint;
+            budget--;
+        } else {
+            // Still on screen; erased on a later paint.
+            item.source = OverlayItem::SourceStale;
+            kept[kept_count++] = item;
+            pending = true;
+        }
+    }
+
+    if (restored_count > 0) {
+        // Restoring the map may have cut into markers that stay, the scale or the crosshair.
+        for (int i = 0; i < kept_count; i++) {
+            for (int j = 0; j < restored_count; j++) {
+                if (kept[i].source != OverlayItem::SourceStale && kept[i].footprint.intersect(restored[j])) {
+                    draw_overlay_item(painter, kept[i]);
+                    break;
+                }
+            }
+        }
+        draw_scale(painter);
+        if (manual_panning_)
+            draw_crosshair();
+    }
+
+    for (auto it = desired.begin(); it != desired_end; ++it) {
+        if (it->placed)
+            continue;
+        if ((budget == 0) || (kept_count == MaxOverlayItems)) {
+            pending = true;
+            break;
+        }
+        draw_overlay_item(painter, *it);
+        kept[kept_count++] = *it;
+        budget--;
+    }
+
+    overlay_drawn = kept;
+    overlay_drawn_count = kept_count;
+    overlay_pending = pending;
+}
+
+void GeoMap::on_frame_sync() {
+    if (overlay_pending)
+        set_dirty();
 }
 
 // Calculate screen position of item, adjusted for zoom factor.
@@ -308,35 +616,45 @@ GeoPoint GeoMap::lat_lon_to_map_pixel(float lat, float lon) {
     return {x, y};
 }
 
-// Draw grid in place of map (when zoom-in level is too high).
-void GeoMap::draw_map_grid() {
+// Draw grid in place of map (when zoom-in level is too high), limited to area.
+void GeoMap::draw_map_grid(const Rect area) {
     const auto r = screen_rect();
 
+    display.fill_rectangle(area, Theme::getInstance()->bg_darkest->background);
+
+    if (map_zoom <= MAP_ZOOM_RESOLUTION_LIMIT)
+        return;
+
     // Grid spacing is just based on zoom at the moment, and centered on screen.
     // TODO: Maybe align with latitude/longitude seconds instead?
     int grid_spacing = map_zoom * 2;
     int x = (r.width() / 2) % grid_spacing;
     int y = (r.height() / 2) % grid_spacing;
 
-    if (map_zoom <= MAP_ZOOM_RESOLUTION_LIMIT)
-        return;
-
-    display.fill_rectangle({{0, r.top()}, {r.width(), r.height()}}, Theme::getInstance()->bg_darkest->background);
-
-    for (uint16_t line = y; line < r.height(); line += grid_spacing) {
-        display.fill_rectangle({{0, r.top() + line}, {r.width(), 1}}, Theme::getInstance()->bg_darker->background);
+    for (int line = y; line < r.height(); line += grid_spacing) {
+        const auto y_line = r.top() + line;
+        if ((y_line >= area.top()) && (y_line < area.bottom()))
+            display.fill_rectangle({{area.left(), y_line}, {area.width(), 1}}, Theme::getInstance()->bg_darker->background);
     }
-    for (uint16_t column = x; column < r.width(); column += grid_spacing) {
-        display.fill_rectangle({{column, r.top()}, {1, r.height()}}, Theme::getInstance()->bg_darker->background);
+    for (int column = x; column < r.width(); column += grid_spacing) {
+        const auto x_column = r.left() + column;
+        if ((x_column >= area.left()) && (x_column < area.right()))
+            display.fill_rectangle({{x_column, area.top()}, {1, area.height()}}, Theme::getInstance()->bg_darker->background);
     }
 }
 
+void GeoMap::draw_crosshair() {
+    const auto r = screen_rect();
+    display.fill_rectangle({r.center() - Point(16, 1) + Point(zoom_pixel_offset, zoom_pixel_offset), {32, 2}}, Color::red());
+    display.fill_rectangle({r.center() - Point(1, 16) + Point(zoom_pixel_offset, zoom_pixel_offset), {2, 32}}, Color::red());
+}
+
 void GeoMap::paint(Painter& painter) {
     const auto r = screen_rect();
     std::array<ui::Color, geomap_rect_width> map_line_buffer;
-    int16_t zoom_seek_x, zoom_seek_y;
+    bool map_redrawn = false;
 
-    // Ony redraw map if it moved by at least 1 pixel or the markers list was updated
+    // Ony redraw map if it moved by at least 1 pixel; marker changes are handled by update_overlay()
     if (map_zoom <= 1) {
         // Zooming out, or no zoom
         const int min_diff = abs(map_zoom);
@@ -361,19 +679,21 @@ void GeoMap::paint(Painter& painter) {
         // When zooming in the map should technically by shifted left & up by another map_zoom/2 pixels but
         // the map_read_line() function doesn't handle that yet so we're adjusting markers instead (see zoom_pixel_offset).
         if (map_zoom > 1) {
-            zoom_seek_x = x_pos - (float)r.width() / (2 * map_zoom);
-            zoom_seek_y = y_pos - (float)r.height() / (2 * map_zoom);
+            map_seek_x = x_pos - (float)r.width() / (2 * map_zoom);
+            map_seek_y = y_pos - (float)r.height() / (2 * map_zoom);
         } else {
-            zoom_seek_x = x_pos - (r.width() * abs(map_zoom)) / 2;
-            zoom_seek_y = y_pos - (r.height() * abs(map_zoom)) / 2;
+            map_seek_x = x_pos - (r.width() * abs(map_zoom)) / 2;
+            map_seek_y = y_pos - (r.height() * abs(map_zoom)) / 2;
         }
 
-        if (map_visible) {
+        if (map_visible && map_tiled) {
+            draw_map_tiles(r, map_seek_x, map_seek_y);
+        } else if (map_visible) {
             // Read from map file and display to zoomed scale
             int duplicate_lines = (map_zoom < 0) ? 1 : map_zoom;
             for (uint16_t line = 0; line < (r.height() / duplicate_lines); line++) {
-                uint16_t seek_line = zoom_seek_y + ((map_zoom >= 0) ? line : line * (-map_zoom));
-                map_file.seek(4 + ((zoom_seek_x + (map_width * seek_line)) << 1));
+                uint16_t seek_line = map_seek_y + ((map_zoom >= 0) ? line : line * (-map_zoom));
+                map_file.seek(4 + ((map_seek_x + (map_width * seek_line)) << 1));
                 map_read_line(map_line_buffer.data(), r.width());
 
                 for (uint16_t j = 0; j < duplicate_lines; j++) {
@@ -382,26 +702,22 @@ void GeoMap::paint(Painter& painter) {
             }
         } else {
             // No map data or excessive zoom; just draw a grid
-            draw_map_grid();
+            draw_map_grid(r);
         }
 
         // Draw crosshairs in center in manual panning mode
-        if (manual_panning_) {
-            display.fill_rectangle({r.center() - Point(16, 1) + Point(zoom_pixel_offset, zoom_pixel_offset), {32, 2}}, Color::red());
-            display.fill_rectangle({r.center() - Point(1, 16) + Point(zoom_pixel_offset, zoom_pixel_offset), {2, 32}}, Color::red());
-        }
+        if (manual_panning_)
+            draw_crosshair();
 
-        // Draw the other markers
-        draw_markers(painter);
         draw_scale(painter);
-        draw_mypos(painter);
+
+        // Everything on screen was overwritten, markers are drawn again below.
+        overlay_drawn_count = 0;
+        map_redrawn = true;
         set_clean();
     }
 
-    // Draw the marker in the center
-    if (!manual_panning_ && !hide_center_marker_) {
-        draw_marker(painter, r.center() + Point(zoom_pixel_offset, zoom_pixel_offset), angle_, tag_, Color::red(), Color::white(), Color::black());
-    }
+    update_overlay(painter, map_redrawn);
 }
 
 bool GeoMap::on_keyboard(KeyboardEvent key) {
@@ -447,15 +763,28 @@ void GeoMap::move(const float lon, const float lat) {
 }
 
 bool GeoMap::init() {
-    auto result = map_file.open(adsb_dir / u"world_map.bin");
-    map_opened = !result.is_valid();
-
-    if (map_opened) {
-        map_file.read(&map_width, 2);
-        map_file.read(&map_height, 2);
+    // Prefer the tiled map with precomputed zoom-out levels, fall back to the raw bitmap.
+    const auto view_width = screen_rect().width();
+    map_tiled = !map_tiles_file.open(adsb_dir / u"world_map.tiles").is_valid() && map_tiles.init(view_width);
+
+    if (map_tiled) {
+        map_opened = true;
+        map_width = map_tiles.width();
+        map_height = map_tiles.height();
+        // Zoomed in, one expanded tile row spans up to the view width.
+        tile_block_size = std::max<int32_t>(map_tiles.tile_size() * map_tiles.tile_size(), view_width);
+        tile_block = std::make_unique<ui::Color[]>(tile_block_size);
     } else {
-        map_width = 32768;
-        map_height = 32768;
+        auto result = map_file.open(adsb_dir / u"world_map.bin");
+        map_opened = !result.is_valid();
+
+        if (map_opened) {
+            map_file.read(&map_width, 2);
+            map_file.read(&map_height, 2);
+        } else {
+            map_width = 32768;
+            map_height = 32768;
+        }
     }
 
     map_visible = map_opened;
@@ -473,10 +802,16 @@ bool GeoMap::init() {
 }
 
 void GeoMap::set_mode(GeoMapMode mode) {
+    // Marker symbols change shape, erase the old ones with the map.
+    if (mode != mode_)
+        redraw_map = true;
     mode_ = mode;
 }
 
 void GeoMap::set_manual_panning(bool v) {
+    // Crosshair only goes away with a full map redraw.
+    if (v != manual_panning_)
+        redraw_map = true;
     manual_panning_ = v;
 }
 
@@ -560,11 +895,6 @@ void GeoMap::draw_marker(Painter& painter, const ui::Point itemPoint, const uint
     }
 }
 
-void GeoMap::draw_mypos(Painter& painter) {
-    if ((my_pos.lat < INVALID_LAT_LON) && (my_pos.lon < INVALID_LAT_LON))
-        draw_marker_item(painter, my_pos, Color::yellow());
-}
-
 void GeoMap::clear_markers() {
     markerListLen = 0;
 }
@@ -585,7 +915,7 @@ MapMarkerStored GeoMap::store_marker(GeoMarker& marker) {
     } else if (markerListLen < NumMarkerListElements) {
         markerList[markerListLen] = marker;
         markerListLen++;
-        redraw_map = true;
+        set_dirty();
         ret = MARKER_STORED;
     } else {
         ret = MARKER_LIST_FULL;
@@ -597,16 +927,13 @@ void GeoMap::update_my_position(float lat, float lon, int32_t altitude) {
     my_pos.lat = lat;
     my_pos.lon = lon;
     my_altitude = altitude;
-    redraw_map = true;
     set_dirty();
 }
 
 void GeoMap::update_my_orientation(uint16_t angle, bool refresh) {
     my_pos.angle = angle;
-    if (refresh) {
-        redraw_map = true;
+    if (refresh)
         set_dirty();
-    }
 }
 
 void GeoMapView::focus() {
@@ -26,6 +26,7 @@
 
 #include "ui.hpp"
 #include "file.hpp"
+#include "geomap_tiles.hpp"
 #include "ui_navigation.hpp"
 
 #include "portapack.hpp"
@@ -217,6 +218,9 @@ class GeoMap : public Widget {
     }
 
     void set_angle(uint16_t new_angle) {
+        // Switching between bearing and cross symbols changes every marker.
+        if ((new_angle < 360) != (angle_ < 360))
+            redraw_map = true;
         angle_ = new_angle;
     }
 
@@ -228,34 +232,68 @@ class GeoMap : public Widget {
     bool hide_center_marker() { return hide_center_marker_; }
 
     static const int NumMarkerListElements = 30;
+    static const int MaxMarkerUpdatesPerPaint = 8;  // Marker erase/draw operations per paint, the rest waits for the next one
+    static const int MarkerDrawsPerPaint = 4;       // Part of the above kept for draws, so erases can't starve them
 
     void clear_markers();
     MapMarkerStored store_marker(GeoMarker& marker);
 
+    // Called by the owning view on DisplayFrameSync, repaints while marker updates are pending.
+    void on_frame_sync();
+
     static const Dim banner_height = GEOMAP_BANNER_HEIGHT;
     static const Dim geomap_rect_width = GEOMAP_RECT_WIDTH;
     static const Dim geomap_rect_height = GEOMAP_RECT_HEIGHT;
 
    private:
+    // A marker as drawn on the LCD; footprint covers the symbol and its tag.
+    struct OverlayItem {
+        static const int8_t SourceMyPos = -1;
+        static const int8_t SourceCenter = -2;
+        static const int8_t SourceStale = -3;
+
+        Rect footprint{};
+        Point point{};
+        uint32_t tag_hash{0};
+        uint16_t angle{0};
+        int8_t source{SourceStale};  // Index in markerList or one of the above.
+        bool placed{false};
+
+        bool same_as(const OverlayItem& other) const;
+    };
+    static const int MaxOverlayItems = NumMarkerListElements + 2;
+    using OverlayItems = std::array<OverlayItem, MaxOverlayItems>;
+
     void draw_scale(Painter& painter);
     ui::Point item_rect_pixel(GeoMarker& item);
     GeoPoint lat_lon_to_map_pixel(float lat, float lon);
-    void draw_marker_item(Painter& painter, GeoMarker& item, const Color color, const Color fontColor = Color::white(), const Color backColor = Color::black());
     void draw_marker(Painter& painter, const ui::Point itemPoint, const uint16_t itemAngle, const std::string itemTag, const Color color = Color::red(), const Color fontColor = Color::white(), const Color backColor = Color::black());
-    void draw_markers(Painter& painter);
-    void draw_mypos(Painter& painter);
     void draw_bearing(const Point origin, const uint16_t angle, uint32_t size, const Color color);
-    void draw_map_grid();
+    void draw_map_grid(const Rect area);
     void map_read_line(ui::Color* buffer, uint16_t pixels);
+    void draw_map_tiles(const Rect r, int32_t seek_x, int32_t seek_y);
+    void draw_map_rect(const Rect clip);
+    void fetch_map_pixels(int32_t map_x, int32_t map_y, int32_t step, ui::Color* buffer, int32_t count);
+    void draw_crosshair();
+    Rect marker_footprint(const ui::Point itemPoint, const std::string& itemTag);
+    int collect_overlay_items(OverlayItems& items);
+    void draw_overlay_item(Painter& painter, const OverlayItem& item);
+    void update_overlay(Painter& painter, bool map_redrawn);
 
     bool manual_panning_{false};
     bool hide_center_marker_{false};
     GeoMapMode mode_{};
     File map_file{};
+    File map_tiles_file{};
+    geomap::TiledMap<File> map_tiles{map_tiles_file};
+    std::unique_ptr<ui::Color[]> tile_block{};
+    int32_t tile_block_size{};
+    bool map_tiled{};
     bool map_opened{};
     bool map_visible{};
     uint16_t map_width{}, map_height{};
     int32_t map_center_x{}, map_center_y{};
+    int32_t map_seek_x{}, map_seek_y{};  // Map file pixel at the top left of the screen rect
     int16_t map_zoom{1};
     float lon_ratio{}, lat_ratio{};
     double map_bottom{};
@@ -278,6 +316,10 @@ class GeoMap : public Widget {
     int markerListLen{0};
     GeoMarker markerList[NumMarkerListElements];
     bool redraw_map{false};
+
+    OverlayItems overlay_drawn{};
+    int overlay_drawn_count{0};
+    bool overlay_pending{false};  // Marker updates left over for the next paint.
 };
 
 class GeoMapView : public View {
@@ -346,6 +388,12 @@ class GeoMapView : public View {
     Button button_ok{
         {screen_width - 15 * 8, 0, 15 * 8, 1 * 16},
         "OK"};
+
+    MessageHandlerRegistration message_handler_frame_sync{
+        Message::ID::DisplayFrameSync,
+        [this](const Message* const) {
+            geomap.on_frame_sync();
+        }};
 };
 
 } /* namespace ui */
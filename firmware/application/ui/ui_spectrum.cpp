@@ -88,6 +88,13 @@ void FrequencyScale::set_spectrum_sampling_rate(const int new_sampling_rate) {
     }
 }
 
+void FrequencyScale::set_bins_per_pixel_q8(const uint32_t new_bins_per_pixel_q8) {
+    if (bins_per_pixel_q8 != new_bins_per_pixel_q8) {
+        bins_per_pixel_q8 = new_bins_per_pixel_q8;
+        set_dirty();
+    }
+}
+
 void FrequencyScale::set_channel_filter(
     const int low_frequency,
     const int high_frequency,
@@ -134,14 +141,21 @@ void FrequencyScale::clear_background(Painter& painter, const Rect r) {
     painter.fill_rectangle(r, Theme::getInstance()->bg_darkest->background);
 }
 
+int FrequencyScale::frequency_to_pixels(const int frequency) const {
+    return static_cast<int64_t>(frequency) * spectrum_bins * 256 / (static_cast<int64_t>(spectrum_sampling_rate) * bins_per_pixel_q8);
+}
+
 void FrequencyScale::draw_frequency_ticks(Painter& painter, const Rect r) {
     const auto x_center = r.width() / 2;
 
     const Rect tick{r.left() + x_center, r.top(), 1, r.height()};
     painter.fill_rectangle(tick, Theme::getInstance()->bg_darkest->foreground);
 
+    // Span of the zoomed slice, the full rate at one bin per pixel.
+    const int visible_rate = static_cast<int64_t>(spectrum_sampling_rate) * bins_per_pixel_q8 / 256;
+
     constexpr int tick_count_max = 4;
-    float rough_tick_interval = float(spectrum_sampling_rate) / tick_count_max;
+    float rough_tick_interval = float(visible_rate) / tick_count_max;
     int magnitude = 1;
     int magnitude_n = 0;
     while (rough_tick_interval >= 10.0f) {
@@ -152,8 +166,8 @@ void FrequencyScale::draw_frequency_ticks(Painter& painter, const Rect r) {
     const int tick_interval = std::ceil(rough_tick_interval);
 
     auto tick_offset = tick_interval;
-    while ((tick_offset * magnitude) < spectrum_sampling_rate / 2) {
-        const Dim pixel_offset = tick_offset * magnitude * spectrum_bins / spectrum_sampling_rate;
+    while ((tick_offset * magnitude) < visible_rate / 2) {
+        const Dim pixel_offset = frequency_to_pixels(tick_offset * magnitude);
 
         const std::string zero_pad =
             ((magnitude_n % 3) == 0) ? "" : ((magnitude_n % 3) == 1) ? "0"
@@ -182,11 +196,11 @@ void FrequencyScale::draw_filter_ranges(Painter& painter, const Rect r) {
     if (channel_filter_low_frequency != channel_filter_high_frequency) {
         const auto x_center = r.width() / 2;
 
-        const auto x_low = x_center + channel_filter_low_frequency * spectrum_bins / spectrum_sampling_rate;
-        const auto x_high = x_center + channel_filter_high_frequency * spectrum_bins / spectrum_sampling_rate;
+        const auto x_low = x_center + frequency_to_pixels(channel_filter_low_frequency);
+        const auto x_high = x_center + frequency_to_pixels(channel_filter_high_frequency);
 
         if (channel_filter_transition) {
-            const auto trans = channel_filter_transition * spectrum_bins / spectrum_sampling_rate;
+            const auto trans = frequency_to_pixels(channel_filter_transition);
 
             const Rect r_all{
                 r.left() + x_low - trans, r.bottom() - filter_band_height,
@@ -206,6 +220,9 @@ void FrequencyScale::draw_filter_ranges(Painter& painter, const Rect r) {
 }
 
 void FrequencyScale::on_focus() {
+    if (on_show_options)
+        on_show_options();
+
     _blink = true;
     on_tick_second();
     signal_token_tick_second = rtc_time::signal_tick_second += [this]() {
@@ -233,7 +250,7 @@ bool FrequencyScale::on_encoder(const EncoderEvent delta) {
 bool FrequencyScale::on_key(const KeyEvent key) {
     if (key == KeyEvent::Select) {
         if (on_select) {
-            on_select((cursor_position * spectrum_sampling_rate) / 240);
+            on_select(static_cast<int64_t>(cursor_position) * spectrum_sampling_rate * bins_per_pixel_q8 / (240 * 256));
             cursor_position = 0;
             return true;
         }
@@ -265,29 +282,110 @@ void WaterfallWidget::on_hide() {
     display.scroll_disable();
 }
 
+void WaterfallWidget::set_zoom(const uint8_t zoom) {
+    uint32_t new_bins_per_pixel_q8 = (spectrum_bins << 8) / row_width;
+    if (zoom > 0)
+        new_bins_per_pixel_q8 = 256 / std::min<uint32_t>(zoom, 16);
+    if (new_bins_per_pixel_q8 != bins_per_pixel_q8_) {
+        bins_per_pixel_q8_ = new_bins_per_pixel_q8;
+        levels.fill(0);
+    }
+}
+
+void WaterfallWidget::set_persistence(const Persistence new_persistence, const uint8_t new_decay) {
+    persistence = new_persistence;
+    decay = new_decay;
+    levels.fill(0);
+}
+
+void WaterfallWidget::set_rows_per_spectrum(const size_t rows) {
+    rows_per_spectrum = std::max<size_t>(1, std::min(rows, max_rows));
+}
+
+uint8_t WaterfallWidget::level_at(const ChannelSpectrum& spectrum, const size_t x) const {
+    // Bins counted from the lowest frequency, the spectrum has DC at bin 0.
+    const auto bin = [&spectrum](const int32_t i) {
+        return spectrum.db[(i + spectrum_bins / 2) & (spectrum_bins - 1)];
+    };
+    const int32_t position_q8 = ((spectrum_bins / 2) << 8) + (static_cast<int32_t>(x) - static_cast<int32_t>(row_width / 2)) * static_cast<int32_t>(bins_per_pixel_q8_);
+    const int32_t i = position_q8 >> 8;
+
+    if (bins_per_pixel_q8_ >= 256) {
+        // Max of the bins under the pixel.
+        const int32_t last = std::min<int32_t>((position_q8 + bins_per_pixel_q8_ - 1) >> 8, spectrum_bins - 1);
+        uint8_t level = bin(i);
+        for (int32_t j = i + 1; j <= last; j++)
+            level = std::max(level, bin(j));
+        return level;
+    }
+
+    // Between two bins.
+    const int32_t fraction = position_q8 & 0xff;
+    const int32_t next = std::min<int32_t>(i + 1, spectrum_bins - 1);
+    return (bin(i) * (256 - fraction) + bin(next) * fraction) >> 8;
+}
+
 void WaterfallWidget::on_channel_spectrum(
     const ChannelSpectrum& spectrum) {
-    /* TODO: static_assert that message.spectrum.db.size() >= pixel_row.size() */
-
-    std::array<Color, 240> pixel_row;
-    for (size_t i = 0; i < 120; i++) {
-        const auto pixel_color = spectrum_rgb3_lut[spectrum.db[256 - 120 + i]];
-        pixel_row[i] = pixel_color;
+    if (pending_rows + rows_per_spectrum > max_rows)
+        flush();
+
+    // Rows fill the buffer from the end, so the newest one comes first.
+    Color* const row = &rows[(max_rows - pending_rows - 1) * row_width];
+    for (size_t x = 0; x < row_width; x++) {
+        const auto level = level_at(spectrum, x);
+        auto& shown = levels[x];
+
+        switch (persistence) {
+            case Persistence::Decay:
+                shown = std::max<uint8_t>(level, (shown > decay) ? shown - decay : 0);
+                break;
+            case Persistence::Average:
+                shown = (shown * 3 + level) >> 2;
+                break;
+            case Persistence::PeakHold:
+                shown = std::max(shown, level);
+                break;
+            default:
+                shown = level;
+                break;
+        }
+        row[x] = spectrum_rgb3_lut[shown];
     }
+    pending_rows++;
 
-    for (size_t i = 120; i < 240; i++) {
-        const auto pixel_color = spectrum_rgb3_lut[spectrum.db[i - 120]];
-        pixel_row[i] = pixel_color;
+    for (size_t i = 1; i < rows_per_spectrum; i++) {
+        std::copy(row, row + row_width, &rows[(max_rows - pending_rows - 1) * row_width]);
+        pending_rows++;
     }
+}
 
-    const auto draw_y = display.scroll(1);
+void WaterfallWidget::flush() {
+    if (pending_rows == 0)
+        return;
 
+    const auto r = screen_rect();
+    const Color* const first_row = &rows[(max_rows - pending_rows) * row_width];
+    const auto draw_y = display.scroll(pending_rows);
+
+    // New rows wrap around the bottom of the scrolling area.
+    const size_t before_wrap = std::min<size_t>(pending_rows, r.bottom() - draw_y);
     display.draw_pixels(
-        {{0, draw_y}, {pixel_row.size(), 1}},
-        pixel_row);
+        {{0, draw_y}, {row_width, static_cast<int>(before_wrap)}},
+        first_row, row_width * before_wrap);
+    if (before_wrap < pending_rows) {
+        const size_t after_wrap = pending_rows - before_wrap;
+        display.draw_pixels(
+            {{0, r.top()}, {row_width, static_cast<int>(after_wrap)}},
+            first_row + row_width * before_wrap, row_width * after_wrap);
+    }
+
+    pending_rows = 0;
 }
 
 void WaterfallWidget::clear() {
+    pending_rows = 0;
+    levels.fill(0);
     display.fill_rectangle(
         screen_rect(),
         Color::black());
@@ -305,6 +403,9 @@ WaterfallView::WaterfallView(const bool cursor) {
     frequency_scale.on_select = [this](int32_t offset) {
         if (on_select) on_select(offset);
     };
+    frequency_scale.on_show_options = [this]() {
+        if (on_show_options) on_show_options();
+    };
 }
 
 void WaterfallView::on_show() {
@@ -317,7 +418,7 @@ void WaterfallView::on_hide() {
 
 void WaterfallView::start() {
     if (!running_) {
-        baseband::spectrum_streaming_start();
+        baseband::spectrum_streaming_start(fft_size_log2, window, averaging, average_count);
         running_ = true;
     }
 }
@@ -344,6 +445,34 @@ void WaterfallView::show_audio_spectrum_view(const bool show) {
     }
 }
 
+void WaterfallView::set_zoom(const uint8_t zoom) {
+    waterfall_widget.set_zoom(zoom);
+    frequency_scale.set_bins_per_pixel_q8(waterfall_widget.bins_per_pixel_q8());
+}
+
+void WaterfallView::set_persistence(const WaterfallWidget::Persistence persistence, const uint8_t decay) {
+    waterfall_widget.set_persistence(persistence, decay);
+}
+
+void WaterfallView::set_rows_per_spectrum(const size_t rows) {
+    waterfall_widget.set_rows_per_spectrum(rows);
+}
+
+void WaterfallView::set_spectrum_options(
+    const uint8_t fft_size_log2,
+    const SpectrumStreamingConfigMessage::Averaging averaging,
+    const uint8_t average_count,
+    const SpectrumStreamingConfigMessage::Window window) {
+    this->fft_size_log2 = fft_size_log2;
+    this->averaging = averaging;
+    this->average_count = average_count;
+    this->window = window;
+
+    // A running collector restarts with the new options.
+    if (running_)
+        baseband::spectrum_streaming_start(fft_size_log2, window, averaging, average_count);
+}
+
 void WaterfallView::update_widgets_rect() {
     if (audio_spectrum_view) {
         frequency_scale.set_parent_rect({0, audio_spectrum_height, screen_rect().width(), scale_height});
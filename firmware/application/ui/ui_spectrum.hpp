@@ -29,6 +29,7 @@
 
 #include "message.hpp"
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
 
@@ -70,6 +71,7 @@ class AudioSpectrumView : public View {
 class FrequencyScale : public Widget {
    public:
     std::function<void(int32_t offset)> on_select{};
+    std::function<void(void)> on_show_options{};
 
     void on_show() override;
     void on_focus() override;
@@ -80,6 +82,8 @@ class FrequencyScale : public Widget {
 
     void set_spectrum_sampling_rate(const int new_sampling_rate);
     void set_channel_filter(const int low_frequency, const int high_frequency, const int transition);
+    /* Matches WaterfallWidget::bins_per_pixel_q8(). */
+    void set_bins_per_pixel_q8(const uint32_t bins_per_pixel_q8);
 
     void paint(Painter& painter) override;
 
@@ -93,12 +97,14 @@ class FrequencyScale : public Widget {
     SignalToken signal_token_tick_second{};
     int spectrum_sampling_rate{0};
     const int spectrum_bins = std::tuple_size<decltype(ChannelSpectrum::db)>::value;
+    uint32_t bins_per_pixel_q8{256};
     int channel_filter_low_frequency{0};
     int channel_filter_high_frequency{0};
     int channel_filter_transition{0};
 
     void clear();
     void clear_background(Painter& painter, const Rect r);
+    int frequency_to_pixels(const int frequency) const;
 
     void draw_frequency_ticks(Painter& painter, const Rect r);
     void draw_filter_ranges(Painter& painter, const Rect r);
@@ -110,19 +116,56 @@ class FrequencyScale : public Widget {
 
 class WaterfallWidget : public Widget {
    public:
+    /* How each row blends with the rows before it. */
+    enum class Persistence : uint8_t {
+        None,      // Every row shows its own spectrum.
+        Decay,     // Peaks fall by decay levels per spectrum.
+        Average,   // Running average over about four spectra.
+        PeakHold,  // Highest level since the last clear.
+    };
+
+    /* Rows composed ahead of one LCD write. */
+    static constexpr size_t max_rows = 4;
+
     void on_show() override;
     void on_hide() override;
     void paint(Painter&) override {}
 
+    /* Composes the row(s) of a spectrum, drawn by the next flush(). */
     void on_channel_spectrum(const ChannelSpectrum& spectrum);
+    void flush();
+
+    /* zoom 0 fits all bins into the width (max of the bins under each
+     * pixel), 1 maps bins to pixels, 2 and up interpolate between bins.
+     * The zoomed slice is centered on the tuned frequency. */
+    void set_zoom(const uint8_t zoom);
+    /* Bins per pixel in Q8, for the frequency scale. */
+    uint32_t bins_per_pixel_q8() const { return bins_per_pixel_q8_; }
+
+    void set_persistence(const Persistence persistence, const uint8_t decay = 4);
+    void set_rows_per_spectrum(const size_t rows);
 
    private:
+    static constexpr size_t row_width = 240;
+    static constexpr int32_t spectrum_bins = std::tuple_size<decltype(ChannelSpectrum::db)>::value;
+
+    std::array<Color, row_width * max_rows> rows{};
+    std::array<uint8_t, row_width> levels{};
+    size_t pending_rows{0};
+    size_t rows_per_spectrum{1};
+    uint32_t bins_per_pixel_q8_{256};
+    Persistence persistence{Persistence::None};
+    uint8_t decay{4};
+
     void clear();
+    uint8_t level_at(const ChannelSpectrum& spectrum, const size_t x) const;
 };
 
 class WaterfallView : public View {
    public:
     std::function<void(int32_t offset)> on_select{};
+    /* Called when the cursor gets the focus. */
+    std::function<void(void)> on_show_options{};
 
     WaterfallView(const bool cursor = false);
 
@@ -141,6 +184,18 @@ class WaterfallView : public View {
     void set_parent_rect(const Rect new_parent_rect) override;
     void show_audio_spectrum_view(const bool show);
 
+    void set_zoom(const uint8_t zoom);
+    void set_persistence(const WaterfallWidget::Persistence persistence, const uint8_t decay = 4);
+    void set_rows_per_spectrum(const size_t rows);
+
+    /* Channel spectrum computed by the baseband, see SpectrumStreamingConfigMessage.
+     * Applied when streaming starts, or right away while running. */
+    void set_spectrum_options(
+        const uint8_t fft_size_log2,
+        const SpectrumStreamingConfigMessage::Averaging averaging,
+        const uint8_t average_count,
+        const SpectrumStreamingConfigMessage::Window window = SpectrumStreamingConfigMessage::Window::Hamming);
+
    private:
     void update_widgets_rect();
 
@@ -152,6 +207,11 @@ class WaterfallView : public View {
     FrequencyScale frequency_scale{};
     bool running_{false};
 
+    uint8_t fft_size_log2{SpectrumStreamingConfigMessage::fft_size_log2_max};
+    SpectrumStreamingConfigMessage::Window window{SpectrumStreamingConfigMessage::Window::Hamming};
+    SpectrumStreamingConfigMessage::Averaging averaging{SpectrumStreamingConfigMessage::Averaging::None};
+    uint8_t average_count{1};
+
     ChannelSpectrumFIFO* channel_fifo{nullptr};
     AudioSpectrum* audio_spectrum_data{nullptr};
     bool audio_spectrum_update{false};
@@ -184,6 +244,7 @@ class WaterfallView : public View {
                 while (channel_fifo->out(channel_spectrum)) {
                     this->on_channel_spectrum(channel_spectrum);
                 }
+                this->waterfall_widget.flush();
             }
             if (this->audio_spectrum_update) {
                 this->audio_spectrum_update = false;
@@ -3,6 +3,7 @@
 #include "sd_card.hpp"
 #include "file_path.hpp"
 #include "ui_standalone_view.hpp"
+#include "external_app_catalog.hpp"
 
 #include "i2cdevmanager.hpp"
 #include "i2cdev_ppmod.hpp"
@@ -40,19 +41,16 @@ namespace ui {
     if (sd_card::status() != sd_card::Status::Mounted)
         return;
 
+    ExternalAppCatalog catalog{};
+
     for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppma")) {
         auto filePath = apps_dir / entry.path();
-        File app;
 
-        auto openError = app.open(filePath);
-        if (openError)
+        auto app = catalog.lookup(entry, filePath, ExternalAppCatalog::Kind::Ppma);
+        if (!app)
             continue;
 
-        application_information_t application_information = {};
-
-        auto readResult = app.read(&application_information, sizeof(application_information_t));
-        if (!readResult)
-            continue;
+        const auto& application_information = *app;
 
         if (application_information.header_version != CURRENT_HEADER_VERSION)
             continue;
@@ -65,24 +63,19 @@ namespace ui {
                 // Remove the ".ppma" suffix
                 appshortname = appshortname.substr(0, appshortname.size() - 5);
             }
-            AppInfoConsole appInfoConsole = {appshortname.c_str(), reinterpret_cast<char*>(&application_information.app_name[0]), application_information.menu_location};
+            AppInfoConsole appInfoConsole = {appshortname.c_str(), reinterpret_cast<const char*>(&application_information.app_name[0]), application_information.menu_location};
             callback(appInfoConsole);
         }
     }
 
     for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppmp")) {
         auto filePath = apps_dir / entry.path();
-        File app;
 
-        auto openError = app.open(filePath);
-        if (openError)
+        auto app = catalog.lookup(entry, filePath, ExternalAppCatalog::Kind::Ppmp);
+        if (!app)
             continue;
 
-        standalone_application_information_t application_information = {};
-
-        auto readResult = app.read(&application_information, sizeof(standalone_application_information_t));
-        if (!readResult)
-            continue;
+        const auto& application_information = *app;
 
         if (application_information.header_version > CURRENT_STANDALONE_APPLICATION_API_VERSION)
             continue;
@@ -92,7 +85,7 @@ namespace ui {
             // Remove the ".ppmp" suffix
             appshortname = appshortname.substr(0, appshortname.size() - 5);
         }
-        AppInfoConsole appInfoConsole = {appshortname.c_str(), reinterpret_cast<char*>(&application_information.app_name[0]), application_information.menu_location};
+        AppInfoConsole appInfoConsole = {appshortname.c_str(), reinterpret_cast<const char*>(&application_information.app_name[0]), application_information.menu_location};
         callback(appInfoConsole);
     }
 }
@@ -160,19 +153,16 @@ namespace ui {
     if (sd_card::status() != sd_card::Status::Mounted)
         return external_apps;
 
+    ExternalAppCatalog catalog{};
+
     for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppma")) {
         auto filePath = apps_dir / entry.path();
-        File app;
 
-        auto openError = app.open(filePath);
-        if (openError)
+        auto app = catalog.lookup(entry, filePath, ExternalAppCatalog::Kind::Ppma);
+        if (!app)
             continue;
 
-        application_information_t application_information = {};
-
-        auto readResult = app.read(&application_information, sizeof(application_information_t));
-        if (!readResult)
-            continue;
+        const auto& application_information = *app;
 
         if (application_information.menu_location != app_location)
             continue;
@@ -183,7 +173,7 @@ namespace ui {
         bool versionMatches = VERSION_MD5 == application_information.app_version;
 
         GridItemEx gridItem = {};
-        gridItem.text = reinterpret_cast<char*>(&application_information.app_name[0]);
+        gridItem.text = reinterpret_cast<const char*>(&application_information.app_name[0]);
 
         if (versionMatches) {
             gridItem.color = Color((uint16_t)application_information.icon_color);
@@ -216,17 +206,12 @@ namespace ui {
 
     for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppmp")) {
         auto filePath = apps_dir / entry.path();
-        File app;
 
-        auto openError = app.open(filePath);
-        if (openError)
+        auto app = catalog.lookup(entry, filePath, ExternalAppCatalog::Kind::Ppmp);
+        if (!app)
             continue;
 
-        standalone_application_information_t application_information = {};
-
-        auto readResult = app.read(&application_information, sizeof(standalone_application_information_t));
-        if (!readResult)
-            continue;
+        const auto& application_information = *app;
 
         if (application_information.menu_location != app_location)
             continue;
@@ -235,7 +220,7 @@ namespace ui {
             continue;
 
         GridItemEx gridItem = {};
-        gridItem.text = reinterpret_cast<char*>(&application_information.app_name[0]);
+        gridItem.text = reinterpret_cast<const char*>(&application_information.app_name[0]);
 
         gridItem.color = Color((uint16_t)application_information.icon_color);
 
@@ -1183,12 +1183,18 @@ static void cmd_sysinfo(BaseSequentialStream* chp, int argc, char* argv[]) {
 }
 
 static void cmd_radioinfo(BaseSequentialStream* chp, int argc, char* argv[]) {
-    const char* usage = "usage: radioinfo\r\n";
-    (void)argv;
-    if (argc > 0) {
+    const char* usage = "usage: radioinfo [reset]\r\nreset clears the retune timing counters.\r\n";
+    if (argc > 1 || (argc == 1 && strcmp(argv[0], "reset") != 0)) {
         chprintf(chp, usage);
         return;
     }
+    if (argc == 1) {
+        radio::debug::retune::reset_stats();
+        chprintf(chp, "ok\r\n");
+        return;
+    }
+    const auto& retune = radio::debug::retune::stats();
+    const uint32_t retune_avg_us = retune.count ? (uint32_t)(retune.total_us / retune.count) : 0;
     std::string info =
         "receiver_model.target_frequency: " + to_string_dec_uint(portapack::receiver_model.target_frequency()) + "\r\n" +
         "receiver_model.baseband_bandwidth: " + to_string_dec_uint(portapack::receiver_model.baseband_bandwidth()) + "\r\n" +
@@ -1199,12 +1205,91 @@ static void cmd_radioinfo(BaseSequentialStream* chp, int argc, char* argv[]) {
         "receiver_model.wfm_configuration: " + to_string_dec_uint(portapack::receiver_model.wfm_configuration()) + "\r\n" +
         "transmitter_model.target_frequency: " + to_string_dec_uint(portapack::transmitter_model.target_frequency()) + "\r\n" +
         "transmitter_model.baseband_bandwidth: " + to_string_dec_uint(portapack::transmitter_model.baseband_bandwidth()) + "\r\n" +
-        "transmitter_model.sampling_rate: " + to_string_dec_uint(portapack::transmitter_model.sampling_rate()) + "\r\n";
+        "transmitter_model.sampling_rate: " + to_string_dec_uint(portapack::transmitter_model.sampling_rate()) + "\r\n" +
+        "retune.count: " + to_string_dec_uint(retune.count) + "\r\n" +
+        "retune.first_lo_skipped: " + to_string_dec_uint(retune.first_lo_skipped) + "\r\n" +
+        "retune.last_us: " + to_string_dec_uint(retune.last_us) + "\r\n" +
+        "retune.max_us: " + to_string_dec_uint(retune.max_us) + "\r\n" +
+        "retune.avg_us: " + to_string_dec_uint(retune_avg_us) + "\r\n";
 
     fillOBuffer(&((SerialUSBDriver*)chp)->oqueue, (const uint8_t*)info.c_str(), info.length());
     return;
 }
 
+static void cmd_m4profile(BaseSequentialStream* chp, int argc, char* argv[]) {
+    const char* usage = "usage: m4profile [enable|disable]\r\nWithout argument, prints the last per-stage cycle counts.\r\n";
+    if (argc > 1) {
+        chprintf(chp, usage);
+        return;
+    }
+    if (argc == 1) {
+        if (strcmp(argv[0], "enable") == 0) {
+            shared_memory.request_m4_profile = true;
+            chprintf(chp, "ok\r\n");
+        } else if (strcmp(argv[0], "disable") == 0) {
+            shared_memory.request_m4_profile = false;
+            shared_memory.m4_profile.sequence = 0;
+            chprintf(chp, "ok\r\n");
+        } else {
+            chprintf(chp, usage);
+        }
+        return;
+    }
+
+    const auto& loads = m4_load::stats();
+    chprintf(chp, "image loads: %u, kept resident: %u, recent: %u, last: %u us, max: %u us, last compressed: %u bytes\r\n",
+             loads.count, loads.resident_hits, loads.recent_hits, loads.last_us, loads.max_us, loads.last_compressed_size);
+
+    baseband::profile::Snapshot snapshot;
+    if (!baseband::profile::read(shared_memory.m4_profile, snapshot)) {
+        chprintf(chp, "no data%s\r\n", shared_memory.request_m4_profile ? "" : ", run m4profile enable");
+        return;
+    }
+
+    chprintf(chp, "rate: %u Hz, budget: %u cycles/buffer, buffers: %u\r\n", snapshot.sampling_rate, snapshot.budget, snapshot.buffers);
+    chprintf(chp, "stage      avg%%  peak%%  avg_cycles peak_cycles\r\n");
+    for (size_t i = 0; i < baseband::profile::stage_count; i++) {
+        chprintf(chp, "%-9s %4u%% %5u%% %11u %11u\r\n",
+                 baseband::profile::stage_name(i),
+                 snapshot.percent(snapshot.average[i]),
+                 snapshot.percent(snapshot.peak[i]),
+                 snapshot.average[i],
+                 snapshot.peak[i]);
+    }
+    chprintf(chp, "%-9s %4u%% %5u%% %11u %11u\r\n",
+             "total",
+             snapshot.percent(snapshot.total_average),
+             snapshot.percent(snapshot.total_peak),
+             snapshot.total_average,
+             snapshot.total_peak);
+}
+
+static void print_queue_stats(BaseSequentialStream* chp, const char* name, const MessageQueue& queue, const size_t size) {
+    const auto& stats = queue.stats();
+    const uint32_t frequency_mhz = halGetCounterFrequency() / 1000000;
+    const uint32_t dispatch_avg = stats.dispatched ? (uint32_t)(stats.dispatch_total / stats.dispatched) : 0;
+    chprintf(chp, "%s: pushed: %u, dropped: %u, high water: %u/%u bytes, dispatched: %u, max: %u us, avg: %u us\r\n",
+             name, stats.pushed, stats.dropped, stats.high_water, size, stats.dispatched,
+             stats.dispatch_max / frequency_mhz, dispatch_avg / frequency_mhz);
+}
+
+static void cmd_msgqueue(BaseSequentialStream* chp, int argc, char* argv[]) {
+    const char* usage = "usage: msgqueue [reset]\r\nreset clears the message queue counters.\r\n";
+    if (argc > 1 || (argc == 1 && strcmp(argv[0], "reset") != 0)) {
+        chprintf(chp, usage);
+        return;
+    }
+    if (argc == 1) {
+        shared_memory.application_queue.reset_stats();
+        shared_memory.app_local_queue.reset_stats();
+        chprintf(chp, "ok\r\n");
+        return;
+    }
+    // Both queues are dispatched on the M0, the M4 pushes into the application queue.
+    print_queue_stats(chp, "application", shared_memory.application_queue, 1 << SharedMemory::application_queue_k);
+    print_queue_stats(chp, "app_local", shared_memory.app_local_queue, 1 << SharedMemory::app_local_queue_k);
+}
+
 static void cmd_pmemreset(BaseSequentialStream* chp, int argc, char* argv[]) {
     const char* usage = "usage: pmemreset yes\r\nThis will reset pmem to defaults!\r\n";
     (void)argv;
@@ -1399,6 +1484,8 @@ static const ShellCommand commands[] = {
     {"gotlight", cmd_gotlight},
     {"sysinfo", cmd_sysinfo},
     {"radioinfo", cmd_radioinfo},
+    {"m4profile", cmd_m4profile},
+    {"msgqueue", cmd_msgqueue},
     {"pmemreset", cmd_pmemreset},
     {"settingsreset", cmd_settingsreset},
     {"sendpocsag", cmd_sendpocsag},
@@ -40,6 +40,8 @@ void AudioOutput::configure(const bool do_proc) {
 void AudioOutput::configure(const iir_biquad_config_t& hpf_config, const iir_biquad_config_t& deemph_config, const float squelch_threshold) {
     hpf.configure(hpf_config);
     deemph.configure(deemph_config);
+    hpf_q15.configure(hpf_config);
+    deemph_q15.configure(deemph_config);
     squelch.set_threshold(squelch_threshold);
 }
 
@@ -53,11 +55,11 @@ void AudioOutput::write_unprocessed(const buffer_s16_t& audio) {
 }
 
 void AudioOutput::write(const buffer_s16_t& audio) {
-    std::array<float, 32> audio_f;
-    for (size_t i = 0; i < audio.count; i++) {
-        audio_f[i] = audio.p[i] * ki;
-    }
-    write(buffer_f32_t{audio_f.data(), audio.count, audio.sampling_rate});
+    block_buffer_s16.feed(
+        audio,
+        [this](const buffer_s16_t& buffer) {
+            this->on_block(buffer);
+        });
 }
 
 void AudioOutput::write(const buffer_f32_t& audio) {
@@ -75,8 +77,27 @@ void AudioOutput::on_block(const buffer_f32_t& audio) {
         hpf.execute_in_place(audio);
         deemph.execute_in_place(audio);
 
-        audio_present_history = (audio_present_history << 1) | (audio_present_now ? 1 : 0);
-        audio_present = (audio_present_history != 0);
+        update_audio_present(audio_present_now);
+
+        if (!audio_present) {
+            for (size_t i = 0; i < audio.count; i++) {
+                audio.p[i] = 0;
+            }
+        }
+    } else
+        audio_present = true;
+
+    fill_audio_buffer(audio, audio_present);
+}
+
+void AudioOutput::on_block(const buffer_s16_t& audio) {
+    if (do_processing) {
+        const auto audio_present_now = squelch.execute(audio);
+
+        hpf_q15.execute_in_place(audio);
+        deemph_q15.execute_in_place(audio);
+
+        update_audio_present(audio_present_now);
 
         if (!audio_present) {
             for (size_t i = 0; i < audio.count; i++) {
@@ -89,6 +110,11 @@ void AudioOutput::on_block(const buffer_f32_t& audio) {
     fill_audio_buffer(audio, audio_present);
 }
 
+void AudioOutput::update_audio_present(const bool audio_present_now) {
+    audio_present_history = (audio_present_history << 1) | (audio_present_now ? 1 : 0);
+    audio_present = (audio_present_history != 0);
+}
+
 bool AudioOutput::is_squelched() {
     return !audio_present;
 }
@@ -46,6 +46,9 @@ class AudioOutput {
         const float squelch_threshold = 0.0f);
 
     void write_unprocessed(const buffer_s16_t& audio);
+
+    /* Q15 audio stays fixed-point through squelch, filters and output.
+     * Only the FM processors use it, AM and SSB still write float. */
     void write(const buffer_s16_t& audio);
     void write(const buffer_f32_t& audio);
 
@@ -57,13 +60,15 @@ class AudioOutput {
 
    private:
     static constexpr float k = 32768.0f;
-    static constexpr float ki = 1.0f / k;
 
+    // Shared by write_unprocessed() and write(buffer_s16_t), a processor uses one of them.
     BlockDecimator<int16_t, 32> block_buffer_s16{1};
     BlockDecimator<float, 32> block_buffer{1};
 
     IIRBiquadFilter hpf{};
     IIRBiquadFilter deemph{};
+    IIRBiquadFilterQ15 hpf_q15{};
+    IIRBiquadFilterQ15 deemph_q15{};
     FMSquelch squelch{};
 
     std::unique_ptr<StreamInput> stream{};
@@ -76,6 +81,8 @@ class AudioOutput {
     bool do_processing = true;
 
     void on_block(const buffer_f32_t& audio);
+    void on_block(const buffer_s16_t& audio);
+    void update_audio_present(const bool audio_present_now);
 
     void fill_audio_buffer(const buffer_s16_t& audio, const bool send_to_fifo);
     void fill_audio_buffer(const buffer_f32_t& audio, const bool send_to_fifo);
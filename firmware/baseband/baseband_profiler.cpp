@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "baseband_profiler.hpp"
+
+#include "portapack_shared_memory.hpp"
+#include "hackrf_hal.hpp"
+
+#include <hal.h>
+
+#include <algorithm>
+
+namespace baseband {
+namespace profile {
+
+namespace {
+
+bool active{false};
+uint32_t last_mark{0};
+uint32_t buffer_start{0};
+
+std::array<uint32_t, stage_count> buffer_cycles{};
+std::array<uint32_t, stage_count> sum{};
+std::array<uint32_t, stage_count> peak{};
+uint32_t total_sum{0};
+uint32_t total_peak{0};
+uint32_t buffers{0};
+uint32_t samples_seen{0};
+
+void reset() {
+    sum.fill(0);
+    peak.fill(0);
+    total_sum = 0;
+    total_peak = 0;
+    buffers = 0;
+    samples_seen = 0;
+}
+
+void publish(const uint32_t sampling_rate, const uint32_t budget) {
+    auto& snapshot = shared_memory.m4_profile;
+
+    snapshot.sequence++;
+    __sync_synchronize();
+
+    snapshot.sampling_rate = sampling_rate;
+    snapshot.buffers = buffers;
+    snapshot.budget = budget;
+    snapshot.total_average = total_sum / buffers;
+    snapshot.total_peak = total_peak;
+    for (size_t i = 0; i < stage_count; i++) {
+        snapshot.average[i] = sum[i] / buffers;
+        snapshot.peak[i] = peak[i];
+    }
+
+    __sync_synchronize();
+    snapshot.sequence++;
+}
+
+}  // namespace
+
+void begin() {
+    const bool requested = shared_memory.request_m4_profile;
+    if (requested != active) {
+        // Start from scratch on enable, the sums may be from an earlier run.
+        // On disable, mark the snapshot stale so it isn't shown as live.
+        if (requested)
+            reset();
+        else
+            shared_memory.m4_profile.sequence = 0;
+        active = requested;
+    }
+    if (!active) {
+        return;
+    }
+
+    // The HAL runs the DWT cycle counter as its system counter, never write it.
+    buffer_cycles.fill(0);
+    buffer_start = last_mark = DWT->CYCCNT;
+}
+
+void mark(const Stage stage) {
+    if (!active) {
+        return;
+    }
+
+    const uint32_t now = DWT->CYCCNT;
+    buffer_cycles[static_cast<size_t>(stage)] += now - last_mark;
+    last_mark = now;
+}
+
+void end(const size_t samples, const uint32_t sampling_rate) {
+    if (!active) {
+        return;
+    }
+
+    const uint32_t now = DWT->CYCCNT;
+    const uint32_t total = now - buffer_start;
+    buffer_cycles[static_cast<size_t>(Stage::Other)] += now - last_mark;
+
+    for (size_t i = 0; i < stage_count; i++) {
+        sum[i] += buffer_cycles[i];
+        peak[i] = std::max(peak[i], buffer_cycles[i]);
+    }
+    total_sum += total;
+    total_peak = std::max(total_peak, total);
+    buffers++;
+    samples_seen += samples;
+
+    // Publish twice a second, sums can't overflow in that time at 200 MHz.
+    if ((sampling_rate > 0) && (samples_seen >= sampling_rate / 2)) {
+        const uint32_t budget = static_cast<uint64_t>(hackrf::one::base_m4_clk_f) * samples / sampling_rate;
+        publish(sampling_rate, budget);
+        reset();
+    }
+}
+
+} /* namespace profile */
+} /* namespace baseband */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __BASEBAND_PROFILER_H__
+#define __BASEBAND_PROFILER_H__
+
+#include "baseband_profile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+/* Per-stage DWT cycle accounting for the baseband thread.
+ *
+ * BasebandThread calls begin() before and end() after each execute().
+ * Processors call mark() right after a stage to charge it with the cycles
+ * spent since the previous mark, e.g.
+ *
+ *     const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+ *     baseband::profile::mark(baseband::profile::Stage::Decim0);
+ *
+ * Interrupts taken during a stage are charged to it too. All of this is
+ * a flag check unless the M0 sets shared_memory.request_m4_profile.
+ */
+namespace baseband {
+namespace profile {
+
+void begin();
+void mark(const Stage stage);
+void end(const size_t samples, const uint32_t sampling_rate);
+
+} /* namespace profile */
+} /* namespace baseband */
+
+#endif /*__BASEBAND_PROFILER_H__*/
@@ -26,6 +26,7 @@
 #include "baseband.hpp"
 #include "baseband_sgpio.hpp"
 #include "baseband_dma.hpp"
+#include "baseband_profiler.hpp"
 
 #include "rssi.hpp"
 #include "i2s.hpp"
@@ -110,7 +111,9 @@ void BasebandThread::run() {
             }
 
             if (baseband_processor_) {
+                baseband::profile::begin();
                 baseband_processor_->execute(buffer);
+                baseband::profile::end(buffer.count, sampling_rate_);
             }
         }
     }
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BTLE_ACCESS_ADDRESS_H__
+#define __BTLE_ACCESS_ADDRESS_H__
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/* Finds a BLE access address in the demodulated bits. Each sample phase keeps
+ * its last 32 bits in a shift register, compared with the address by XOR and
+ * popcount so that a few bit errors on weak packets can be tolerated. */
+template <size_t Phases>
+class AccessAddressCorrelator {
+   public:
+    static constexpr size_t address_bits = 32;
+    static constexpr int max_tolerance = 4;
+
+    constexpr AccessAddressCorrelator(const uint32_t access_address)
+        : access_address{access_address} {}
+
+    /* Bit errors accepted in a match, at most max_tolerance. */
+    void set_tolerance(const int value) {
+        tolerance = std::clamp(value, 0, max_tolerance);
+    }
+
+    void reset() {
+        shift.fill(0);
+        bit_count.fill(0);
+    }
+
+    /* Shifts in the next bit of phase. True when the last 32 bits of that
+     * phase are the access address within the tolerance. */
+    bool execute(const size_t phase, const uint32_t bit) {
+        // New bits enter at the top so the oldest ends up in bit 0, matching
+        // the LSB-first order of the access address.
+        shift[phase] = (shift[phase] >> 1) | (bit << 31);
+
+        if ((bit_count[phase] < address_bits) && (++bit_count[phase] < address_bits))
+            return false;
+
+        return __builtin_popcount(shift[phase] ^ access_address) <= tolerance;
+    }
+
+   private:
+    const uint32_t access_address;
+    int tolerance{0};
+    std::array<uint32_t, Phases> shift{};
+    std::array<uint8_t, Phases> bit_count{};
+};
+
+#endif /*__BTLE_ACCESS_ADDRESS_H__*/
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "channel_monitor.hpp"
+
+#include "dsp_spectrum_power.hpp"
+#include "utility.hpp"
+
+#include <algorithm>
+
+void ChannelMonitor::configure(const ChannelMonitorConfigMessage& message, const size_t sampling_rate) {
+    const int32_t bin_width = sampling_rate / fft_size;
+    const int32_t half_bandwidth = std::min<uint32_t>(message.bandwidth, sampling_rate / 2) / 2;
+
+    channel_count = std::min<size_t>(message.channel_count, max_channels);
+    for (size_t c = 0; c < channel_count; c++) {
+        const int32_t offset = message.offsets[c];
+        if ((offset < -ChannelMonitorConfigMessage::max_offset) || (offset > ChannelMonitorConfigMessage::max_offset)) {
+            spans[c] = {0, 0};
+            continue;
+        }
+
+        // Bins whose center falls inside the channel, else the nearest one.
+        // Shifted by a whole FFT so the divisions round down.
+        const int32_t shift = bin_width * fft_size;
+        int32_t first = (offset - half_bandwidth + bin_width - 1 + shift) / bin_width - fft_size;
+        const int32_t last = (offset + half_bandwidth + shift) / bin_width - fft_size;
+        int32_t count = last - first + 1;
+        if (count < 1) {
+            first = (offset + bin_width / 2 + shift) / bin_width - fft_size;
+            count = 1;
+        }
+        spans[c] = {
+            static_cast<uint16_t>(first & (fft_size - 1)),
+            static_cast<uint16_t>(std::min<int32_t>(count, fft_size))};
+    }
+
+    accumulator.fill(0);
+    squelch_db = message.squelch_db;
+    sequence = message.sequence;
+    buffer_count = 0;
+    frame_count = 0;
+    settle_frames = settle_frame_count;
+}
+
+void ChannelMonitor::accumulate(const std::complex<float>* const bins) {
+    constexpr size_t mask = fft_size - 1;
+    // A full scale tone sums to fft_size * 32768 in its bin, bring it back to Q15.
+    constexpr float scale = 1.0f / fft_size;
+
+    for (size_t c = 0; c < channel_count; c++) {
+        const auto& span = spans[c];
+        uint32_t power = 0;
+        for (size_t i = 0; i < span.count; i++) {
+            power += dsp::spectrum::window_mag2(bins, (span.first + i) & mask, mask, scale, dsp::spectrum::window_hamming);
+            power = std::min(power, dsp::spectrum::power_full_scale);
+        }
+        // At most frames_per_report full scale frames, no overflow.
+        accumulator[c] += power;
+    }
+}
+
+void ChannelMonitor::report(ChannelMonitorMessage& message) const {
+    message.channel_count = channel_count;
+    message.sequence = sequence;
+
+    for (size_t c = 0; c < channel_count; c++) {
+        int32_t db = -120;
+        if ((spans[c].count > 0) && (accumulator[c] >= frame_count)) {
+            const float power = static_cast<float>(accumulator[c] / frame_count) * (1.0f / dsp::spectrum::power_full_scale);
+            db = std::max<int32_t>(mag2_to_dbv_norm(power), -120);
+        }
+        message.db[c] = db;
+        if (db > squelch_db)
+            message.active |= 1U << c;
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __CHANNEL_MONITOR_H__
+#define __CHANNEL_MONITOR_H__
+
+#include "dsp_fft.hpp"
+#include "dsp_types.hpp"
+#include "message.hpp"
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+/* Power of many narrow channels inside the tuning window, from one FFT of
+ * the first decimation stage output, so a scanner only retunes between
+ * windows. One frame is analysed every buffers_per_frame buffers and a
+ * ChannelMonitorMessage is reported every frames_per_report frames. */
+class ChannelMonitor {
+   public:
+    static constexpr size_t fft_size_log2 = 8;
+    static constexpr size_t fft_size = 1 << fft_size_log2;
+    static constexpr size_t buffers_per_frame = 4;
+    static constexpr size_t frames_per_report = 32;
+
+    void configure(const ChannelMonitorConfigMessage& message, const size_t sampling_rate);
+
+    bool is_enabled() const { return channel_count > 0; }
+
+    /* src must hold at least fft_size samples at the configured rate. */
+    template <typename Callback>
+    void feed(const buffer_c16_t& src, Callback callback) {
+        if ((channel_count == 0) || (src.count < fft_size))
+            return;
+
+        if (++buffer_count < buffers_per_frame)
+            return;
+        buffer_count = 0;
+
+        fft_swap(src, frame);
+        fft_c_preswapped(frame, 0, fft_size_log2);
+        feed_spectrum(frame.data(), callback);
+    }
+
+    /* Spectrum of one frame, fft_size bins in FFT order. */
+    template <typename Callback>
+    void feed_spectrum(const std::complex<float>* const bins, Callback callback) {
+        // The first frames may still see the synthesizer settling.
+        if (settle_frames > 0) {
+            settle_frames--;
+            return;
+        }
+
+        accumulate(bins);
+
+        if (++frame_count >= frames_per_report) {
+            ChannelMonitorMessage message{};
+            report(message);
+            callback(message);
+            accumulator.fill(0);
+            frame_count = 0;
+        }
+    }
+
+   private:
+    static constexpr size_t max_channels = ChannelMonitorConfigMessage::max_channels;
+    static constexpr size_t settle_frame_count = 2;
+
+    /* FFT bins of a channel, first wraps around to negative frequencies. */
+    struct Span {
+        uint16_t first;
+        uint16_t count;
+    };
+
+    std::array<std::complex<float>, fft_size> frame{};
+    std::array<Span, max_channels> spans{};
+    std::array<uint32_t, max_channels> accumulator{};
+    size_t channel_count{0};
+    size_t buffer_count{0};
+    size_t frame_count{0};
+    size_t settle_frames{0};
+    int32_t squelch_db{0};
+    uint8_t sequence{0};
+
+    void accumulate(const std::complex<float>* const bins);
+    void report(ChannelMonitorMessage& message) const;
+};
+
+#endif /*__CHANNEL_MONITOR_H__*/
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __DSP_CHANNELIZER_H__
+#define __DSP_CHANNELIZER_H__
+
+#include "dsp_types.hpp"
+#include "complex.hpp"
+#include "sine_table.hpp"
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+namespace dsp {
+namespace channelizer {
+
+/* Extracts Channels narrow channels from one complex stream in a single
+ * pass. Each channel is the shared real prototype filter shifted to the
+ * channel frequency. Only every decimation_factor'th output is computed
+ * (polyphase decimation), then rotated down to DC. Channel frequencies
+ * need not be on a uniform grid. */
+template <size_t Channels>
+class PolyphaseChannelizer {
+   public:
+    static constexpr size_t taps_count = 32;
+    static constexpr size_t decimation_factor = 8;
+
+    using tap_t = int16_t;
+
+    /* Prototype taps are Q15, frequencies are offsets from the center of
+     * the input stream. */
+    void configure(
+        const std::array<tap_t, taps_count>& taps,
+        const std::array<int32_t, Channels>& frequencies,
+        const uint32_t sampling_rate) {
+        for (size_t c = 0; c < Channels; c++) {
+            const float w = 2 * pi * frequencies[c] / sampling_rate;
+
+            // History runs from the oldest sample (k = 0) to the newest.
+            for (size_t k = 0; k < taps_count; k++) {
+                const size_t age = taps_count - 1 - k;
+                const float phase = w * age;
+                taps_[c][k] = {
+                    static_cast<int16_t>(taps[age] * sin_f32(phase + pi / 2)),
+                    static_cast<int16_t>(taps[age] * sin_f32(phase))};
+            }
+
+            const float step = -w * decimation_factor;
+            step_[c] = {sin_f32(step + pi / 2), sin_f32(step)};
+            rotation_[c] = {1.0f, 0.0f};
+        }
+
+        z_.fill({});
+        z_index_ = 0;
+        phase_ = 0;
+    }
+
+    /* Writes src.count / decimation_factor samples to each dst, at
+     * src.sampling_rate / decimation_factor. Returns the count. */
+    size_t execute(
+        const buffer_c16_t& src,
+        const std::array<complex16_t*, Channels>& dst) {
+        size_t count = 0;
+
+        for (size_t i = 0; i < src.count; i++) {
+            // Each sample is stored twice, so the history is always contiguous.
+            z_[z_index_] = src.p[i];
+            z_[z_index_ + taps_count] = src.p[i];
+            z_index_ = (z_index_ + 1 == taps_count) ? 0 : z_index_ + 1;
+
+            if (++phase_ < decimation_factor)
+                continue;
+            phase_ = 0;
+
+            const complex16_t* const z = &z_[z_index_];
+            for (size_t c = 0; c < Channels; c++) {
+                const auto& t = taps_[c];
+
+                // Q15 taps, sum of |taps| below 2^16: stays within 32 bits.
+                int32_t re = 0;
+                int32_t im = 0;
+                for (size_t k = 0; k < taps_count; k++) {
+                    re += t[k].real() * z[k].real() - t[k].imag() * z[k].imag();
+                    im += t[k].real() * z[k].imag() + t[k].imag() * z[k].real();
+                }
+
+                const auto y = std::complex<float>{static_cast<float>(re), static_cast<float>(im)} * rotation_[c];
+                rotation_[c] *= step_[c];
+                dst[c][count] = {saturate(y.real()), saturate(y.imag())};
+            }
+            count++;
+        }
+
+        // Keep the rotators on the unit circle.
+        for (auto& r : rotation_)
+            r *= 1.5f - 0.5f * std::norm(r);
+
+        return count;
+    }
+
+   private:
+    std::array<std::array<complex16_t, taps_count>, Channels> taps_{};
+    std::array<std::complex<float>, Channels> rotation_{};
+    std::array<std::complex<float>, Channels> step_{};
+    std::array<complex16_t, taps_count * 2> z_{};
+    size_t z_index_{0};
+    size_t phase_{0};
+
+    static int16_t saturate(const float q15_sum) {
+        const float v = q15_sum * (1.0f / 32768.0f);
+        return (v >= 32767.0f) ? 32767 : ((v <= -32768.0f) ? -32768 : static_cast<int16_t>(v));
+    }
+};
+
+} /* namespace channelizer */
+} /* namespace dsp */
+
+#endif /*__DSP_CHANNELIZER_H__*/
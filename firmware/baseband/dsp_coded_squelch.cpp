@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "dsp_coded_squelch.hpp"
+
+#include "dcs.hpp"
+#include "sine_table.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dsp {
+
+const std::array<uint16_t, CTCSSDetector::tone_count> CTCSSDetector::tones_x100{
+    6700, 6930, 7190, 7440, 7700, 7970, 8250, 8540, 8850, 9150,
+    9480, 9740, 10000, 10350, 10720, 11090, 11480, 11880, 12300, 12730,
+    13180, 13650, 14130, 14620, 15140, 15670, 15980, 16220, 16550, 16790,
+    17130, 17380, 17730, 17990, 18350, 18620, 18990, 19280, 19660, 19950,
+    20350, 20650, 21070, 21810, 22570, 22910, 23360, 24180, 25030, 25410};
+
+void CTCSSDetector::configure(const uint32_t sampling_rate) {
+    constexpr float r = 1.0f - 1.0f / 8192.0f;
+    constexpr float q30 = 1 << 30;
+
+    float r_n = r;
+    for (size_t i = 0; i < window_size_log2; i++)
+        r_n *= r_n;
+
+    for (size_t t = 0; t < tone_count; t++) {
+        const float turns = tones_x100[t] / (100.0f * sampling_rate);
+
+        // Exactly r after normalizing, or rounding could make the recursion grow.
+        const float w = 2 * pi * turns;
+        const float c = sin_f32(w + pi / 2);
+        const float s = sin_f32(w);
+        const float norm = r / __builtin_sqrtf(c * c + s * s);
+        step[t] = {
+            static_cast<int32_t>(c * norm * q30),
+            static_cast<int32_t>(-s * norm * q30)};
+
+        const float turns_n = turns * window_size;
+        const float w_n = 2 * pi * (turns_n - std::floor(turns_n));
+        wrap[t] = {
+            static_cast<int32_t>(sin_f32(w_n + pi / 2) * r_n * q30),
+            static_cast<int32_t>(-sin_f32(w_n) * r_n * q30)};
+    }
+
+    bins.fill({0, 0});
+    history.fill(0);
+    position = 0;
+    energy = 0;
+
+    // A tone of amplitude A sums to A / 2 * taper in its bin, its energy is N * A^2 / 2.
+    const float taper = (1.0f - r_n) / (1.0f - r);
+    gain = 2.0f * window_size / (taper * taper);
+}
+
+void CTCSSDetector::execute(const int16_t sample) {
+    constexpr int64_t round = 1 << 29;
+
+    const int32_t oldest = history[position];
+    history[position] = sample;
+    position = (position + 1) & (window_size - 1);
+    energy += sample * sample - oldest * oldest;
+
+    // X[n] = r e^(-jw) X[n-1] + x[n] - r^N e^(-jwN) x[n-N]
+    for (size_t t = 0; t < tone_count; t++) {
+        auto& bin = bins[t];
+        const auto& w = step[t];
+        const auto& v = wrap[t];
+        const int64_t re = static_cast<int64_t>(w.re) * bin.re - static_cast<int64_t>(w.im) * bin.im - static_cast<int64_t>(v.re) * oldest;
+        const int64_t im = static_cast<int64_t>(w.re) * bin.im + static_cast<int64_t>(w.im) * bin.re - static_cast<int64_t>(v.im) * oldest;
+        bin.re = static_cast<int32_t>((re + round) >> 30) + sample;
+        bin.im = static_cast<int32_t>((im + round) >> 30);
+    }
+}
+
+CTCSSDetector::Detection CTCSSDetector::detect() const {
+    if (energy <= 0)
+        return {0, 0};
+
+    size_t best = 0;
+    float best_power = 0.0f;
+    for (size_t t = 0; t < tone_count; t++) {
+        const float re = bins[t].re;
+        const float im = bins[t].im;
+        const float power = re * re + im * im;
+        if (power > best_power) {
+            best_power = power;
+            best = t;
+        }
+    }
+
+    const float share = best_power * gain / static_cast<float>(energy);
+    return {tones_x100[best], static_cast<uint8_t>(std::min(share, 1.0f) * 100.0f)};
+}
+
+// In octal, ascending.
+const std::array<uint16_t, 104> DCSDecoder::standard_codes{
+    0023, 0025, 0026, 0031, 0032, 0036, 0043, 0047, 0051, 0053, 0054, 0065, 0071,
+    0072, 0073, 0074, 0114, 0115, 0116, 0122, 0125, 0131, 0132, 0134, 0143, 0145,
+    0152, 0155, 0156, 0162, 0165, 0172, 0174, 0205, 0212, 0223, 0225, 0226, 0243,
+    0244, 0245, 0246, 0251, 0252, 0255, 0261, 0263, 0265, 0266, 0271, 0274, 0306,
+    0311, 0315, 0325, 0331, 0332, 0343, 0346, 0351, 0356, 0364, 0365, 0371, 0411,
+    0412, 0413, 0423, 0431, 0432, 0445, 0446, 0452, 0454, 0455, 0462, 0464, 0465,
+    0466, 0503, 0506, 0516, 0523, 0526, 0532, 0546, 0565, 0606, 0612, 0624, 0627,
+    0631, 0632, 0654, 0662, 0664, 0703, 0712, 0723, 0731, 0732, 0734, 0743, 0754};
+
+void DCSDecoder::configure(const uint32_t sampling_rate) {
+    phase_increment = (1344ULL << 32) / (10ULL * sampling_rate);
+    phase = 0;
+    last_sign = false;
+    word = 0;
+    bit_count = 0;
+    matches = 0;
+}
+
+void DCSDecoder::execute(const int16_t sample) {
+    const bool sign = sample >= 0;
+    if (sign != last_sign) {
+        // Bit edges belong at phase 0, pull the clock a quarter of the way
+        // there. Edges far from it are noise.
+        const int32_t error = static_cast<int32_t>(phase);
+        if ((error > -(1 << 30)) && (error < (1 << 30)))
+            phase -= error / 4;
+        last_sign = sign;
+    }
+
+    // Sample in the middle of the bit.
+    const uint32_t previous = phase;
+    phase += phase_increment;
+    if ((previous < 0x80000000U) && (phase >= 0x80000000U))
+        on_bit(sign);
+}
+
+uint8_t DCSDecoder::confidence() const {
+    return std::min<size_t>(matches * 100 / (2 * word_bits), 100);
+}
+
+int32_t DCSDecoder::match(const uint32_t word) {
+    int32_t best = -1;
+    bool best_standard = false;
+    for (size_t r = 0; r < word_bits; r++) {
+        const uint32_t w = ((word >> r) | (word << (word_bits - r))) & word_mask;
+        // The code is followed by the 100 marker, then the parity.
+        if (((w >> 9) & 7) != 0b100)
+            continue;
+
+        const int32_t code = w & 511;
+        if (dcs::dcs_word(code) != w)
+            continue;
+
+        const bool standard = std::binary_search(standard_codes.begin(), standard_codes.end(), code);
+        if ((best < 0) || (standard && !best_standard) || ((standard == best_standard) && (code < best))) {
+            best = code;
+            best_standard = standard;
+        }
+    }
+    return best;
+}
+
+void DCSDecoder::on_bit(const bool bit) {
+    // The first bit received ends up in bit 0.
+    word = (word >> 1) | (static_cast<uint32_t>(bit) << (word_bits - 1));
+    if (bit_count < word_bits) {
+        bit_count++;
+        if (bit_count < word_bits)
+            return;
+    }
+
+    // Polarity as seen after the demodulator.
+    bool inverted = false;
+    int32_t code = match(word);
+    if (code < 0) {
+        code = match(~word & word_mask);
+        inverted = true;
+    }
+
+    if (code < 0) {
+        matches = 0;
+    } else if ((matches > 0) && (code == code_) && (inverted == inverted_)) {
+        matches = std::min(matches + 1, 2 * word_bits);
+    } else {
+        code_ = code;
+        inverted_ = inverted;
+        matches = 1;
+    }
+}
+
+} /* namespace dsp */
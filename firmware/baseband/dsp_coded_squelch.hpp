@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __DSP_CODED_SQUELCH_H__
+#define __DSP_CODED_SQUELCH_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace dsp {
+
+/* Sliding DFT at each of the 50 EIA CTCSS tones, in fixed point. Samples are
+ * int16 at a low rate (a few kHz) with DC removed. The window is window_size
+ * samples, tapered by r^m with r slightly below 1 so rounding errors die out. */
+class CTCSSDetector {
+   public:
+    static constexpr size_t tone_count = 50;
+    static constexpr size_t window_size_log2 = 10;
+    static constexpr size_t window_size = 1 << window_size_log2;
+
+    struct Detection {
+        uint32_t tone_x100;  // 0.01 Hz, 0 when nothing was received.
+        uint8_t confidence;  // Share of the window power in the tone, 0..100.
+    };
+
+    static const std::array<uint16_t, tone_count> tones_x100;
+
+    void configure(const uint32_t sampling_rate);
+    void execute(const int16_t sample);
+    Detection detect() const;
+
+   private:
+    /* Complex values, coefficients are Q30. */
+    struct Complex32 {
+        int32_t re;
+        int32_t im;
+    };
+
+    std::array<Complex32, tone_count> bins{};
+    std::array<Complex32, tone_count> step{};  // r * e^(-jw)
+    std::array<Complex32, tone_count> wrap{};  // r^N * e^(-jwN), for the sample leaving the window
+    std::array<int16_t, window_size> history{};
+    size_t position{0};
+    int64_t energy{0};  // Sum of the squared samples in the window.
+    float gain{0.0f};   // Brings a pure tone to a power share of 1.
+};
+
+/* Digital-Coded Squelch: 23 bit Golay words at 134.4 bit/s, repeated with no
+ * framing. Bits are sliced from the sign of the low passed audio and every
+ * rotation of the last 23 bits is checked against the code table in dcs.cpp. */
+class DCSDecoder {
+   public:
+    static constexpr size_t word_bits = 23;
+
+    void configure(const uint32_t sampling_rate);
+    void execute(const int16_t sample);
+
+    /* A code repeated over a whole word. */
+    bool locked() const { return matches >= word_bits; }
+    uint16_t code() const { return code_; }
+    bool inverted() const { return inverted_; }
+    uint8_t confidence() const;
+
+    /* Code with a rotation equal to word, or -1. Standard codes are
+     * preferred over their aliases, then the lowest code. */
+    static int32_t match(const uint32_t word);
+
+    static const std::array<uint16_t, 104> standard_codes;
+
+   private:
+    static constexpr uint32_t word_mask = (1U << word_bits) - 1;
+
+    uint32_t phase{0};
+    uint32_t phase_increment{0};
+    bool last_sign{false};
+    uint32_t word{0};
+    size_t bit_count{0};
+    size_t matches{0};
+    uint16_t code_{0};
+    bool inverted_{false};
+
+    void on_bit(const bool bit);
+};
+
+} /* namespace dsp */
+
+#endif /*__DSP_CODED_SQUELCH_H__*/
@@ -27,6 +27,8 @@
 
 #include <hal.h>
 
+#include <algorithm>
+
 namespace dsp {
 namespace demodulate {
 
@@ -69,13 +71,23 @@ static inline float angle_approx_4deg0(const complex32_t t) {
         return 16384.0f * x;
 }
 */
-static inline float angle_approx_0deg27(const complex32_t t) {
-    if (t.real()) {
-        const auto x = static_cast<float>(t.imag()) / static_cast<float>(t.real());
-        return x / (1.0f + 0.28086f * x * x);
+/* Normalizes the 32-bit product to 16 bits, so weak signals keep their
+ * precision too, and returns the angle in 1/65536 turn (-32768 = -pi).
+ */
+static inline int32_t angle_fxpt(const complex32_t t) {
+    int32_t r = t.real();
+    int32_t i = t.imag();
+    // One's complement magnitude is enough to find the shift.
+    const uint32_t m = (r ^ (r >> 31)) | (i ^ (i >> 31));
+    const int32_t lz = __CLZ(m);
+    if (lz < 17) {
+        r >>= 17 - lz;
+        i >>= 17 - lz;
     } else {
-        return (t.imag() < 0) ? -1.5707963268f : 1.5707963268f;
+        r <<= lz - 17;
+        i <<= lz - 17;
     }
+    return fxpt_atan2(i, r);
 }
 
 static inline float angle_precise(const complex32_t t) {
@@ -118,9 +130,9 @@ buffer_s16_t FM::execute(
         const auto t0 = multiply_conjugate_s16_s32(s0, z);
         const auto t1 = multiply_conjugate_s16_s32(s1, s0);
         z = s1;
-        const int32_t theta0_int = angle_approx_0deg27(t0) * ks16;
+        const int32_t theta0_int = (angle_fxpt(t0) * ks16) >> 8;
         const int32_t theta0_sat = __SSAT(theta0_int, 16);
-        const int32_t theta1_int = angle_approx_0deg27(t1) * ks16;
+        const int32_t theta1_int = (angle_fxpt(t1) * ks16) >> 8;
         const int32_t theta1_sat = __SSAT(theta1_int, 16);
         *__SIMD32(dst_p)++ = __PKHBT(
             theta0_sat,
@@ -139,7 +151,12 @@ void FM::configure(const float sampling_rate, const float deviation_hz) {
      * delta_theta_max = 2 * pi * deviation / sampling_rate
      */
     kf = static_cast<float>(1.0f / (2.0 * pi * deviation_hz / sampling_rate));
-    ks16 = 32767.0f * kf;
+    /* The fixed-point angle is 1/65536 turn, so full deviation is
+     * 65536 * deviation / sampling_rate and maps to 32767. Kept below 128
+     * so the Q8 product can't overflow 32 bits.
+     */
+    const float gain = 32767.0f * sampling_rate / (65536.0f * deviation_hz);
+    ks16 = std::min(gain, 127.0f) * 256.0f + 0.5f;
 }
 
 }  // namespace demodulate
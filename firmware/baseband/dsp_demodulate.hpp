@@ -53,6 +53,7 @@ class FM {
         const buffer_c16_t& src,
         const buffer_f32_t& dst);
 
+    /* Fixed-point discriminator, two samples per iteration, packed Q15 out. */
     buffer_s16_t execute(
         const buffer_c16_t& src,
         const buffer_s16_t& dst);
@@ -62,7 +63,7 @@ class FM {
    private:
     complex16_t::rep_type z_{0};
     float kf{0};
-    float ks16{0};
+    int32_t ks16{0};  // Q8 gain from 1/65536 turn to Q15 full deviation.
 };
 
 } /* namespace demodulate */
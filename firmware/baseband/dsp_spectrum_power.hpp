@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __DSP_SPECTRUM_POWER_H__
+#define __DSP_SPECTRUM_POWER_H__
+
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+namespace dsp {
+namespace spectrum {
+
+/* Spectrum bins in fixed point, from FFT output to ChannelSpectrum bytes.
+ * Amplitudes are Q15 (1.0 is 0 dBV), powers are Q24 and saturate at 1.0,
+ * log2 of powers are Q8. A byte is 255 + 5 * dBV, clamped to 0..255. */
+
+/* Three term window applied to the bins, coefficients in Q15. */
+struct Window {
+    int32_t c0;
+    int32_t c1;
+    int32_t c2;
+};
+
+constexpr Window window_none{32768, 0, 0};
+constexpr Window window_hamming{17695, -7537, 0};
+constexpr Window window_blackman{13763, -8192, 131};
+
+constexpr uint32_t power_full_scale = 1 << 24;
+
+/* Power of windowed bin i of a frame of mask + 1 bins. scale brings the bins
+ * to Q15, their components must stay below 2^23 after scaling. */
+inline uint32_t window_mag2(
+    const std::complex<float>* const bins,
+    const size_t i,
+    const size_t mask,
+    const float scale,
+    const Window& window) {
+    const auto q15 = [bins, mask, scale](const size_t j) {
+        const auto b = bins[j & mask];
+        return std::complex<int32_t>{
+            static_cast<int32_t>(b.real() * scale),
+            static_cast<int32_t>(b.imag() * scale)};
+    };
+
+    const auto x0 = q15(i);
+    int64_t re = static_cast<int64_t>(x0.real()) * window.c0;
+    int64_t im = static_cast<int64_t>(x0.imag()) * window.c0;
+    if (window.c1) {
+        const auto xm = q15(i - 1);
+        const auto xp = q15(i + 1);
+        re += static_cast<int64_t>(xm.real() + xp.real()) * window.c1;
+        im += static_cast<int64_t>(xm.imag() + xp.imag()) * window.c1;
+    }
+    if (window.c2) {
+        const auto xm = q15(i - 2);
+        const auto xp = q15(i + 2);
+        re += static_cast<int64_t>(xm.real() + xp.real()) * window.c2;
+        im += static_cast<int64_t>(xm.imag() + xp.imag()) * window.c2;
+    }
+
+    // Back to Q15 amplitudes, then Q30 power down to Q24.
+    const int64_t a = re >> 15;
+    const int64_t b = im >> 15;
+    const uint64_t mag2 = static_cast<uint64_t>(a * a + b * b) >> 6;
+    return (mag2 < power_full_scale) ? mag2 : power_full_scale;
+}
+
+/* round(256 * log2(1 + (k + 0.5) / 64)) */
+extern const std::array<uint8_t, 64> log2_fraction_q8;
+
+/* log2 of a Q24 power in Q8, 0 for a power of 0. */
+inline uint32_t power_log2(const uint32_t power) {
+    if (power == 0) return 0;
+
+    const uint32_t e = 31 - __builtin_clz(power);
+    const uint32_t f = (e >= 6) ? (power >> (e - 6)) : (power << (6 - e));
+    return (e << 8) + log2_fraction_q8[f & 63];
+}
+
+/* ChannelSpectrum byte of a Q8 log2 power. */
+inline uint8_t log2_to_db_byte(const uint32_t log2_q8) {
+    // byte = 255 + 5 * 10 * log10(2) * (log2 / 256 - 24), in Q16.
+    constexpr int32_t gain = 3853;      // 50 * log10(2) / 256 * 65536
+    constexpr int32_t offset = 6962282;  // (24 * 50 * log10(2) - 255) * 65536
+    const int32_t v = (static_cast<int32_t>(log2_q8) * gain - offset + 32768) >> 16;
+    return (v < 0) ? 0 : ((v > 255) ? 255 : v);
+}
+
+inline uint8_t power_to_db_byte(const uint32_t power) {
+    return (power == 0) ? 0 : log2_to_db_byte(power_log2(power));
+}
+
+} /* namespace spectrum */
+} /* namespace dsp */
+
+#endif /*__DSP_SPECTRUM_POWER_H__*/
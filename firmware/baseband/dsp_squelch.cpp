@@ -23,6 +23,7 @@
 
 #include <cstdint>
 #include <array>
+#include <algorithm>
 
 bool FMSquelch::execute(const buffer_f32_t& audio) {
     if (threshold_squared == 0.0f) {
@@ -48,8 +49,33 @@ bool FMSquelch::execute(const buffer_f32_t& audio) {
     return (non_audio_max_squared < threshold_squared);
 }
 
+bool FMSquelch::execute(const buffer_s16_t& audio) {
+    if (threshold_squared_s16 == 0) {
+        return true;
+    }
+
+    std::array<int16_t, 32> squelch_energy_buffer;
+    const buffer_s16_t squelch_energy{squelch_energy_buffer.data(), audio.count};
+    non_audio_hpf_q15.execute(audio, squelch_energy);
+
+    uint32_t non_audio_max_squared = 0;
+    for (size_t i = 0; i < squelch_energy.count; ++i) {
+        const int32_t sample = squelch_energy.p[i];
+        const uint32_t sample_squared = sample * sample;
+
+        if (sample_squared > non_audio_max_squared)
+            non_audio_max_squared = sample_squared;
+    }
+
+    return (non_audio_max_squared < threshold_squared_s16);
+}
+
 void FMSquelch::set_threshold(const float new_value) {
     threshold_squared = new_value * new_value;
+
+    // Same threshold on the Q15 scale, at least 1 so a tiny level still squelches.
+    const float threshold_s16 = std::min(new_value, 1.0f) * 32768.0f;
+    threshold_squared_s16 = (threshold_squared > 0.0f) ? std::max<uint32_t>(threshold_s16 * threshold_s16, 1) : 0;
 }
 
 bool FMSquelch::enabled() const {
@@ -34,14 +34,17 @@ class FMSquelch {
     /* Check if noise level is lower than threshold.
      * Returns true if noise is below threshold. */
     bool execute(const buffer_f32_t& audio);
+    bool execute(const buffer_s16_t& audio);
 
     void set_threshold(const float new_value);
     bool enabled() const;
 
    private:
     float threshold_squared{0.0f};
+    uint32_t threshold_squared_s16{0};
 
     IIRBiquadFilter non_audio_hpf{non_audio_hpf_config};
+    IIRBiquadFilterQ15 non_audio_hpf_q15{non_audio_hpf_config};
 };
 
 #endif /*__DSP_SQUELCH_H__*/
@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __DSP_TX_SYNTH_H__
+#define __DSP_TX_SYNTH_H__
+
+#include "dsp_types.hpp"
+#include "dsp_fft.hpp"
+#include "sine_table_int8.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+/* Building blocks shared by the transmit processors. Phases are 32 bit
+ * fractions of a turn, the top 8 bits index sine_table_i8. Block methods
+ * write straight into the baseband buffer. */
+namespace dsp {
+namespace synth {
+
+/* Phase increment per sample of a tone at frequency. */
+constexpr uint32_t phase_delta(const int32_t frequency, const uint32_t sampling_rate) {
+    return static_cast<uint32_t>((static_cast<int64_t>(frequency) << 32) / sampling_rate);
+}
+
+/* FM phase increment per unit of an int8 modulating sample: full scale
+ * swings the carrier over about bandwidth Hz, +/- bandwidth / 2. */
+constexpr uint32_t fm_delta(const uint32_t bandwidth, const uint32_t sampling_rate) {
+    return bandwidth * (0xFFFFFFULL / sampling_rate);
+}
+
+inline int8_t sine(const uint32_t phase) {
+    return sine_table_i8[phase >> 24];
+}
+
+/* cos + j sin. */
+inline complex8_t phasor(const uint32_t phase) {
+    return {sine(phase + (64 << 24)), sine(phase)};
+}
+
+/* Numerically controlled oscillator. */
+class NCO {
+   public:
+    void set_delta(const uint32_t delta) { delta_ = delta; }
+    uint32_t delta() const { return delta_; }
+    void reset() { phase_ = 0; }
+
+    /* Sample at the current phase, then steps. */
+    int8_t next() {
+        const auto sample = sine(phase_);
+        phase_ += delta_;
+        return sample;
+    }
+
+   private:
+    uint32_t phase_{0};
+    uint32_t delta_{0};
+};
+
+/* Mix of N oscillators, each at 1/N of full scale. */
+template <size_t N>
+class NCOBank {
+    static_assert((N & (N - 1)) == 0, "N must be a power of 2");
+
+   public:
+    NCO& operator[](const size_t index) { return ncos_[index]; }
+
+    void reset() {
+        for (auto& nco : ncos_)
+            nco.reset();
+    }
+
+    int32_t next() {
+        int32_t sample = 0;
+        for (auto& nco : ncos_)
+            sample += nco.next() >> shift;
+        return sample;
+    }
+
+   private:
+    static constexpr size_t shift = (N >= 8) ? 3 : ((N >= 4) ? 2 : ((N >= 2) ? 1 : 0));
+    static_assert(N <= 8, "Mixing more than 8 oscillators is not supported");
+
+    std::array<NCO, N> ncos_{};
+};
+
+/* FM at baseband: the carrier phase moves by sample * fm_delta. */
+class FMModulator {
+   public:
+    void set_fm_delta(const uint32_t fm_delta) { fm_delta_ = fm_delta; }
+
+    complex8_t modulate(const int32_t sample) {
+        phase_ += static_cast<uint32_t>(sample) * fm_delta_;
+        return phasor(phase_);
+    }
+
+   private:
+    uint32_t phase_{0};
+    uint32_t fm_delta_{0};
+};
+
+/* Holds each symbol for samples_per_symbol samples, asking the source for
+ * the next one at each boundary. Symbols index a table of phase increments. */
+template <size_t Symbols>
+class SymbolClock {
+   public:
+    void configure(const uint32_t samples_per_symbol, const std::array<uint32_t, Symbols>& deltas) {
+        samples_per_symbol_ = samples_per_symbol;
+        deltas_ = deltas;
+        remaining_ = 0;
+        running_ = true;
+    }
+
+    bool running() const { return running_; }
+
+    /* Phase increment of the current symbol, 0 once the source ran dry. Source
+     * is bool(uint8_t& symbol), false at the end of the data. */
+    template <typename Source>
+    bool next(Source& source, uint32_t& delta) {
+        if (remaining_ == 0) {
+            uint8_t symbol = 0;
+            if (!running_ || !source(symbol)) {
+                running_ = false;
+                return false;
+            }
+            delta_ = deltas_[symbol % Symbols];
+            remaining_ = samples_per_symbol_;
+        }
+        remaining_--;
+        delta = delta_;
+        return true;
+    }
+
+   private:
+    std::array<uint32_t, Symbols> deltas_{};
+    uint32_t samples_per_symbol_{0};
+    uint32_t remaining_{0};
+    uint32_t delta_{0};
+    bool running_{false};
+};
+
+/* Direct FSK: each symbol offsets the carrier by its own frequency. */
+template <size_t Symbols = 2>
+class FSKModulator {
+   public:
+    /* deltas are the carrier phase increments of each symbol. */
+    void configure(const uint32_t samples_per_symbol, const std::array<uint32_t, Symbols>& deltas) {
+        clock_.configure(samples_per_symbol, deltas);
+    }
+
+    bool running() const { return clock_.running(); }
+
+    /* Fills buffer, the rest of it is zero once the source runs dry.
+     * Returns false when the data is over. */
+    template <typename Source>
+    bool execute(const buffer_c8_t& buffer, Source&& source) {
+        for (size_t i = 0; i < buffer.count; i++) {
+            uint32_t delta;
+            if (!clock_.next(source, delta)) {
+                std::fill(buffer.p + i, buffer.p + buffer.count, complex8_t{0, 0});
+                return false;
+            }
+            phase_ += delta;
+            buffer.p[i] = phasor(phase_);
+        }
+        return true;
+    }
+
+   private:
+    SymbolClock<Symbols> clock_{};
+    uint32_t phase_{0};
+};
+
+/* AFSK: each symbol is an audio tone, frequency modulated onto the carrier.
+ * The tone phase runs on across symbols. */
+template <size_t Symbols = 2>
+class AFSKModulator {
+   public:
+    /* deltas are the audio tone phase increments of each symbol. */
+    void configure(const uint32_t samples_per_symbol, const std::array<uint32_t, Symbols>& deltas, const uint32_t fm_delta) {
+        clock_.configure(samples_per_symbol, deltas);
+        fm_.set_fm_delta(fm_delta);
+    }
+
+    bool running() const { return clock_.running(); }
+
+    template <typename Source>
+    bool execute(const buffer_c8_t& buffer, Source&& source) {
+        for (size_t i = 0; i < buffer.count; i++) {
+            uint32_t delta;
+            if (!clock_.next(source, delta)) {
+                std::fill(buffer.p + i, buffer.p + buffer.count, complex8_t{0, 0});
+                return false;
+            }
+            tone_.set_delta(delta);
+            buffer.p[i] = fm_.modulate(tone_.next());
+        }
+        return true;
+    }
+
+   private:
+    SymbolClock<Symbols> clock_{};
+    NCO tone_{};
+    FMModulator fm_{};
+};
+
+/* Turns a spectrum into a block of samples by inverse FFT, as in OFDM. The
+ * bins are set in FFT order (DC first), the block is scaled so its peak
+ * is peak. N is the largest block size, a power of 2. */
+template <size_t N>
+class IFFTSynthesizer {
+   public:
+    /* Starts a new block of size samples with all bins at zero. */
+    void clear(const size_t size) {
+        size_ = std::min(size, N);
+        std::fill(bins_.begin(), bins_.begin() + size_, complex16_t{0, 0});
+    }
+
+    size_t size() const { return size_; }
+
+    void set_bin(const size_t index, const complex16_t value) {
+        bins_[index] = value;
+    }
+
+    /* Bin at a signed frequency index, negative frequencies wrap to the top. */
+    void set_centered_bin(const int32_t index, const complex16_t value) {
+        bins_[(index < 0) ? (index + size_) : index] = value;
+    }
+
+    /* Writes size_ samples to out. Returns false for an all zero block. */
+    bool synthesize(complex8_t* const out, const int32_t peak = 120) {
+        ifft<complex16_t>(bins_.data(), size_, tmp_.data());
+
+        int32_t maximum = 1;
+        for (size_t i = 0; i < size_; i++) {
+            maximum = std::max<int32_t>(maximum, std::abs(bins_[i].real()));
+            maximum = std::max<int32_t>(maximum, std::abs(bins_[i].imag()));
+        }
+
+        if (maximum == 1) {
+            std::fill(out, out + size_, complex8_t{0, 0});
+            return false;
+        }
+
+        for (size_t i = 0; i < size_; i++)
+            out[i] = {(int8_t)(bins_[i].real() * peak / maximum), (int8_t)(bins_[i].imag() * peak / maximum)};
+        return true;
+    }
+
+   private:
+    std::array<complex16_t, N> bins_{};
+    std::array<complex16_t, N> tmp_{};
+    size_t size_{N};
+};
+
+} /* namespace synth */
+} /* namespace dsp */
+
+#endif /*__DSP_TX_SYNTH_H__*/
@@ -26,6 +26,10 @@
 
 #include "utility.hpp"
 
+#if defined(__arm__)
+#include "hal.h"
+#endif
+
 namespace dsp {
 namespace matched_filter {
 
@@ -101,5 +105,163 @@ void MatchedFilter::shift_by_decimation_factor() {
     }
 }
 
+namespace {
+
+#if defined(__arm__)
+
+/* Cortex-M4 dual 16-bit multiply-accumulate. */
+inline int32_t smlad(const uint32_t a, const uint32_t b, const int32_t acc) {
+    return __SMLAD(a, b, acc);
+}
+
+inline int32_t smlsd(const uint32_t a, const uint32_t b, const int32_t acc) {
+    return __SMLSD(a, b, acc);
+}
+
+inline int32_t smladx(const uint32_t a, const uint32_t b, const int32_t acc) {
+    return __SMLADX(a, b, acc);
+}
+
+inline int32_t smlsdx(const uint32_t a, const uint32_t b, const int32_t acc) {
+    return __SMLSDX(a, b, acc);
+}
+
+#else
+
+/* Portable equivalents, used by the host tests. */
+inline int32_t lo(const uint32_t v) {
+    return static_cast<int16_t>(v & 0xffff);
+}
+
+inline int32_t hi(const uint32_t v) {
+    return static_cast<int16_t>(v >> 16);
+}
+
+inline int32_t smlad(const uint32_t a, const uint32_t b, const int32_t acc) {
+    return acc + lo(a) * lo(b) + hi(a) * hi(b);
+}
+
+inline int32_t smlsd(const uint32_t a, const uint32_t b, const int32_t acc) {
+    return acc + lo(a) * lo(b) - hi(a) * hi(b);
+}
+
+inline int32_t smladx(const uint32_t a, const uint32_t b, const int32_t acc) {
+    return acc + lo(a) * hi(b) + hi(a) * lo(b);
+}
+
+inline int32_t smlsdx(const uint32_t a, const uint32_t b, const int32_t acc) {
+    return acc + lo(a) * hi(b) - hi(a) * lo(b);
+}
+
+#endif
+
+inline uint32_t pack_q15(const int16_t r, const int16_t i) {
+    return static_cast<uint16_t>(r) | (static_cast<uint32_t>(static_cast<uint16_t>(i)) << 16);
+}
+
+inline uint32_t abs_u32(const int32_t v) {
+    return (v < 0) ? (0u - static_cast<uint32_t>(v)) : static_cast<uint32_t>(v);
+}
+
+/* max(hi, 7/8 hi + 1/2 lo): |z| within about 3%, no multiply or sqrt. */
+inline uint32_t magnitude_approx(const int32_t re, const int32_t im) {
+    const uint32_t a = abs_u32(re);
+    const uint32_t b = abs_u32(im);
+    const uint32_t hi = (a > b) ? a : b;
+    const uint32_t lo = (a > b) ? b : a;
+    const uint32_t blend = hi - (hi >> 3) + (lo >> 1);
+    return (blend > hi) ? blend : hi;
+}
+
+} /* namespace */
+
+void MatchedFilterQ15::configure(
+    const tap_t* const taps,
+    const size_t taps_count,
+    const size_t decimation_factor) {
+    /* Scale so that sum(|re| + |im|) of the taps fits Q15; each dual MAC
+     * then stays below 2^31 for any int16 input. */
+    float l1 = 0.0f;
+    for (size_t n = 0; n < taps_count; n++) {
+        l1 += std::abs(taps[n].real()) + std::abs(taps[n].imag());
+    }
+    const float scale = (l1 > 0.0f) ? (32767.0f / l1) : 1.0f;
+
+    samples_ = std::make_unique<samples_t>(taps_count * 2);
+    taps_reversed_ = std::make_unique<taps_q15_t>(taps_count);
+    std::fill(&samples_[0], &samples_[taps_count * 2], 0);
+    for (size_t n = 0; n < taps_count; n++) {
+        const auto tap = taps[taps_count - 1 - n];
+        /* Truncate towards zero so the L1 bound above is never exceeded. */
+        taps_reversed_[n] = pack_q15(
+            static_cast<int16_t>(tap.real() * scale),
+            static_cast<int16_t>(tap.imag() * scale));
+    }
+
+    taps_count_ = taps_count;
+    decimation_factor_ = decimation_factor;
+    decimation_phase = 0;
+    write_index = 0;
+    output_scale = 1.0f / scale;
+    output = 0;
+}
+
+bool MatchedFilterQ15::execute_once(
+    const sample_t input) {
+    const uint32_t packed = input.__rep();
+    samples_[write_index] = packed;
+    samples_[write_index + taps_count_] = packed;
+    write_index = (write_index + 1 == taps_count_) ? 0 : write_index + 1;
+
+    advance_decimation_phase();
+    if (!is_new_decimation_cycle()) {
+        return false;
+    }
+
+    /* Oldest sample is at write_index, window is contiguous thanks to the
+     * mirrored second half of the delay line. */
+    const uint32_t* s = &samples_[write_index];
+    const uint32_t* t = &taps_reversed_[0];
+
+    // N: complex multiple of samples and taps (conjugate, tap.i negated).
+    // P: complex multiply of samples and taps.
+    int32_t r_n = 0;
+    int32_t r_p = 0;
+    int32_t i_p = 0;
+    int32_t i_n_neg = 0;
+
+    size_t count = taps_count_;
+    while (count >= 2) {
+        const uint32_t s0 = *s++;
+        const uint32_t t0 = *t++;
+        const uint32_t s1 = *s++;
+        const uint32_t t1 = *t++;
+        r_n = smlad(s0, t0, r_n);
+        r_p = smlsd(s0, t0, r_p);
+        i_p = smladx(s0, t0, i_p);
+        i_n_neg = smlsdx(s0, t0, i_n_neg);
+        r_n = smlad(s1, t1, r_n);
+        r_p = smlsd(s1, t1, r_p);
+        i_p = smladx(s1, t1, i_p);
+        i_n_neg = smlsdx(s1, t1, i_n_neg);
+        count -= 2;
+    }
+    if (count) {
+        const uint32_t s0 = *s;
+        const uint32_t t0 = *t;
+        r_n = smlad(s0, t0, r_n);
+        r_p = smlsd(s0, t0, r_p);
+        i_p = smladx(s0, t0, i_p);
+        i_n_neg = smlsdx(s0, t0, i_n_neg);
+    }
+
+    const auto mag_n = magnitude_approx(r_n, i_n_neg);
+    const auto mag_p = magnitude_approx(r_p, i_p);
+    const auto diff = static_cast<int64_t>(mag_p) - static_cast<int64_t>(mag_n);
+    output = static_cast<float>(diff) * output_scale;
+
+    return true;
+}
+
 } /* namespace matched_filter */
 } /* namespace dsp */
@@ -23,9 +23,12 @@
 #define __MATCHED_FILTER_H__
 
 #include <cstddef>
+#include <cstdint>
 #include <complex>
 #include <memory>
 
+#include "complex.hpp"
+
 namespace dsp {
 namespace matched_filter {
 
@@ -87,6 +90,65 @@ class MatchedFilter {
         const size_t decimation_factor);
 };
 
+// Fixed-point equivalent of MatchedFilter for complex16_t baseband samples.
+// Taps are converted once to Q15 (normalized so the accumulators cannot
+// overflow), the delay line is a double-length circular buffer so no samples
+// are moved per output, and the magnitudes are approximated instead of using
+// sqrt. Output is scaled back to match MatchedFilter::get_output().
+
+class MatchedFilterQ15 {
+   public:
+    using sample_t = complex16_t;
+    using tap_t = std::complex<float>;
+
+    template <class T>
+    MatchedFilterQ15(
+        const T& taps,
+        size_t decimation_factor = 1) {
+        configure(taps, decimation_factor);
+    }
+
+    template <class T>
+    void configure(
+        const T& taps,
+        size_t decimation_factor) {
+        configure(taps.data(), taps.size(), decimation_factor);
+    }
+
+    bool execute_once(const sample_t input);
+
+    float get_output() const {
+        return output;
+    }
+
+   private:
+    using samples_t = uint32_t[];
+    using taps_q15_t = uint32_t[];
+
+    /* Packed {real, imag} int16 pairs; samples_ holds 2 * taps_count_ entries. */
+    std::unique_ptr<samples_t> samples_{};
+    std::unique_ptr<taps_q15_t> taps_reversed_{};
+    size_t taps_count_{0};
+    size_t decimation_factor_{1};
+    size_t decimation_phase{0};
+    size_t write_index{0};
+    float output_scale{1.0f};
+    float output{0};
+
+    void advance_decimation_phase() {
+        decimation_phase = (decimation_phase + 1) % decimation_factor_;
+    }
+
+    bool is_new_decimation_cycle() const {
+        return (decimation_phase == 0);
+    }
+
+    void configure(
+        const tap_t* const taps,
+        const size_t taps_count,
+        const size_t decimation_factor);
+};
+
 } /* namespace matched_filter */
 } /* namespace dsp */
 
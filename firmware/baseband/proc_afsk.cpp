@@ -22,7 +22,6 @@
 
 #include "proc_afsk.hpp"
 #include "portapack_shared_memory.hpp"
-#include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 
 #include <cstdint>
@@ -32,63 +31,42 @@ void AFSKProcessor::execute(const buffer_c8_t& buffer) {
 
     if (!configured) return;
 
-    for (size_t i = 0; i < buffer.count; i++) {
-        if (sample_count >= afsk_samples_per_bit) {
-            if (configured) {
-                cur_word = *word_ptr;
+    configured = modulator.execute(buffer, [this](uint8_t& bit) { return next_bit(bit); });
 
-                if (!cur_word) {
-                    // End of data
-                    if (repeat_counter < afsk_repeat) {
-                        // Repeat
-                        bit_pos = 0;
-                        word_ptr = (uint16_t*)shared_memory.bb_data.data;
-                        cur_word = *word_ptr;
-                        txprogress_message.done = false;
-                        txprogress_message.progress = repeat_counter + 1;
-                        shared_memory.application_queue.push(txprogress_message);
-                        repeat_counter++;
-                    } else {
-                        // Stop
-                        cur_word = 0;
-                        txprogress_message.done = true;
-                        shared_memory.application_queue.push(txprogress_message);
-                        configured = false;
-                    }
-                }
-            }
-
-            cur_bit = (cur_word >> (symbol_count - bit_pos)) & 1;
-
-            if (bit_pos >= symbol_count) {
-                bit_pos = 0;
-                word_ptr++;
-            } else {
-                bit_pos++;
-            }
-
-            sample_count = 0;
-        } else {
-            sample_count++;
-        }
-
-        if (cur_bit)
-            tone_phase += afsk_phase_inc_mark;
-        else
-            tone_phase += afsk_phase_inc_space;
-
-        tone_sample = sine_table_i8[(tone_phase & 0xFF000000U) >> 24];
-
-        delta = tone_sample * fm_delta;
+    if (!configured) {
+        // Stop
+        txprogress_message.done = true;
+        shared_memory.application_queue.push(txprogress_message);
+    }
+}
 
-        phase += delta;
-        sphase = phase + (64 << 24);
+bool AFSKProcessor::next_bit(uint8_t& bit) {
+    uint16_t cur_word = *word_ptr;
+
+    if (!cur_word) {
+        // End of data
+        if (repeat_counter >= afsk_repeat)
+            return false;
+
+        // Repeat
+        bit_pos = 0;
+        word_ptr = (uint16_t*)shared_memory.bb_data.data;
+        cur_word = *word_ptr;
+        txprogress_message.done = false;
+        txprogress_message.progress = repeat_counter + 1;
+        shared_memory.application_queue.push(txprogress_message);
+        repeat_counter++;
+    }
 
-        re = (sine_table_i8[(sphase & 0xFF000000U) >> 24]);
-        im = (sine_table_i8[(phase & 0xFF000000U) >> 24]);
+    bit = (cur_word >> (symbol_count - bit_pos)) & 1;
 
-        buffer.p[i] = {re, im};
+    if (bit_pos >= symbol_count) {
+        bit_pos = 0;
+        word_ptr++;
+    } else {
+        bit_pos++;
     }
+    return true;
 }
 
 void AFSKProcessor::on_message(const Message* const msg) {
@@ -96,19 +74,16 @@ void AFSKProcessor::on_message(const Message* const msg) {
 
     if (message.id == Message::ID::AFSKTxConfigure) {
         if (message.samples_per_bit) {
-            afsk_samples_per_bit = message.samples_per_bit;
-            afsk_phase_inc_mark = message.phase_inc_mark * AFSK_DELTA_COEF;
-            afsk_phase_inc_space = message.phase_inc_space * AFSK_DELTA_COEF;
+            modulator.configure(
+                message.samples_per_bit,
+                {(uint32_t)(message.phase_inc_space * AFSK_DELTA_COEF), (uint32_t)(message.phase_inc_mark * AFSK_DELTA_COEF)},
+                dsp::synth::fm_delta(message.fm_delta, AFSK_SAMPLERATE));
             afsk_repeat = message.repeat - 1;
-            fm_delta = message.fm_delta * (0xFFFFFFULL / AFSK_SAMPLERATE);
             symbol_count = message.symbol_count - 1;
 
-            sample_count = afsk_samples_per_bit;
             repeat_counter = 0;
             bit_pos = 0;
             word_ptr = (uint16_t*)shared_memory.bb_data.data;
-            cur_word = 0;
-            cur_bit = 0;
             configured = true;
         } else
             configured = false;  // Kill
@@ -25,6 +25,7 @@
 
 #include "baseband_processor.hpp"
 #include "baseband_thread.hpp"
+#include "dsp_tx_synth.hpp"
 
 #define AFSK_SAMPLERATE 1536000
 #define AFSK_DELTA_COEF ((1ULL << 32) / AFSK_SAMPLERATE)
@@ -37,23 +38,16 @@ class AFSKProcessor : public BasebandProcessor {
    private:
     bool configured = false;
 
-    uint32_t afsk_samples_per_bit{0};
-    uint32_t afsk_phase_inc_mark{0};
-    uint32_t afsk_phase_inc_space{0};
     uint8_t afsk_repeat{0};
-    uint32_t fm_delta{0};
     uint8_t symbol_count{0};
 
     uint8_t repeat_counter{0};
     uint8_t bit_pos{0};
     uint16_t* word_ptr{};
-    uint16_t cur_word{0};
-    uint8_t cur_bit{0};
-    uint32_t sample_count{0};
-    uint32_t tone_phase{0}, phase{0}, sphase{0};
-    int32_t tone_sample{0}, delta{0};
 
-    int8_t re{0}, im{0};
+    dsp::synth::AFSKModulator<2> modulator{};
+
+    bool next_bit(uint8_t& bit);
 
     TXProgressMessage txprogress_message{};
 
@@ -30,7 +30,7 @@
 
 AISProcessor::AISProcessor() {
     decim_0.configure(taps_11k0_decim_0.taps);
-    decim_1.configure(taps_11k0_decim_1.taps);
+    channelizer.configure(taps_11k0_decim_1.taps, baseband::ais::channel_offsets, baseband_fs / decim_0.decimation_factor);
     baseband_thread.start();
 }
 
@@ -38,20 +38,28 @@ void AISProcessor::execute(const buffer_c8_t& buffer) {
     /* 2.4576MHz, 2048 samples */
 
     const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-    const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
-    const auto decimator_out = decim_1_out;
 
-    /* 38.4kHz, 32 samples */
-    feed_channel_stats(decimator_out);
+    /* 307.2kHz, 256 samples, both channels */
+    feed_channel_stats(decim_0_out);
 
-    for (size_t i = 0; i < decimator_out.count; i++) {
-        if (mf.execute_once(decimator_out.p[i])) {
+    const auto count = channelizer.execute(
+        decim_0_out,
+        {channel_dst[0].data(), channel_dst[1].data()});
+
+    /* 38.4kHz, 32 samples per channel */
+    demodulator_a.execute(channel_dst[0].data(), count);
+    demodulator_b.execute(channel_dst[1].data(), count);
+}
+
+void AISProcessor::Demodulator::execute(const complex16_t* const samples, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (mf.execute_once(samples[i])) {
             clock_recovery(mf.get_output());
         }
     }
 }
 
-void AISProcessor::consume_symbol(
+void AISProcessor::Demodulator::consume_symbol(
     const float raw_symbol) {
     const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
     const auto decoded_symbol = nrzi_decode(sliced_symbol);
@@ -59,9 +67,9 @@ void AISProcessor::consume_symbol(
     packet_builder.execute(decoded_symbol);
 }
 
-void AISProcessor::payload_handler(
+void AISProcessor::Demodulator::payload_handler(
     const baseband::Packet& packet) {
-    const AISPacketMessage message{packet};
+    const AISPacketMessage message{packet, channel};
     shared_memory.application_queue.push(message);
 }
 
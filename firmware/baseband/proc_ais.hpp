@@ -27,6 +27,7 @@
 #include "rssi_thread.hpp"
 
 #include "channel_decimator.hpp"
+#include "dsp_channelizer.hpp"
 #include "matched_filter.hpp"
 
 #include "clock_recovery.hpp"
@@ -51,31 +52,53 @@ class AISProcessor : public BasebandProcessor {
    private:
     static constexpr size_t baseband_fs = 2457600;
 
+    /* One AIS channel: matched filter, clock recovery and HDLC framing.
+     * Packets are tagged with the channel number. */
+    class Demodulator {
+       public:
+        Demodulator(const uint32_t channel)
+            : channel{channel} {
+        }
+
+        void execute(const complex16_t* const samples, const size_t count);
+
+       private:
+        const uint32_t channel;
+
+        dsp::matched_filter::MatchedFilterQ15 mf{baseband::ais::square_taps_38k4_1t_p, 2};
+
+        clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery{
+            19200,
+            9600,
+            {0.0555f},
+            [this](const float symbol) { this->consume_symbol(symbol); }};
+        symbol_coding::NRZIDecoder nrzi_decode{};
+        PacketBuilder<BitPattern, BitPattern, BitPattern> packet_builder{
+            {0b0101010101111110, 16, 1},
+            {0b111110, 6},
+            {0b01111110, 8},
+            [this](const baseband::Packet& packet) {
+                this->payload_handler(packet);
+            }};
+
+        void consume_symbol(const float symbol);
+        void payload_handler(const baseband::Packet& packet);
+    };
+
     std::array<complex16_t, 512> dst{};
     const buffer_c16_t dst_buffer{
         dst.data(),
         dst.size()};
 
+    /* 38.4kHz, 32 samples per buffer for each channel. */
+    std::array<std::array<complex16_t, 32>, baseband::ais::channel_count> channel_dst{};
+
     dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0{};
-    dsp::decimate::FIRC16xR16x32Decim8 decim_1{};
-    dsp::matched_filter::MatchedFilter mf{baseband::ais::square_taps_38k4_1t_p, 2};
-
-    clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery{
-        19200,
-        9600,
-        {0.0555f},
-        [this](const float symbol) { this->consume_symbol(symbol); }};
-    symbol_coding::NRZIDecoder nrzi_decode{};
-    PacketBuilder<BitPattern, BitPattern, BitPattern> packet_builder{
-        {0b0101010101111110, 16, 1},
-        {0b111110, 6},
-        {0b01111110, 8},
-        [this](const baseband::Packet& packet) {
-            this->payload_handler(packet);
-        }};
-
-    void consume_symbol(const float symbol);
-    void payload_handler(const baseband::Packet& packet);
+    dsp::channelizer::PolyphaseChannelizer<baseband::ais::channel_count> channelizer{};
+
+    Demodulator demodulator_a{0};
+    Demodulator demodulator_b{1};
+
     void on_message(const Message* const message);
     void on_beep_message(const AudioBeepMessage& message);
 
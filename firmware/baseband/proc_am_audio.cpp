@@ -25,28 +25,39 @@
 #include "audio_dma.hpp"
 
 #include "event_m4.hpp"
+#include "baseband_profiler.hpp"
 
 #include <array>
 
+namespace profile = baseband::profile;
+
 void NarrowbandAMAudio::execute(const buffer_c8_t& buffer) {
     if (!configured) {
         return;
     }
 
     const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+    profile::mark(profile::Stage::Decim0);
     const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
+    profile::mark(profile::Stage::Decim1);
 
     channel_spectrum.feed(decim_1_out, channel_filter_low_f, channel_filter_high_f, channel_filter_transition);
+    profile::mark(profile::Stage::Spectrum);
 
     const auto decim_2_out = decim_2.execute(decim_1_out, dst_buffer);
+    profile::mark(profile::Stage::Decim2);
     const auto channel_out = channel_filter.execute(decim_2_out, dst_buffer);
+    profile::mark(profile::Stage::ChannelFilter);
 
     // TODO: Feed channel_stats post-decimation data?
     feed_channel_stats(channel_out);
+    profile::mark(profile::Stage::Other);
 
     auto audio = demodulate(channel_out);
+    profile::mark(profile::Stage::Demod);
     audio_compressor.execute_in_place(audio);
     audio_output.write(audio);
+    profile::mark(profile::Stage::Audio);
 }
 
 buffer_f32_t NarrowbandAMAudio::demodulate(const buffer_c16_t& channel) {
@@ -125,29 +125,13 @@ int BTLERxProcessor::verify_payload_byte(int num_payload_byte, ADV_PDU_TYPE pdu_
 void BTLERxProcessor::handleBeginState() {
     int num_symbol_left = dst_buffer.count / SAMPLE_PER_SYMBOL;  // One buffer sample consist of I and Q.
 
-    static uint8_t demod_buf_access[SAMPLE_PER_SYMBOL][LEN_DEMOD_BUF_ACCESS];
-
-    uint32_t uint32_tmp = DEFAULT_ACCESS_ADDR;
-    uint8_t accessAddrBits[LEN_DEMOD_BUF_ACCESS];
-
-    uint32_t accesssAddress = 0;
-
-    // Filling up addressBits with the access address we are looking to find.
-    for (int i = 0; i < 32; i++) {
-        accessAddrBits[i] = 0x01 & uint32_tmp;
-        uint32_tmp = (uint32_tmp >> 1);
-    }
-
-    const int demod_buf_len = LEN_DEMOD_BUF_ACCESS;  // For AA
-    int demod_buf_offset = 0;
+    // Hits come on the last bit of the access address, index them from its first.
+    const int first_compare_idx = (LEN_DEMOD_BUF_ACCESS - 1) * SAMPLE_PER_SYMBOL;
     int hit_idx = (-1);
-    bool unequal_flag = false;
-
-    memset(demod_buf_access, 0, SAMPLE_PER_SYMBOL * demod_buf_len);
 
-    for (int i = 0; i < num_symbol_left * SAMPLE_PER_SYMBOL; i += SAMPLE_PER_SYMBOL) {
-        int sp = ((demod_buf_offset - demod_buf_len + 1) & (demod_buf_len - 1));
+    access_correlator.reset();
 
+    for (int i = 0; (i < num_symbol_left * SAMPLE_PER_SYMBOL) && (hit_idx == -1); i += SAMPLE_PER_SYMBOL) {
         for (int j = 0; j < SAMPLE_PER_SYMBOL; j++) {
             // Sample and compare with the adjacent next sample.
             int I0 = dst_buffer.p[i + j].real();
@@ -155,38 +139,13 @@ void BTLERxProcessor::handleBeginState() {
             int I1 = dst_buffer.p[i + j + 1].real();
             int Q1 = dst_buffer.p[i + j + 1].imag();
 
-            int phase_idx = j;
-
-            demod_buf_access[phase_idx][demod_buf_offset] = (I0 * Q1 - I1 * Q0) > 0 ? 1 : 0;
-
-            int k = sp;
-            unequal_flag = false;
+            const uint32_t bit = (I0 * Q1 - I1 * Q0) > 0 ? 1 : 0;
 
-            accesssAddress = 0;
-
-            for (int p = 0; p < demod_buf_len; p++) {
-                if (demod_buf_access[phase_idx][k] != accessAddrBits[p]) {
-                    unequal_flag = true;
-                    hit_idx = (-1);
-                    break;
-                }
-
-                accesssAddress = (accesssAddress & (~(1 << p))) | (demod_buf_access[phase_idx][k] << p);
-
-                k = ((k + 1) & (demod_buf_len - 1));
-            }
-
-            if (unequal_flag == false) {
-                hit_idx = (i + j - (demod_buf_len - 1) * SAMPLE_PER_SYMBOL);
+            if (access_correlator.execute(j, bit)) {
+                hit_idx = (i + j - first_compare_idx);
                 break;
             }
         }
-
-        if (unequal_flag == false) {
-            break;
-        }
-
-        demod_buf_offset = ((demod_buf_offset + 1) & (demod_buf_len - 1));
     }
 
     if (hit_idx == -1) {
@@ -372,6 +331,7 @@ void BTLERxProcessor::on_message(const Message* const message) {
 
 void BTLERxProcessor::configure(const BTLERxConfigureMessage& message) {
     channel_number = message.channel_number;
+    access_correlator.set_tolerance(message.access_address_tolerance);
     decim_0.configure(taps_BTLE_1M_PHY_decim_0.taps);
 
     configured = true;
@@ -33,6 +33,7 @@
 #include "dsp_demodulate.hpp"
 
 #include "audio_output.hpp"
+#include "btle_access_address.hpp"
 
 #include "fifo.hpp"
 #include "message.hpp"
@@ -113,6 +114,7 @@ class BTLERxProcessor : public BasebandProcessor {
     int rb_head{-1};
     int32_t g_threshold{0};
     uint8_t channel_number{37};
+    AccessAddressCorrelator<SAMPLE_PER_SYMBOL> access_correlator{DEFAULT_ACCESS_ADDR};
 
     uint16_t process = 0;
 
@@ -25,6 +25,7 @@
 
 #include "baseband_processor.hpp"
 #include "baseband_thread.hpp"
+#include "dsp_tx_synth.hpp"
 
 class FSKProcessor : public BasebandProcessor {
    public:
@@ -34,15 +35,14 @@ class FSKProcessor : public BasebandProcessor {
    private:
     bool configured = false;
 
-    uint32_t samples_per_bit{0};
     uint32_t length{0};
 
-    uint32_t shift_zero{}, shift_one{};
     uint32_t bit_pos{0};
     uint32_t progress_notice{}, progress_count{0};
-    uint8_t cur_bit{0};
-    uint32_t sample_count{0};
-    uint32_t phase{0}, sphase{0};
+
+    dsp::synth::FSKModulator<2> modulator{};
+
+    bool next_bit(uint8_t& bit);
 
     TXProgressMessage txprogress_message{};
 
@@ -28,6 +28,9 @@
 #include "event_m4.hpp"
 
 #include "utility.hpp"
+#include "packed_iq.hpp"
+
+#include <algorithm>
 
 GPSReplayProcessor::GPSReplayProcessor() {
     channel_filter_low_f = taps_200k_decim_1.low_frequency_normalized * 1000000;
@@ -47,23 +50,19 @@ void GPSReplayProcessor::execute(const buffer_c8_t& buffer) {
 
     if (!configured || !stream) return;
 
-    // File data is in C8 format, which is what we need
+    // File data is C8, or packed 2/4 bit components that cut the SD and
+    // shared RAM traffic. Either way it's read into the tail of the TX
+    // buffer and unpacked in place, there's no intermediate copy.
     // File samplerate is 2.6MHz, which is what we need
-    // To fill up the 2048-sample C8 buffer @ 2 bytes per sample = 4096 bytes
-    const size_t bytes_to_read = sizeof(*buffer.p) * 1 * (buffer.count);
-    size_t bytes_read_this_iteration = stream->read(iq_buffer.p, bytes_to_read);
-    size_t samples_read_this_iteration = bytes_read_this_iteration / sizeof(*buffer.p);
+    const size_t bytes_to_read = packed_iq::packed_size(buffer.count, bits);
+    auto packed = reinterpret_cast<uint8_t*>(buffer.p + buffer.count) - bytes_to_read;
+    size_t bytes_read_this_iteration = stream->read(packed, bytes_to_read);
+    size_t samples_read_this_iteration = packed_iq::unpack(packed, bytes_read_this_iteration, buffer.p, bits);
 
     bytes_read += bytes_read_this_iteration;
 
-    // NB: Couldn't we have just read the data into buffer.p to start with, or some DMA/cache coherency concern?
-    //
-    // for (size_t i = 0; i < buffer.count; i++) {
-    //     auto re_out = iq_buffer.p[i].real();
-    //     auto im_out = iq_buffer.p[i].imag();
-    //     buffer.p[i] = {(int8_t)re_out, (int8_t)im_out};
-    // }
-    memcpy(buffer.p, iq_buffer.p, bytes_read_this_iteration);  // memcpy should be more efficient than 1 byte at a time
+    // Don't transmit leftover packed bytes on underrun.
+    std::fill(buffer.p + samples_read_this_iteration, buffer.p + buffer.count, complex8_t{0, 0});
 
     spectrum_samples += samples_read_this_iteration;
     if (spectrum_samples >= spectrum_interval_samples) {
@@ -87,6 +86,13 @@ void GPSReplayProcessor::on_message(const Message* const message) {
             sample_rate_config(*reinterpret_cast<const SampleRateConfigMessage*>(message));
             break;
 
+        case Message::ID::ReplayPacking: {
+            const auto packing = reinterpret_cast<const ReplayPackingMessage*>(message)->bits;
+            if (packed_iq::is_valid_bits(packing))
+                bits = packing;
+            break;
+        }
+
         case Message::ID::ReplayConfig:
             configured = false;
             bytes_read = 0;
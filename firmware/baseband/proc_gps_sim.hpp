@@ -31,7 +31,6 @@
 
 #include "stream_output.hpp"
 
-#include <array>
 #include <memory>
 
 class GPSReplayProcessor : public BasebandProcessor {
@@ -45,12 +44,6 @@ class GPSReplayProcessor : public BasebandProcessor {
     size_t baseband_fs = 3072000;
     static constexpr auto spectrum_rate_hz = 50.0f;
 
-    std::array<complex8_t, 2048> iq{};
-    const buffer_c8_t iq_buffer{
-        iq.data(),
-        iq.size(),
-        baseband_fs};
-
     int32_t channel_filter_low_f = 0;
     int32_t channel_filter_high_f = 0;
     int32_t channel_filter_transition = 0;
@@ -63,6 +56,7 @@ class GPSReplayProcessor : public BasebandProcessor {
 
     bool configured{false};
     uint32_t bytes_read{0};
+    uint8_t bits{8};  // Per I/Q component of the stream.
 
     void sample_rate_config(const SampleRateConfigMessage& message);
     void replay_config(const ReplayConfigMessage& message);
@@ -27,9 +27,13 @@
 #include "audio_dma.hpp"
 
 #include "event_m4.hpp"
+#include "baseband_profiler.hpp"
 
 #include <cstdint>
 #include <cstddef>
+#include <algorithm>
+
+namespace profile = baseband::profile;
 
 void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
     // bool new_state;
@@ -39,58 +43,48 @@ void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
     }
 
     const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+    profile::mark(profile::Stage::Decim0);
+
+    // Before decim_1 overwrites dst_buffer.
+    channel_monitor.feed(decim_0_out, [](const ChannelMonitorMessage& message) {
+        shared_memory.application_queue.push(message);
+    });
+    profile::mark(profile::Stage::Other);
+
     const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
+    profile::mark(profile::Stage::Decim1);
 
     channel_spectrum.feed(decim_1_out, channel_filter_low_f, channel_filter_high_f, channel_filter_transition);
+    profile::mark(profile::Stage::Spectrum);
 
     const auto channel_out = channel_filter.execute(decim_1_out, dst_buffer);
+    profile::mark(profile::Stage::ChannelFilter);
 
     feed_channel_stats(channel_out);
+    profile::mark(profile::Stage::Other);
 
     if (!pitch_rssi_enabled) {
         // Normal mode, output demodulated audio
         auto audio = demod.execute(channel_out, audio_buffer);
+        profile::mark(profile::Stage::Demod);
+
         audio_output.write(audio);
+        profile::mark(profile::Stage::Audio);
 
         if (ctcss_detect_enabled) {
             /* 24kHz int16_t[16]
              * -> FIR filter, <300Hz pass, >300Hz stop, gain of 1
              * -> 12kHz int16_t[8]
+             * -> mean, 1.5kHz int16_t[1]
              *
              * Note we're only processing a small section of the wave each time this fn is called */
             auto audio_ctcss = ctcss_filter.execute(audio, work_audio_buffer);
 
-            // s16 to f32 for hpf
-            std::array<float, 8> audio_f;
-            for (size_t i = 0; i < audio_ctcss.count; i++) {
-                audio_f[i] = audio_ctcss.p[i] * ki;
-            }
-
-            hpf.execute_in_place(buffer_f32_t{
-                audio_f.data(),
-                audio_ctcss.count,
-                audio_ctcss.sampling_rate});
-
-            // Zero-crossing detection
+            int32_t sum = 0;
             for (size_t c = 0; c < audio_ctcss.count; c++) {
-                cur_sample = audio_f[c];
-                if (cur_sample * prev_sample < 0.0) {
-                    z_acc += z_timer;
-                    z_timer = 1;
-                    z_count++;
-                } else
-                    z_timer++;
-                prev_sample = cur_sample;
-            }
-
-            z_filter_count++;
-            if ((z_filter_count >= Z_MIN_FILTER_COUNT) && (z_count >= Z_MIN_ZERO_CROSSINGS)) {
-                ctcss_message.value = (100 * 12000 / 2 * z_count) / z_acc;
-                shared_memory.application_queue.push(ctcss_message);
-                z_filter_count = 0;
-                z_count = 0;
-                z_acc = 0;
+                sum += audio_ctcss.p[c];
             }
+            coded_squelch_execute(sum / static_cast<int32_t>(audio_ctcss.count));
         }
     } else {
         // Direction-finding mode; output tone with pitch related to RSSI
@@ -129,6 +123,10 @@ void NarrowbandFMAudio::on_message(const Message* const message) {
             pitch_rssi_config(*reinterpret_cast<const PitchRSSIConfigureMessage*>(message));
             break;
 
+        case Message::ID::ChannelMonitorConfig:
+            channel_monitor_config(*reinterpret_cast<const ChannelMonitorConfigMessage*>(message));
+            break;
+
         default:
             break;
     }
@@ -156,12 +154,39 @@ void NarrowbandFMAudio::configure(const NBFMConfigureMessage& message) {
     channel_spectrum.set_decimation_factor(1.0f);
     audio_output.configure(message.audio_hpf_config, message.audio_deemph_config, (float)message.squelch_level / 100.0);
 
-    hpf.configure(audio_24k_hpf_30hz_config);
     ctcss_filter.configure(taps_64_lp_025_025.taps);
+    ctcss_detector.configure(coded_squelch_fs);
+    dcs_decoder.configure(coded_squelch_fs);
 
     configured = true;
 }
 
+void NarrowbandFMAudio::coded_squelch_execute(const int32_t sample) {
+    // DC from a frequency offset would swamp the tones, track it over ~170 ms.
+    coded_squelch_dc += sample - (coded_squelch_dc >> 8);
+    const int16_t x = std::max<int32_t>(-32768, std::min<int32_t>(32767, sample - (coded_squelch_dc >> 8)));
+
+    ctcss_detector.execute(x);
+    dcs_decoder.execute(x);
+
+    if (++coded_squelch_count < coded_squelch_report_interval)
+        return;
+    coded_squelch_count = 0;
+
+    // A DCS word holds no tone, it is only locked while one is received.
+    if (dcs_decoder.locked()) {
+        const auto type = dcs_decoder.inverted() ? CodedSquelchMessage::Type::DCSInverted : CodedSquelchMessage::Type::DCS;
+        const CodedSquelchMessage message{dcs_decoder.code(), type, dcs_decoder.confidence()};
+        shared_memory.application_queue.push(message);
+    } else {
+        const auto detection = ctcss_detector.detect();
+        if (detection.confidence >= ctcss_min_confidence) {
+            const CodedSquelchMessage message{detection.tone_x100, CodedSquelchMessage::Type::CTCSS, detection.confidence};
+            shared_memory.application_queue.push(message);
+        }
+    }
+}
+
 void NarrowbandFMAudio::pitch_rssi_config(const PitchRSSIConfigureMessage& message) {
     pitch_rssi_enabled = message.enabled;
     tone_delta = (message.rssi + 1000) * ((1ULL << 32) / 24000);
@@ -175,6 +200,11 @@ void NarrowbandFMAudio::capture_config(const CaptureConfigMessage& message) {
     }
 }
 
+void NarrowbandFMAudio::channel_monitor_config(const ChannelMonitorConfigMessage& message) {
+    constexpr size_t decim_0_output_fs = baseband_fs / decim_0.decimation_factor;
+    channel_monitor.configure(message, decim_0_output_fs);
+}
+
 int main() {
     audio::dma::init_audio_out();
 
@@ -27,18 +27,16 @@
 #include "baseband_thread.hpp"
 #include "rssi_thread.hpp"
 
+#include "dsp_coded_squelch.hpp"
 #include "dsp_decimate.hpp"
 #include "dsp_demodulate.hpp"
-#include "dsp_iir.hpp"
 
 #include "audio_output.hpp"
+#include "channel_monitor.hpp"
 #include "spectrum_collector.hpp"
 
 #include <cstdint>
 
-#define Z_MIN_FILTER_COUNT 224
-#define Z_MIN_ZERO_CROSSINGS 20
-
 class NarrowbandFMAudio : public BasebandProcessor {
    public:
     void execute(const buffer_c8_t& buffer) override;
@@ -72,29 +70,31 @@ class NarrowbandFMAudio : public BasebandProcessor {
     int32_t channel_filter_high_f = 0;
     int32_t channel_filter_transition = 0;
 
-    // For CTCSS decoding
+    // For CTCSS and DCS decoding
+    static constexpr size_t coded_squelch_fs = 1500;
+    static constexpr size_t coded_squelch_report_interval = 128;  // Samples, about 85 ms
+    static constexpr uint8_t ctcss_min_confidence = 40;
     dsp::decimate::FIR64AndDecimateBy2Real ctcss_filter{};
-    IIRBiquadFilter hpf{};
+    dsp::CTCSSDetector ctcss_detector{};
+    dsp::DCSDecoder dcs_decoder{};
+    int32_t coded_squelch_dc{0};  // Q8
+    size_t coded_squelch_count{0};
 
     dsp::demodulate::FM demod{};
 
     AudioOutput audio_output{};
 
     SpectrumCollector channel_spectrum{};
+    ChannelMonitor channel_monitor{};
 
     uint32_t tone_phase{0};
     uint32_t tone_delta{0};
     bool pitch_rssi_enabled{false};
 
-    float cur_sample{}, prev_sample{};
-    uint32_t z_acc{0}, z_timer{0}, z_count{0}, z_filter_count{0};
     bool ctcss_detect_enabled{true};
-    static constexpr float k = 32768.0f;
-    static constexpr float ki = 1.0f / k;
 
     bool configured{false};
     // RequestSignalMessage sig_message { RequestSignalMessage::Signal::Squelched };
-    CodedSquelchMessage ctcss_message{0};
 
     /* NB: Threads should be the last members in the class definition. */
     BasebandThread baseband_thread{baseband_fs, this, baseband::Direction::Receive};
@@ -103,6 +103,8 @@ class NarrowbandFMAudio : public BasebandProcessor {
     void pitch_rssi_config(const PitchRSSIConfigureMessage& message);
     void configure(const NBFMConfigureMessage& message);
     void capture_config(const CaptureConfigMessage& message);
+    void coded_squelch_execute(const int32_t sample);
+    void channel_monitor_config(const ChannelMonitorConfigMessage& message);
 };
 
 #endif /*__PROC_NFM_AUDIO_H__*/
@@ -21,114 +21,90 @@
 
 #include "proc_spectrum_painter.hpp"
 #include "event_m4.hpp"
-#include "dsp_fft.hpp"
 #include "random.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <utility>
 
-// TODO move to class members SpectrumPainterProcessor
-std::unique_ptr<complex16_t[]> current_line_data;
-std::unique_ptr<complex16_t[]> next_line_data;
-uint32_t current_line_index = 0;
-uint32_t current_line_width = 0;
-int32_t current_bw = 0;
-
-std::vector<uint8_t> fifo_data[1 << SpectrumPainterBufferConfigureResponseMessage::fifo_k]{};
-SpectrumPainterFIFO fifo{fifo_data, SpectrumPainterBufferConfigureResponseMessage::fifo_k};
-
-int max_val = 127;
-
 // This is called at 3072000/2048 = 1500Hz
 void SpectrumPainterProcessor::execute(const buffer_c8_t& buffer) {
-    for (uint32_t i = 0; i < buffer.count; i++) {
-        if (current_line_data) {
-            auto data = current_line_data[(current_line_index++ * current_bw / 3072) % current_line_width];
-            buffer.p[i] = {(int8_t)data.real(), (int8_t)data.imag()};
-        } else
-            buffer.p[i] = {0, 0};
-    }
+    const int8_t next = ready;
 
-    // Move "next line" into "current line" if set.
-    if (next_line_data) {
-        current_line_data = std::move(next_line_data);
-        next_line_data.reset();
+    if ((line_width == 0) || ((playing < 0) && (next < 0))) {
+        std::fill(buffer.p, buffer.p + buffer.count, complex8_t{0, 0});
+        return;
     }
-}
-
-WORKING_AREA(thread_wa, 4096);
 
-void SpectrumPainterProcessor::run() {
-    int ui = 0;
-    init_genrand(22267);
+    if (next < 0) {
+        const auto& line = lines[playing];
+        for (uint32_t i = 0; i < buffer.count; i++) {
+            buffer.p[i] = line[index];
+            advance_index();
+        }
+        return;
+    }
 
-    while (true) {
-        if (fifo.is_empty() == false && !next_line_data) {
-            std::vector<uint8_t> data;
-            fifo.out(data);
+    // Overlap-add the next line over this buffer with a linear crossfade,
+    // a hard switch splatters across the band.
+    const auto& to = lines[next];
+    const complex8_t* from = (playing < 0) ? nullptr : lines[playing].data();
+    const int32_t fade_step = (1 << 16) / buffer.count;
+    int32_t fade = 0;
 
-            auto picture_width = data.size();
+    for (uint32_t i = 0; i < buffer.count; i++) {
+        const complex8_t a = from ? from[index] : complex8_t{0, 0};
+        const complex8_t b = to[index];
+        buffer.p[i] = {
+            (int8_t)((a.real() * ((1 << 16) - fade) + b.real() * fade) >> 16),
+            (int8_t)((a.imag() * ((1 << 16) - fade) + b.imag() * fade) >> 16)};
+        fade += fade_step;
+        advance_index();
+    }
 
-            auto fft_width = picture_width * 2;
-            auto qu = fft_width / 4;
+    playing = next;
+    ready = -1;
+}
 
-            // TODO: can these be statically allocated?
-            auto v = std::make_unique<complex16_t[]>(fft_width);
-            auto tmp = std::make_unique<complex16_t[]>(fft_width);
+void SpectrumPainterProcessor::synthesize(const SpectrumPainterLine& line, Line& out) {
+    // The picture spans the middle half of the spectrum, centered on DC.
+    const int32_t half_width = line_width / 2;
+    ifft_synth.clear(line_width * 2);
 
-            for (uint32_t fft_index = 0; fft_index < fft_width; fft_index++) {
-                if (fft_index < qu) {
-                } else if (fft_index < qu * 3) {
-                    // TODO: Improve index handling
-                    auto image_index = fft_index - qu;
+    for (uint32_t x = 0; x < line_width; x++) {
+        auto bin_power = (x < line.width) ? line.pixels[x] : 0;  // 0 to 255
+        auto bin_phase = genrand_int31();                          // 0 to 255
 
-                    auto bin_power = data[image_index];  // 0 to 255
-                    auto bin_phase = genrand_int31();    // 0 to 255
+        // rotate by random angle
+        auto phase_cos = (sine_table_i8[((int)(bin_phase + 0x40)) & 0xFF]);  // -127 to 127
+        auto phase_sin = (sine_table_i8[((int)(bin_phase)) & 0xFF]);
 
-                    // rotate by random angle
-                    auto phase_cos = (sine_table_i8[((int)(bin_phase + 0x40)) & 0xFF]);  // -127 to 127
-                    auto phase_sin = (sine_table_i8[((int)(bin_phase)) & 0xFF]);
+        auto real = (int16_t)((int16_t)phase_cos * bin_power / 255);  // -127 to 127
+        auto imag = (int16_t)((int16_t)phase_sin * bin_power / 255);  // -127 to 127
 
-                    auto real = (int16_t)((int16_t)phase_cos * bin_power / 255);  // -127 to 127
-                    auto imag = (int16_t)((int16_t)phase_sin * bin_power / 255);  // -127 to 127
+        ifft_synth.set_centered_bin((int32_t)x - half_width, {real, imag});
+    }
 
-                    auto fftshift_index = 0;
-                    if (fft_index < qu * 2)                   // first half (fft_index = qu; fft_index < qu*2)
-                        fftshift_index = fft_index + 2 * qu;  // goes to back
-                    else                                      // 2nd half (fft_index =  qu*2; fft_index < qu*3)
-                        fftshift_index = fft_index - 2 * qu;  // goes to front
+    ifft_synth.synthesize(out.data());
+}
 
-                    v[fftshift_index] = {real, imag};
-                }
-            }
+WORKING_AREA(thread_wa, 4096);
 
-            ifft<complex16_t>(v.get(), fft_width, tmp.get());
-
-            // normalize
-            int32_t maximum = 1;
-            for (uint32_t i = 0; i < fft_width; i++) {
-                if (v[i].real() > maximum)
-                    maximum = v[i].real();
-                if (v[i].real() < -maximum)
-                    maximum = -v[i].real();
-                if (v[i].imag() > maximum)
-                    maximum = v[i].imag();
-                if (v[i].imag() < -maximum)
-                    maximum = -v[i].imag();
-            }
+void SpectrumPainterProcessor::run() {
+    init_genrand(22267);
 
-            if (maximum == 1) {  // a black line
-                for (uint32_t i = 0; i < fft_width; i++)
-                    v[i] = {0, 0};
-            } else {
-                for (uint32_t i = 0; i < fft_width; i++) {
-                    v[i] = {(int8_t)((int32_t)v[i].real() * 120 / maximum), (int8_t)((int32_t)v[i].imag() * 120 / maximum)};
-                }
-            }
+    SpectrumPainterLine line{};
 
-            next_line_data = std::move(v);
-            ui++;
+    while (true) {
+        // execute() takes a ready line in one go, after that the slot not
+        // playing is free.
+        if (fifo.is_empty() == false && (ready < 0)) {
+            fifo.out(line);
+
+            const int8_t slot = (playing == 0) ? 1 : 0;
+            synthesize(line, lines[slot]);
+            ready = slot;
         } else {
             chThdSleepMilliseconds(1);
         }
@@ -139,10 +115,15 @@ void SpectrumPainterProcessor::on_message(const Message* const msg) {
     switch (msg->id) {
         case Message::ID::SpectrumPainterBufferRequestConfigure: {
             const auto message = *reinterpret_cast<const SpectrumPainterBufferConfigureRequestMessage*>(msg);
-            current_line_width = message.width;
-            current_bw = message.bw / 500;
+            const uint32_t bw = message.bw / 500;
+            index_step = bw / index_rate;
+            index_step_frac = bw % index_rate;
 
             if (message.update == false) {
+                line_width = std::min<uint32_t>(message.width, SpectrumPainterLine::max_width);
+                index = 0;
+                index_frac = 0;
+
                 SpectrumPainterBufferConfigureResponseMessage response{&fifo};
                 shared_memory.application_queue.push(response);
 
@@ -25,6 +25,9 @@
 #include "portapack_shared_memory.hpp"
 #include "baseband_processor.hpp"
 #include "baseband_thread.hpp"
+#include "dsp_tx_synth.hpp"
+
+#include <array>
 
 class SpectrumPainterProcessor : public BasebandProcessor {
    public:
@@ -33,8 +36,44 @@ class SpectrumPainterProcessor : public BasebandProcessor {
     void run();
 
    private:
+    static constexpr size_t max_fft_width = SpectrumPainterLine::max_width * 2;
+    static constexpr uint32_t index_rate = 3072;  // Line samples advance bw / index_rate per output sample.
+
+    using Line = std::array<complex8_t, max_fft_width>;
+
     bool configured{false};
 
+    std::array<SpectrumPainterLine, 1 << SpectrumPainterBufferConfigureResponseMessage::fifo_k> fifo_data{};
+    SpectrumPainterFIFO fifo{fifo_data.data(), SpectrumPainterBufferConfigureResponseMessage::fifo_k};
+
+    /* Line pool: one is playing while run() synthesizes the other, which
+     * execute() cross-fades in once ready. Indexes are -1 when unused. */
+    std::array<Line, 2> lines{};
+    volatile int8_t playing{-1};
+    volatile int8_t ready{-1};
+
+    dsp::synth::IFFTSynthesizer<max_fft_width> ifft_synth{};
+
+    // Phase accumulator over the line, in whole samples plus 1/index_rate.
+    uint32_t line_width{0};
+    uint32_t index{0};
+    uint32_t index_frac{0};
+    uint32_t index_step{0};
+    uint32_t index_step_frac{0};
+
+    void synthesize(const SpectrumPainterLine& line, Line& out);
+
+    void advance_index() {
+        index += index_step;
+        index_frac += index_step_frac;
+        if (index_frac >= index_rate) {
+            index_frac -= index_rate;
+            index++;
+        }
+        while (index >= line_width)
+            index -= line_width;
+    }
+
     /* NB: Threads should be the last members in the class definition. */
     BasebandThread baseband_thread{3072000, this, baseband::Direction::Transmit};
     Thread* thread{nullptr};
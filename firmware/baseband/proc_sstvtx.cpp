@@ -21,7 +21,6 @@
  */
 
 #include "proc_sstvtx.hpp"
-#include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 
 #include <cstdint>
@@ -38,7 +37,7 @@ void SSTVTXProcessor::execute(const buffer_c8_t& buffer) {
 
             if (state == STATE_CALIBRATION) {
                 // Once per picture
-                tone_delta = calibration_sequence[substep].first;
+                tone.set_delta(calibration_sequence[substep].first);
                 sample_count = calibration_sequence[substep].second;
                 if (substep == 2) {
                     substep = 0;
@@ -55,26 +54,26 @@ void SSTVTXProcessor::execute(const buffer_c8_t& buffer) {
                     // Do we have to transmit a start tone ?
                     if (current_scanline->start_tone.duration) {
                         state = STATE_SYNC;
-                        tone_delta = current_scanline->start_tone.frequency;
+                        tone.set_delta(current_scanline->start_tone.frequency);
                         sample_count = current_scanline->start_tone.duration;
                     } else {
                         state = STATE_PIXELS;
-                        tone_delta = current_scanline->gap_tone.frequency;
+                        tone.set_delta(current_scanline->gap_tone.frequency);
                         sample_count = current_scanline->gap_tone.duration;
                     }
                 } else {
-                    tone_delta = vis_code_sequence[substep];
+                    tone.set_delta(vis_code_sequence[substep]);
                     sample_count = SSTV_MS2S(30);  // A VIS code bit is 30ms
                     substep++;
                 }
             } else if (state == STATE_SYNC) {
                 // Once per scanline, optional
                 state = STATE_PIXELS;
-                tone_delta = current_scanline->gap_tone.frequency;
+                tone.set_delta(current_scanline->gap_tone.frequency);
                 sample_count = current_scanline->gap_tone.duration;
             } else if (state == STATE_PIXELS) {
                 // Many times per scanline
-                tone_delta = SSTV_F2D(1500 + ((current_scanline->luma[pixel_index] * 800) / 256));
+                tone.set_delta(SSTV_F2D(1500 + ((current_scanline->luma[pixel_index] * 800) / 256)));
                 sample_count = pixel_duration;
                 pixel_index++;
 
@@ -89,20 +88,8 @@ void SSTVTXProcessor::execute(const buffer_c8_t& buffer) {
             sample_count--;
         }
 
-        // Tone synth
-        tone_sample = (sine_table_i8[(tone_phase & 0xFF000000U) >> 24]);
-        tone_phase += tone_delta;
-
-        // FM
-        delta = tone_sample * fm_delta;
-
-        phase += delta;
-        sphase = phase + (64 << 24);
-
-        re = (sine_table_i8[(sphase & 0xFF000000U) >> 24]);
-        im = (sine_table_i8[(phase & 0xFF000000U) >> 24]);
-
-        buffer.p[i] = {re, im};
+        // Tone synth, FM
+        buffer.p[i] = fm.modulate(tone.next());
     }
 }
 
@@ -128,11 +115,11 @@ void SSTVTXProcessor::on_message(const Message* const msg) {
                 vis_code_sequence[c + 1] = ((vis_code >> c) & 1) ? SSTV_VIS_ONE : SSTV_VIS_ZERO;
             vis_code_sequence[9] = SSTV_VIS_SS;
 
-            fm_delta = 9000 * (0xFFFFFFULL / 3072000);  // Fixed bw for now
+            fm.set_fm_delta(dsp::synth::fm_delta(9000, 3072000));  // Fixed bw for now
 
             pixel_index = 0;
             sample_count = 0;
-            tone_phase = 0;
+            tone.reset();
             state = STATE_CALIBRATION;
             substep = 0;
 
@@ -21,7 +21,6 @@
  */
 
 #include "proc_tones.hpp"
-#include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 #include "audio_dma.hpp"
 
@@ -40,12 +39,10 @@ void TonesProcessor::execute(const buffer_c8_t& buffer) {
             silence_count--;
             if (!silence_count) {
                 sample_count = 0;
-                tone_a_phase = 0;
-                tone_b_phase = 0;
+                tones.reset();
             }
             tone_sample = 0;
-            re = 0;
-            im = 0;
+            buffer.p[i] = {0, 0};
         } else {
             if (!sample_count) {
                 digit = shared_memory.bb_data.tones_data.message[digit_pos];
@@ -66,10 +63,10 @@ void TonesProcessor::execute(const buffer_c8_t& buffer) {
                     sample_count = shared_memory.bb_data.tones_data.silence;
                 } else {
                     if (!dual_tone) {
-                        tone_a_delta = tone_deltas[digit];
+                        tones[0].set_delta(tone_deltas[digit]);
                     } else {
-                        tone_a_delta = tone_deltas[digit << 1];
-                        tone_b_delta = tone_deltas[(digit << 1) + 1];
+                        tones[0].set_delta(tone_deltas[digit << 1]);
+                        tones[1].set_delta(tone_deltas[(digit << 1) + 1]);
                     }
                     sample_count = tone_durations[digit];
                 }
@@ -81,26 +78,13 @@ void TonesProcessor::execute(const buffer_c8_t& buffer) {
             if ((digit >= 32) || (tone_deltas[digit] == 0)) {
                 tone_sample = 0;
             } else {
-                if (!dual_tone) {
-                    tone_sample = (sine_table_i8[(tone_a_phase & 0xFF000000U) >> 24]);
-                    tone_a_phase += tone_a_delta;
-                } else {
-                    tone_sample = sine_table_i8[(tone_a_phase & 0xFF000000U) >> 24] >> 1;
-                    tone_sample += sine_table_i8[(tone_b_phase & 0xFF000000U) >> 24] >> 1;
-
-                    tone_a_phase += tone_a_delta;
-                    tone_b_phase += tone_b_delta;
-                }
+                if (!dual_tone)
+                    tone_sample = tones[0].next();
+                else
+                    tone_sample = tones.next();
             }
 
-            // FM
-            delta = tone_sample * fm_delta;
-
-            phase += delta;
-            sphase = phase + (64 << 24);
-
-            re = (sine_table_i8[(sphase & 0xFF000000U) >> 24]);
-            im = (sine_table_i8[(phase & 0xFF000000U) >> 24]);
+            buffer.p[i] = fm.modulate(tone_sample);
         }
 
         // Headphone output sample generation: 1536000/24000 = 64
@@ -112,8 +96,6 @@ void TonesProcessor::execute(const buffer_c8_t& buffer) {
                 as--;
             }
         }
-
-        buffer.p[i] = {re, im};
     }
 
     if (audio_out) audio_output.write(audio_buffer);
@@ -130,7 +112,7 @@ void TonesProcessor::on_message(const Message* const p) {
                 tone_deltas[c] = shared_memory.bb_data.tones_data.tone_defs[c].delta;
                 tone_durations[c] = shared_memory.bb_data.tones_data.tone_defs[c].duration;
             }
-            fm_delta = message.fm_delta * (0xFFFFFFULL / 1536000);
+            fm.set_fm_delta(dsp::synth::fm_delta(message.fm_delta, 1536000));
             audio_out = message.audio_out;
             dual_tone = message.dual_tone;
 
@@ -141,8 +123,7 @@ void TonesProcessor::on_message(const Message* const p) {
 
             digit_pos = 0;
             sample_count = 0;
-            tone_a_phase = 0;
-            tone_b_phase = 0;
+            tones.reset();
             as = 0;
 
             configured = true;
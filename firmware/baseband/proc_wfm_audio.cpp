@@ -27,25 +27,32 @@
 #include "dsp_fft.hpp"
 #include "event_m4.hpp"
 #include "audio_dma.hpp"
+#include "baseband_profiler.hpp"
 
 #include <cstdint>
 
+namespace profile = baseband::profile;
+
 void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
     if (!configured) {
         return;
     }
 
     const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+    profile::mark(profile::Stage::Decim0);
     const auto channel = decim_1.execute(decim_0_out, dst_buffer);
+    profile::mark(profile::Stage::Decim1);
 
     // TODO: Feed channel_stats post-decimation data?
     feed_channel_stats(channel);
+    profile::mark(profile::Stage::Other);
 
     spectrum_samples += channel.count;
     if (spectrum_samples >= spectrum_interval_samples) {
         spectrum_samples -= spectrum_interval_samples;
         channel_spectrum.feed(channel, channel_filter_low_f, channel_filter_high_f, channel_filter_transition);
     }
+    profile::mark(profile::Stage::Spectrum);
 
     /* 384kHz complex<int16_t>[256]
      * -> FM demodulation
@@ -55,6 +62,7 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
      */
 
     auto audio_oversampled = demod.execute(channel, work_audio_buffer);
+    profile::mark(profile::Stage::Demod);
 
     /* 384kHz int16_t[256]
      * -> 4th order CIC decimation by 2, gain of 1
@@ -65,6 +73,7 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
      * -> 4th order CIC decimation by 2, gain of 1
      * -> 96kHz int16_t[64] */
     auto audio_2fs = audio_dec_2.execute(audio_4fs, work_audio_buffer);
+    profile::mark(profile::Stage::Decim2);
 
     // Input: 96kHz int16_t[64]
     // audio_spectrum_decimator piles up 256 samples before doing FFT computation
@@ -117,6 +126,7 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
         default:
             break;
     }
+    profile::mark(profile::Stage::Spectrum);
 
     /* 96kHz int16_t[64]
      * -> FIR filter, <15kHz (0.156fs) pass, >19kHz (0.198fs) stop, gain of 1
@@ -125,6 +135,7 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 
     /* -> 48kHz int16_t[32] */
     audio_output.write(audio);
+    profile::mark(profile::Stage::Audio);
 }
 
 void WidebandFMAudio::post_message(const buffer_c16_t& data) {
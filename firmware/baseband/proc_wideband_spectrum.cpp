@@ -23,38 +23,91 @@
 #include "audio_dma.hpp"
 
 #include "event_m4.hpp"
+#include "portapack_shared_memory.hpp"
+#include "sine_table.hpp"
 
 #include <cstdint>
 #include <cstddef>
 
 #include <array>
 
+WidebandSpectrum::WidebandSpectrum() {
+    // Presum window: a sinc one bin wide under a Hann window, spanning a
+    // whole buffer. Folded into 256 samples it gives flat, sharp bins.
+    constexpr float center = (buffer_samples - 1) / 2.0f;
+    const float bins = spectrum.size();
+    for (size_t i = 0; i < window.size(); i++) {
+        const float t = pi * (i - center) / bins;
+        const float sinc = sin_f32(t) / t;
+        const float hann = 0.5f - 0.5f * sin_f32(2 * pi * (i + 0.5f) / buffer_samples + pi / 2);
+        window[i] = sinc * hann * 32767.0f;
+    }
+
+    channel_spectrum.set_welch_mode(true);
+}
+
+void WidebandSpectrum::fold(const buffer_c8_t& buffer) {
+    // Window-presum: all samples of the buffer, windowed, summed into one
+    // 256 sample frame. The window is symmetric, the second half mirrors.
+    constexpr size_t half = buffer_samples / 2;
+    const size_t n = spectrum.size();
+
+    for (size_t i = 0; i < n; i++) {
+        int32_t re = 0;
+        int32_t im = 0;
+        for (size_t j = i; j < half; j += n) {
+            const int32_t w = window[j];
+            re += buffer.p[j].real() * w;
+            im += buffer.p[j].imag() * w;
+        }
+        for (size_t j = half + i; j < buffer_samples; j += n) {
+            const int32_t w = window[buffer_samples - 1 - j];
+            re += buffer.p[j].real() * w;
+            im += buffer.p[j].imag() * w;
+        }
+        // Q15 window, with 24 dB of gain left for the spectrum scale.
+        spectrum[i] = {static_cast<int16_t>(re >> 11), static_cast<int16_t>(im >> 11)};
+    }
+}
+
 void WidebandSpectrum::execute(const buffer_c8_t& buffer) {
     // 2048 complex8_t samples per buffer.
     // 102.4us per buffer. 20480 instruction cycles per buffer.
 
     if (!configured) return;
 
-    if (phase == 0) {
-        std::fill(spectrum.begin(), spectrum.end(), 0);
-    }
-
-    for (size_t i = 0; i < spectrum.size(); i++) {
-        // TODO: Removed window-presum windowing, due to lack of available code RAM.
-        // TODO: Apply window to improve spectrum bin sidelobes.
-        spectrum[i] += buffer.p[i + 0];
-        spectrum[i] += buffer.p[i + 1024];
+    if (sweep_enabled) {
+        // Only capture after a step, once the synthesizers have settled.
+        if (!sweep_capturing) return;
+        if (sweep_settle_remaining > 0) {
+            sweep_settle_remaining--;
+            return;
+        }
     }
 
-    if (phase == trigger) {
-        const buffer_c16_t buffer_c16{
+    // Welch average: each buffer the collector has room for becomes one frame,
+    // the collector averages their power until the end of the period.
+    if ((frames_fed < frames_per_spectrum_max) && channel_spectrum.frame_wanted()) {
+        fold(buffer);
+        const buffer_c16_t frame{
             spectrum.data(),
             spectrum.size(),
             buffer.sampling_rate};
-        channel_spectrum.feed(
-            buffer_c16,
-            0, 0, 0);
+        channel_spectrum.feed_frame(frame);
+        frames_fed++;
+    }
+
+    // A period ends with at least one frame in it.
+    if ((phase >= trigger) && ((frames_fed > 0) || !channel_spectrum.is_streaming())) {
+        channel_spectrum.request_publish();
         phase = 0;
+        frames_fed = 0;
+
+        if (sweep_enabled) {
+            sweep_capturing = false;
+            const SpectrumSweepCapturedMessage message{sweep_slice};
+            shared_memory.application_queue.push(message);
+        }
     } else {
         phase++;
     }
@@ -70,6 +123,23 @@ void WidebandSpectrum::on_beep_message(const AudioBeepMessage& message) {
     audio::dma::beep_start(message.freq, message.sample_rate, message.duration_ms);
 }
 
+void WidebandSpectrum::on_sweep_config_message(const SpectrumSweepConfigMessage& message) {
+    sweep_enabled = message.enabled;
+    sweep_settle_buffers = message.settle_buffers;
+    sweep_capturing = false;
+    phase = 0;
+    frames_fed = 0;
+}
+
+void WidebandSpectrum::on_sweep_step_message(const SpectrumSweepStepMessage& message) {
+    sweep_slice = message.slice;
+    sweep_settle_remaining = sweep_settle_buffers;
+    channel_spectrum.set_sweep_slice(sweep_slice);
+    phase = 0;
+    frames_fed = 0;
+    sweep_capturing = true;
+}
+
 void WidebandSpectrum::on_message(const Message* const msg) {
     switch (msg->id) {
         case Message::ID::RequestSignal:
@@ -80,6 +150,14 @@ void WidebandSpectrum::on_message(const Message* const msg) {
             on_beep_message(*reinterpret_cast<const AudioBeepMessage*>(msg));
             return;
 
+        case Message::ID::SpectrumSweepConfig:
+            on_sweep_config_message(*reinterpret_cast<const SpectrumSweepConfigMessage*>(msg));
+            return;
+
+        case Message::ID::SpectrumSweepStep:
+            on_sweep_step_message(*reinterpret_cast<const SpectrumSweepStepMessage*>(msg));
+            return;
+
         default:
             break;
     }
@@ -97,6 +175,7 @@ void WidebandSpectrum::on_message(const Message* const msg) {
             trigger = message.trigger;
             baseband_thread.set_sampling_rate(baseband_fs);
             phase = 0;
+            frames_fed = 0;
             configured = true;
             break;
 
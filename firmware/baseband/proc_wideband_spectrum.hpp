@@ -36,6 +36,8 @@
 
 class WidebandSpectrum : public BasebandProcessor {
    public:
+    WidebandSpectrum();
+
     void execute(const buffer_c8_t& buffer) override;
     void on_message(const Message* const message) override;
 
@@ -45,11 +47,28 @@ class WidebandSpectrum : public BasebandProcessor {
 
     void on_beep_message(const AudioBeepMessage& message);
     void on_signal_message(const RequestSignalMessage& message);
+    void on_sweep_config_message(const SpectrumSweepConfigMessage& message);
+    void on_sweep_step_message(const SpectrumSweepStepMessage& message);
+
+    void fold(const buffer_c8_t& buffer);
 
     SpectrumCollector channel_spectrum{};
 
+    static constexpr size_t buffer_samples = 2048;
+    /* Frames averaged into one spectrum at most, bounds the FFT load. */
+    static constexpr size_t frames_per_spectrum_max = 16;
+
     std::array<complex16_t, 256> spectrum{};
+    /* First half of the symmetric presum window, Q15. */
+    std::array<int16_t, buffer_samples / 2> window{};
     size_t phase = 0, trigger = 127;
+    size_t frames_fed = 0;
+
+    bool sweep_enabled = false;
+    bool sweep_capturing = false;
+    uint32_t sweep_slice = 0;
+    uint32_t sweep_settle_buffers = 0;
+    uint32_t sweep_settle_remaining = 0;
 
     /* NB: Threads should be the last members in the class definition. */
     BasebandThread baseband_thread{baseband_fs, this, baseband::Direction::Receive};
@@ -22,6 +22,7 @@
 #include "spectrum_collector.hpp"
 
 #include "dsp_fft.hpp"
+#include "dsp_spectrum_power.hpp"
 
 #include "utility.hpp"
 #include "event_m4.hpp"
@@ -46,6 +47,15 @@ void SpectrumCollector::on_message(const Message* const message) {
 
 void SpectrumCollector::set_state(const SpectrumStreamingConfigMessage& message) {
     if (message.mode == SpectrumStreamingConfigMessage::Mode::Running) {
+        fft_size_log2 = std::max(
+            SpectrumStreamingConfigMessage::fft_size_log2_min,
+            std::min(SpectrumStreamingConfigMessage::fft_size_log2_max, message.fft_size_log2));
+        window = message.window;
+        averaging = message.averaging;
+        average_count = (averaging == SpectrumStreamingConfigMessage::Averaging::None)
+                            ? 1
+                            : std::max<size_t>(1, message.average_count);
+        frames_accumulated = 0;
         start();
     } else {
         stop();
@@ -60,6 +70,7 @@ void SpectrumCollector::start() {
 
 void SpectrumCollector::stop() {
     streaming = false;
+    queued = false;
     fifo.reset_in();
 }
 
@@ -92,63 +103,171 @@ void SpectrumCollector::feed(
 
 void SpectrumCollector::post_message(const buffer_c16_t& data) {
     // Called from baseband processing thread.
-    if (streaming && !channel_spectrum_request_update) {
-        fft_swap(data, channel_spectrum);
-        channel_spectrum_sampling_rate = data.sampling_rate;
+    if (!streaming)
+        return;
+
+    if (!channel_spectrum_request_update) {
+        load(data.p, data.sampling_rate, sweep_slice);
         channel_spectrum_request_update = true;
         EventDispatcher::events_flag(EVT_MASK_SPECTRUM);
+    } else if (!queued) {
+        // The idle thread hasn't got to the previous frame yet, hold this one
+        // instead of dropping it. A third frame in that time is dropped.
+        std::copy(data.p, data.p + queued_frame.size(), queued_frame.begin());
+        queued_sampling_rate = data.sampling_rate;
+        queued_sweep_slice = sweep_slice;
+        queued = true;
     }
 }
 
-template <typename T>
-static typename T::value_type spectrum_window_none(const T& s, const size_t i) {
-    constexpr size_t length = sizeof(s) / sizeof(s[0]);
-    static_assert(power_of_two(length), "Array length must be power of 2");
-    return s[i];
-};
-
-template <typename T>
-static typename T::value_type spectrum_window_hamming_3(const T& s, const size_t i) {
-    constexpr size_t length = sizeof(s) / sizeof(s[0]);
-    static_assert((length), "Array length must be power of 2");
-    constexpr size_t mask = length - 1;
-    // Three point Hamming window.
-    return s[i] * 0.54f + (s[(i - 1) & mask] + s[(i + 1) & mask]) * -0.23f;
-};
-
-template <typename T>
-static typename T::value_type spectrum_window_blackman_3(const T& s, const size_t i) {
-    constexpr size_t length = sizeof(s) / sizeof(s[0]);
-    static_assert(power_of_two(length), "Array length must be power of 2");
-    constexpr size_t mask = length - 1;
-    // Three term Blackman window.
-    constexpr float alpha = 0.42f;
-    constexpr float beta = 0.5f * 0.5f;
-    constexpr float gamma = 0.08f * 0.05f;
-    return s[i] * alpha - (s[(i - 1) & mask] + s[(i + 1) & mask]) * beta + (s[(i - 2) & mask] + s[(i + 2) & mask]) * gamma;
-};
+void SpectrumCollector::load(const complex16_t* const data, const uint32_t sampling_rate, const uint32_t slice) {
+    const size_t log2_n = welch_mode ? SpectrumStreamingConfigMessage::fft_size_log2_max : fft_size_log2;
+    const size_t mask = (1 << log2_n) - 1;
+    for (size_t i = 0; i < channel_spectrum.size(); i++) {
+        const size_t i_rev = (i & ~mask) | (__RBIT(i & mask) >> (32 - log2_n));
+        const auto s = data[i];
+        channel_spectrum[i_rev] = {
+            static_cast<float>(s.real()),
+            static_cast<float>(s.imag())};
+    }
+    channel_spectrum_fft_size_log2 = log2_n;
+    channel_spectrum_sampling_rate = sampling_rate;
+    channel_spectrum_sweep_slice = slice;
+}
 
 void SpectrumCollector::update() {
     // Called from idle thread (after EVT_MASK_SPECTRUM is flagged)
-    if (streaming && channel_spectrum_request_update) {
-        /* Decimated buffer is full. Compute spectrum. */
-        fft_c_preswapped(channel_spectrum, 0, 8);
-
-        ChannelSpectrum spectrum;
-        spectrum.sampling_rate = channel_spectrum_sampling_rate;
-        spectrum.channel_filter_low_frequency = channel_filter_low_frequency;
-        spectrum.channel_filter_high_frequency = channel_filter_high_frequency;
-        spectrum.channel_filter_transition = channel_filter_transition;
-        for (size_t i = 0; i < spectrum.db.size(); i++) {
-            const auto corrected_sample = spectrum_window_hamming_3(channel_spectrum, i);
-            const auto mag2 = magnitude_squared(corrected_sample * (1.0f / 32768.0f));
-            const float db = mag2_to_dbv_norm(mag2);
-            constexpr float mag_scale = 5.0f;
-            const unsigned int v = (db * mag_scale) + 255.0f;
-            spectrum.db[i] = std::max(0U, std::min(255U, v));
+    while (streaming) {
+        // The baseband thread sets the flags, take them together.
+        chSysLock();
+        const bool frame_pending = channel_spectrum_request_update;
+        const bool publish_due = publish_requested && (publish_frames == 0);
+        if (publish_due)
+            publish_requested = false;
+        chSysUnlock();
+
+        if (publish_due)
+            publish_pending();
+        if (!frame_pending)
+            break;
+
+        transform();
+
+        // Hand over under lock, post_message() must not see the slot empty
+        // while the request is still set.
+        chSysLock();
+        if (publish_requested && (publish_frames > 0))
+            publish_frames--;
+        if (queued) {
+            load(queued_frame.data(), queued_sampling_rate, queued_sweep_slice);
+            queued = false;
+        } else {
+            channel_spectrum_request_update = false;
+        }
+        chSysUnlock();
+    }
+
+    if (!streaming) {
+        channel_spectrum_request_update = false;
+        queued = false;
+        publish_requested = false;
+    }
+}
+
+void SpectrumCollector::transform() {
+    /* Decimated buffer is full. Compute the spectrum of each frame in it. */
+    const size_t log2_n = channel_spectrum_fft_size_log2;
+    const size_t n = 1 << log2_n;
+    for (size_t offset = 0; offset < channel_spectrum.size(); offset += n) {
+        auto frame = &channel_spectrum[offset];
+        fft_c_preswapped(frame, n, 0, log2_n);
+        accumulate(frame, log2_n);
+
+        if ((++frames_accumulated >= average_count) && !welch_mode) {
+            publish(log2_n);
+            frames_accumulated = 0;
+        }
+    }
+}
+
+void SpectrumCollector::publish_pending() {
+    if (streaming && (frames_accumulated > 0)) {
+        publish(channel_spectrum_fft_size_log2);
+        frames_accumulated = 0;
+    }
+}
+
+void SpectrumCollector::request_publish() {
+    // Called from baseband processing thread.
+    // The frames posted so far go into this publish, later ones into the next.
+    publish_frames = (channel_spectrum_request_update ? 1 : 0) + (queued ? 1 : 0);
+    publish_requested = true;
+    EventDispatcher::events_flag(EVT_MASK_SPECTRUM);
+}
+
+void SpectrumCollector::accumulate(const std::complex<float>* const frame, const size_t log2_n) {
+    using Averaging = SpectrumStreamingConfigMessage::Averaging;
+    using Window = SpectrumStreamingConfigMessage::Window;
+
+    const size_t n = 1 << log2_n;
+    const size_t mask = n - 1;
+    auto window_q15 = dsp::spectrum::window_hamming;
+    if (window == Window::Blackman)
+        window_q15 = dsp::spectrum::window_blackman;
+    else if ((window == Window::None) || welch_mode)
+        window_q15 = dsp::spectrum::window_none;
+    // Bins to Q15, shorter FFTs are scaled up so a tone reads the same level at every size.
+    const float scale = 1 << (SpectrumStreamingConfigMessage::fft_size_log2_max - log2_n);
+    const bool first = (frames_accumulated == 0);
+
+    for (size_t i = 0; i < n; i++) {
+        const auto power = dsp::spectrum::window_mag2(frame, i, mask, scale, window_q15);
+        auto& bin = accumulator[i];
+
+        switch (averaging) {
+            case Averaging::Log: {
+                const auto log2_power = dsp::spectrum::power_log2(power);
+                bin = first ? log2_power : bin + log2_power;
+                break;
+            }
+            case Averaging::PeakHold:
+                bin = first ? power : std::max(bin, power);
+                break;
+            case Averaging::MinHold:
+                bin = first ? power : std::min(bin, power);
+                break;
+            default:
+                // Powers saturate at 2^24, 255 frames can't overflow.
+                bin = first ? power : bin + power;
+                break;
         }
-        fifo.in(spectrum);
     }
+}
 
-    channel_spectrum_request_update = false;
+void SpectrumCollector::publish(const size_t log2_n) {
+    using Averaging = SpectrumStreamingConfigMessage::Averaging;
+
+    ChannelSpectrum spectrum;
+    spectrum.sampling_rate = channel_spectrum_sampling_rate;
+    spectrum.channel_filter_low_frequency = channel_filter_low_frequency;
+    spectrum.channel_filter_high_frequency = channel_filter_high_frequency;
+    spectrum.channel_filter_transition = channel_filter_transition;
+    spectrum.sweep_slice = channel_spectrum_sweep_slice;
+
+    // Without averaging there is one frame, unless in Welch mode.
+    const bool mean = (averaging != Averaging::PeakHold) && (averaging != Averaging::MinHold);
+    const uint32_t divisor = mean ? frames_accumulated : 1;
+    // Each bin of a shorter FFT covers several display bins.
+    static_assert(std::tuple_size<decltype(spectrum.db)>::value == 1 << SpectrumStreamingConfigMessage::fft_size_log2_max, "");
+    const size_t bins_per_bin_log2 = SpectrumStreamingConfigMessage::fft_size_log2_max - log2_n;
+    const size_t n = 1 << log2_n;
+
+    for (size_t i = 0; i < n; i++) {
+        const uint32_t value = (divisor == 1) ? accumulator[i] : accumulator[i] / divisor;
+        const uint8_t db = (averaging == Averaging::Log)
+                               ? dsp::spectrum::log2_to_db_byte(value)
+                               : dsp::spectrum::power_to_db_byte(value);
+        std::fill_n(&spectrum.db[i << bins_per_bin_log2], 1 << bins_per_bin_log2, db);
+    }
+    fifo.in(spectrum);
 }
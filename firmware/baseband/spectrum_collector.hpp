@@ -41,32 +41,69 @@ class SpectrumCollector {
 
     void set_decimation_factor(const size_t decimation_factor);
 
+    /* Tag for the spectra computed from the next feed(). */
+    void set_sweep_slice(const uint32_t slice) { sweep_slice = slice; }
+
     void feed(
         const buffer_c16_t& channel,
         const int32_t filter_low_frequency,
         const int32_t filter_high_frequency,
         const int32_t filter_transition);
 
+    /* Welch mode: the processor feeds whole 256 sample frames, already
+     * windowed, whenever frame_wanted(). Their mean power is published
+     * once request_publish() is called. */
+    void set_welch_mode(const bool enabled) { welch_mode = enabled; }
+    bool is_streaming() const { return streaming; }
+    bool frame_wanted() const { return streaming && !queued; }
+    void feed_frame(const buffer_c16_t& frame) { post_message(frame); }
+    void request_publish();
+
    private:
     BlockDecimator<complex16_t, 256> channel_spectrum_decimator{1};
     ChannelSpectrum fifo_data[1 << ChannelSpectrumConfigMessage::fifo_k]{};
     ChannelSpectrumFIFO fifo{fifo_data, ChannelSpectrumConfigMessage::fifo_k};
 
     volatile bool channel_spectrum_request_update{false};
+    volatile bool publish_requested{false};
+    /* One frame posted while the previous one waits for its FFT. */
+    volatile bool queued{false};
+    /* Frames still to transform before the requested publish. */
+    volatile size_t publish_frames{0};
     bool streaming{false};
+    bool welch_mode{false};
+    /* Holds 256 / FFT size frames back to back, each bit reversed on its own. */
     std::array<std::complex<float>, 256> channel_spectrum{};
+    size_t channel_spectrum_fft_size_log2{SpectrumStreamingConfigMessage::fft_size_log2_max};
+    /* Q24 power (Q8 log2 power for log averaging) per bin, reduced over frames_accumulated frames. */
+    std::array<uint32_t, 256> accumulator{};
+    size_t frames_accumulated{0};
+    size_t fft_size_log2{SpectrumStreamingConfigMessage::fft_size_log2_max};
+    SpectrumStreamingConfigMessage::Window window{SpectrumStreamingConfigMessage::Window::Hamming};
+    SpectrumStreamingConfigMessage::Averaging averaging{SpectrumStreamingConfigMessage::Averaging::None};
+    size_t average_count{1};
     uint32_t channel_spectrum_sampling_rate{0};
     int32_t channel_filter_low_frequency{0};
     int32_t channel_filter_high_frequency{0};
     int32_t channel_filter_transition{0};
+    uint32_t sweep_slice{0};
+    uint32_t channel_spectrum_sweep_slice{0};
+    std::array<complex16_t, 256> queued_frame{};
+    uint32_t queued_sampling_rate{0};
+    uint32_t queued_sweep_slice{0};
 
     void post_message(const buffer_c16_t& data);
+    void load(const complex16_t* const data, const uint32_t sampling_rate, const uint32_t slice);
 
     void set_state(const SpectrumStreamingConfigMessage& message);
     void start();
     void stop();
 
     void update();
+    void transform();
+    void publish_pending();
+    void accumulate(const std::complex<float>* const frame, const size_t log2_n);
+    void publish(const size_t log2_n);
 };
 
 #endif /*__SPECTRUM_COLLECTOR_H__*/
@@ -32,6 +32,12 @@
 namespace baseband {
 namespace ais {
 
+// Channels 87B (161.975MHz) and 88B (162.025MHz), received together
+// around center_frequency.
+constexpr uint32_t center_frequency = 162000000;
+constexpr size_t channel_count = 2;
+constexpr std::array<int32_t, channel_count> channel_offsets{{-25000, 25000}};
+
 // Translate+Rectangular window filter
 // sample=38.4k, deviation=2400, symbol=9600
 // Length: 4 taps, 1 symbol, 1/4 cycle of sinusoid
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __BASEBAND_PROFILE_H__
+#define __BASEBAND_PROFILE_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace baseband {
+namespace profile {
+
+/* Processing stages a processor can attribute M4 cycles to.
+ * Cycles not claimed by any stage are reported as Other. */
+enum class Stage : uint8_t {
+    Decim0 = 0,
+    Decim1,
+    Decim2,
+    ChannelFilter,
+    Demod,
+    Audio,
+    Spectrum,
+    Other,
+    Count,
+};
+
+constexpr size_t stage_count = static_cast<size_t>(Stage::Count);
+
+constexpr const char* stage_names[stage_count]{
+    "decim_0",
+    "decim_1",
+    "decim_2",
+    "channel",
+    "demod",
+    "audio",
+    "spectrum",
+    "other",
+};
+
+inline const char* stage_name(const size_t stage) {
+    return (stage < stage_count) ? stage_names[stage] : "?";
+}
+
+/* Cycle counts per baseband buffer, published by the M4 a couple of times
+ * a second while profiling is requested. */
+struct Snapshot {
+    uint32_t sequence{0};       // Odd while the M4 is writing.
+    uint32_t sampling_rate{0};  // Of the buffers, in Hz.
+    uint32_t buffers{0};        // Buffers averaged in this snapshot.
+    uint32_t budget{0};         // Cycles available per buffer.
+    uint32_t total_average{0};
+    uint32_t total_peak{0};
+    std::array<uint32_t, stage_count> average{};
+    std::array<uint32_t, stage_count> peak{};
+
+    /* Percentage of the budget, for display. */
+    uint32_t percent(const uint32_t cycles) const {
+        return budget ? static_cast<uint32_t>((uint64_t)cycles * 100 / budget) : 0;
+    }
+};
+
+/* Copies a snapshot the other core may be writing.
+ * Returns false if there is none yet or it changed during the copy. */
+inline bool read(const Snapshot& src, Snapshot& dst) {
+    const volatile uint32_t& sequence = src.sequence;
+    const uint32_t before = sequence;
+    __sync_synchronize();
+    dst = src;
+    __sync_synchronize();
+    return (before != 0) && ((before & 1) == 0) && (before == sequence);
+}
+
+} /* namespace profile */
+} /* namespace baseband */
+
+#endif /*__BASEBAND_PROFILE_H__*/
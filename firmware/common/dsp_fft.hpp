@@ -97,14 +97,14 @@ void fft_swap_in_place(std::array<T, N>& data) {
 /* http://beige.ucs.indiana.edu/B673/node14.html */
 /* http://www.drdobbs.com/cpp/a-simple-and-efficient-fft-implementatio/199500857?pgno=3 */
 
-template <typename T, size_t N>
-void fft_c_preswapped(std::array<T, N>& data, const size_t from, const size_t to) {
-    static_assert(power_of_two(N), "only defined for N == power of two");
-    constexpr auto K = log_2(N);
+/* Runtime length variant, n must be a power of two no larger than 256. */
+template <typename T>
+void fft_c_preswapped(T* const data, const size_t n, const size_t from, const size_t to) {
+    const auto K = log_2(n);
     if ((to > K) || (from > K)) return;
 
     constexpr size_t K_max = 8;
-    static_assert(K <= K_max, "No FFT twiddle factors for K > 8");
+    if (K > K_max) return;
     static constexpr std::array<std::complex<float>, K_max> wp_table{{
         {-2.0f, 0.0f},                                             // 2
         {-1.0f, -1.0f},                                            // 4
@@ -122,7 +122,7 @@ void fft_c_preswapped(std::array<T, N>& data, const size_t from, const size_t to
         const auto wp = wp_table[k];
         T w{1.0f, 0.0f};
         for (size_t m = 0; m < mmax; ++m) {
-            for (size_t i = m; i < N; i += mmax * 2) {
+            for (size_t i = m; i < n; i += mmax * 2) {
                 const size_t j = i + mmax;
                 const T temp = w * data[j];
                 data[j] = data[i] - temp;
@@ -133,6 +133,13 @@ void fft_c_preswapped(std::array<T, N>& data, const size_t from, const size_t to
     }
 }
 
+template <typename T, size_t N>
+void fft_c_preswapped(std::array<T, N>& data, const size_t from, const size_t to) {
+    static_assert(power_of_two(N), "only defined for N == power of two");
+    static_assert(log_2(N) <= 8, "No FFT twiddle factors for K > 8");
+    fft_c_preswapped(data.data(), N, from, to);
+}
+
 /*
    ifft(v,N):
    [0] If N==1 then return.
@@ -23,6 +23,8 @@
 
 #include <hal.h>
 
+#include <algorithm>
+
 void IIRBiquadFilter::configure(const iir_biquad_config_t& new_config) {
     config = new_config;
 }
@@ -55,6 +57,55 @@ void IIRBiquadFilter::execute_in_place(const buffer_f32_t& buffer) {
     execute(buffer, buffer);
 }
 
+void IIRBiquadFilterQ15::configure(const iir_biquad_config_t& new_config) {
+    const IIRBiquadFilterQ15 converted{new_config};
+    b = converted.b;
+    a = converted.a;
+}
+
+void IIRBiquadFilterQ15::execute(const buffer_s16_t& buffer_in, const buffer_s16_t& buffer_out) {
+    constexpr int32_t state_max = (1 << 30) - 1;
+    constexpr int32_t state_min = -(1 << 30);
+    constexpr int64_t round = int64_t(1) << (coef_bits - 1);
+
+    const auto b_ = b;
+    const auto a_ = a;
+
+    auto x1 = x[0];
+    auto x2 = x[1];
+    auto y1 = y[0];
+    auto y2 = y[1];
+
+    for (size_t i = 0; i < buffer_out.count; i++) {
+        const int32_t x0 = static_cast<int32_t>(buffer_in.p[i]) << state_bits;
+
+        int64_t acc = round;
+        acc += static_cast<int64_t>(b_[0]) * x0;
+        acc += static_cast<int64_t>(b_[1]) * x1;
+        acc += static_cast<int64_t>(b_[2]) * x2;
+        acc -= static_cast<int64_t>(a_[0]) * y1;
+        acc -= static_cast<int64_t>(a_[1]) * y2;
+
+        // Clamp the history so an unstable transient can't wrap around.
+        const int32_t y0 = std::max<int64_t>(std::min<int64_t>(acc >> coef_bits, state_max), state_min);
+
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = y0;
+
+        const int32_t out = (y0 + (1 << (state_bits - 1))) >> state_bits;
+        buffer_out.p[i] = std::max<int32_t>(std::min<int32_t>(out, 32767), -32768);
+    }
+
+    x = {x1, x2};
+    y = {y1, y2};
+}
+
+void IIRBiquadFilterQ15::execute_in_place(const buffer_s16_t& buffer) {
+    execute(buffer, buffer);
+}
+
 void IIRBiquadDF2Filter::configure(const iir_biquad_df2_config_t& config) {
     b0 = config[0] / config[3];
     b1 = config[1] / config[3];
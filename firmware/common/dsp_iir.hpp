@@ -68,6 +68,42 @@ class IIRBiquadFilter {
     std::array<float, 3> y{{0.0f, 0.0f, 0.0f}};
 };
 
+/* Fixed-point counterpart of IIRBiquadFilter for Q15 audio.
+ * Coefficients are Q28 (|c| < 8) and the history is kept in Q23 so that
+ * low cut-off filters do not lose their tail to truncation. Products are
+ * accumulated in 64 bits, which maps onto SMLAL on the M4.
+ */
+class IIRBiquadFilterQ15 {
+   public:
+    constexpr IIRBiquadFilterQ15()
+        : IIRBiquadFilterQ15(iir_config_no_pass) {
+    }
+
+    constexpr IIRBiquadFilterQ15(
+        const iir_biquad_config_t& config)
+        : b{{to_q28(config.b[0]), to_q28(config.b[1]), to_q28(config.b[2])}},
+          a{{to_q28(config.a[1]), to_q28(config.a[2])}} {
+    }
+
+    void configure(const iir_biquad_config_t& new_config);
+
+    void execute(const buffer_s16_t& buffer_in, const buffer_s16_t& buffer_out);
+    void execute_in_place(const buffer_s16_t& buffer);
+
+   private:
+    static constexpr size_t coef_bits = 28;
+    static constexpr size_t state_bits = 8;  // Fraction bits below Q15.
+
+    std::array<int32_t, 3> b;
+    std::array<int32_t, 2> a;
+    std::array<int32_t, 2> x{{0, 0}};
+    std::array<int32_t, 2> y{{0, 0}};
+
+    static constexpr int32_t to_q28(const float c) {
+        return static_cast<int32_t>(c * (1 << coef_bits) + ((c < 0.0f) ? -0.5f : 0.5f));
+    }
+};
+
 class IIRBiquadDF2Filter {
    public:
     void configure(const iir_biquad_df2_config_t& config);
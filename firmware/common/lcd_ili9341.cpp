@@ -32,6 +32,7 @@ using namespace portapack;
 
 #include "file.hpp"
 
+#include <algorithm>
 #include <complex>
 
 #include <cstring>
@@ -683,6 +684,96 @@ void ILI9341::draw_glyph(
     draw_bitmap(p, glyph.size(), glyph.pixels(), foreground, background);
 }
 
+namespace {
+
+/* Pixel row of a glyph bitmap, LSB is the leftmost pixel. Bitmaps are packed
+ * LSB first and rows are not padded to a byte boundary. */
+inline uint32_t glyph_row_bits(
+    const uint8_t* const pixels,
+    const size_t width,
+    const size_t row) {
+    // 8x16 font: a byte per row.
+    if (width == 8)
+        return pixels[row];
+
+    // Narrower fonts (5x8): a row spans at most two bytes.
+    const size_t bit = row * width;
+    const size_t first = bit >> 3;
+    const size_t shift = bit & 7;
+    const size_t bytes = (shift + width + 7) >> 3;
+
+    uint64_t bits = 0;
+    for (size_t i = 0; i < bytes; i++)
+        bits |= static_cast<uint64_t>(pixels[first + i]) << (i * 8);
+
+    return (bits >> shift) & ((1ULL << width) - 1);
+}
+
+} /* namespace */
+
+void ILI9341::draw_glyph_run(
+    const ui::Point p,
+    const ui::Size glyph_size,
+    const uint8_t* const* glyphs,
+    const ui::Color* pens,
+    const size_t count,
+    const ui::Color background) {
+    const int glyph_width = glyph_size.width();
+    const int glyph_height = glyph_size.height();
+    const int run_width = std::min<int>(glyph_width * count, width() - p.x());
+
+    // Off-screen runs go through the per glyph path, which has always left
+    // the clipping to the controller.
+    if ((p.x() < 0) || (p.y() < 0) || (p.y() + glyph_height > height()) || (glyph_width > 32)) {
+        for (size_t n = 0; n < count; n++)
+            draw_bitmap({p.x() + glyph_width * static_cast<int>(n), p.y()}, glyph_size, glyphs[n], pens[n], background);
+        return;
+    }
+    if (run_width <= 0)
+        return;
+
+    const bool transparent = (ui::Color::magenta().v == background.v);
+    ui::Color line_buffer[ui::screen_width];
+
+    if (!transparent)
+        lcd_start_ram_write(p, {run_width, glyph_height});
+
+    for (int row = 0; row < glyph_height; row++) {
+        ui::Color* out = line_buffer;
+        int remaining = run_width;
+
+        for (size_t n = 0; (n < count) && (remaining > 0); n++) {
+            const auto pen = pens[n];
+            auto bits = glyph_row_bits(glyphs[n], glyph_width, row);
+            const int columns = std::min(glyph_width, remaining);
+            for (int x = 0; x < columns; x++) {
+                *(out++) = (bits & 1) ? pen : background;
+                bits >>= 1;
+            }
+            remaining -= columns;
+        }
+
+        if (!transparent) {
+            io.lcd_write_pixels(line_buffer, run_width);
+            continue;
+        }
+
+        // Write each span of same colored set pixels.
+        for (int x = 0; x < run_width;) {
+            const auto color = line_buffer[x];
+            int end = x + 1;
+            while ((end < run_width) && (line_buffer[end].v == color.v))
+                end++;
+
+            if (color.v != background.v) {
+                lcd_start_ram_write({p.x() + x, p.y() + row}, {end - x, 1});
+                io.lcd_write_pixels(color, end - x);
+            }
+            x = end;
+        }
+    }
+}
+
 void ILI9341::scroll_set_area(
     const ui::Coord top_y,
     const ui::Coord bottom_y) {
@@ -94,6 +94,22 @@ class ILI9341 {
         const ui::Color foreground,
         const ui::Color background);
 
+    /* Most glyphs in a run, a screen line of the narrowest (5x8) font. */
+    static constexpr size_t glyph_run_max = ui::screen_width / 5;
+
+    /* Draws count glyphs of glyph_size side by side, each in its own pen.
+     * The run is rasterized a pixel row at a time into a line buffer and
+     * written in a single RAM write window. With a transparent background
+     * (magenta) only the spans of set pixels are written.
+     * Pixels beyond the right edge of the screen are dropped. */
+    void draw_glyph_run(
+        const ui::Point p,
+        const ui::Size glyph_size,
+        const uint8_t* const* glyphs,
+        const ui::Color* pens,
+        const size_t count,
+        const ui::Color background);
+
     /*** Scrolling ***
      * Scrolling support is implemented in the ILI9341 driver. Basically a region
      * of the screen is set up to act as a circular buffer. The VSA (vertical scroll
@@ -127,6 +127,12 @@ class Message {
         FreqChangeCommand = 70,
         I2CDevListChanged = 71,
         LightData = 72,
+        SpectrumSweepConfig = 73,
+        SpectrumSweepStep = 74,
+        SpectrumSweepCaptured = 75,
+        ChannelMonitorConfig = 76,
+        ChannelMonitor = 77,
+        ReplayPacking = 78,
         MAX
     };
 
@@ -198,6 +204,50 @@ class ChannelStatisticsMessage : public Message {
     ChannelStatistics statistics;
 };
 
+/* Narrow channels watched inside the tuning window, as offsets from the
+ * tuned frequency. A channel_count of 0 stops the monitor. */
+class ChannelMonitorConfigMessage : public Message {
+   public:
+    static constexpr size_t max_channels = 32;
+    /* The first decimation filter droops under 1 dB up to here, further out it
+     * attenuates (-6.6 dB at 150 kHz) and aliases near 192 kHz. Channels beyond
+     * this offset are ignored. */
+    static constexpr int32_t max_offset = 50000;
+
+    constexpr ChannelMonitorConfigMessage(
+        const std::array<int32_t, max_channels>& offsets = {},
+        uint8_t channel_count = 0,
+        uint32_t bandwidth = 12500,
+        int32_t squelch_db = -30,
+        uint8_t sequence = 0)
+        : Message{ID::ChannelMonitorConfig},
+          offsets{offsets},
+          channel_count{channel_count},
+          bandwidth{bandwidth},
+          squelch_db{squelch_db},
+          sequence{sequence} {
+    }
+
+    std::array<int32_t, max_channels> offsets;
+    uint8_t channel_count;
+    uint32_t bandwidth;
+    int32_t squelch_db;
+    uint8_t sequence;  // Echoed in reports, to drop those of a previous window.
+};
+
+/* Mean power of each monitored channel over one report period. */
+class ChannelMonitorMessage : public Message {
+   public:
+    constexpr ChannelMonitorMessage()
+        : Message{ID::ChannelMonitor} {
+    }
+
+    std::array<int8_t, ChannelMonitorConfigMessage::max_channels> db{};
+    uint32_t active{0};  // Bit n set when channel n is above squelch.
+    uint8_t channel_count{0};
+    uint8_t sequence{0};
+};
+
 class DisplayFrameSyncMessage : public Message {
    public:
     constexpr DisplayFrameSyncMessage()
@@ -258,13 +308,44 @@ class SpectrumStreamingConfigMessage : public Message {
         Running = 1,
     };
 
+    enum class Window : uint8_t {
+        None = 0,
+        Hamming = 1,
+        Blackman = 2,
+    };
+
+    /* How the spectra of average_count frames are reduced to the one
+     * ChannelSpectrum sent to the application. */
+    enum class Averaging : uint8_t {
+        None = 0,      // Every frame is sent.
+        Linear = 1,    // Mean power.
+        Log = 2,       // Mean of the dB values.
+        PeakHold = 3,  // Highest power per bin.
+        MinHold = 4,   // Lowest power per bin.
+    };
+
+    static constexpr uint8_t fft_size_log2_min = 6;
+    static constexpr uint8_t fft_size_log2_max = 8;
+
     constexpr SpectrumStreamingConfigMessage(
-        Mode mode)
+        Mode mode,
+        uint8_t fft_size_log2 = fft_size_log2_max,
+        Window window = Window::Hamming,
+        Averaging averaging = Averaging::None,
+        uint8_t average_count = 1)
         : Message{ID::SpectrumStreamingConfig},
-          mode{mode} {
+          mode{mode},
+          fft_size_log2{fft_size_log2},
+          window{window},
+          averaging{averaging},
+          average_count{average_count} {
     }
 
     Mode mode{Mode::Stopped};
+    uint8_t fft_size_log2{fft_size_log2_max};
+    Window window{Window::Hamming};
+    Averaging averaging{Averaging::None};
+    uint8_t average_count{1};
 };
 
 class WidebandSpectrumConfigMessage : public Message {
@@ -281,6 +362,48 @@ class WidebandSpectrumConfigMessage : public Message {
     size_t trigger{0};
 };
 
+/* Sweep mode of the wideband spectrum: after each step the processor drops
+ * settle_buffers buffers (synthesizers settling), integrates one spectrum and
+ * reports back with SpectrumSweepCapturedMessage. */
+class SpectrumSweepConfigMessage : public Message {
+   public:
+    constexpr SpectrumSweepConfigMessage(
+        bool enabled,
+        uint32_t settle_buffers)
+        : Message{ID::SpectrumSweepConfig},
+          enabled{enabled},
+          settle_buffers{settle_buffers} {
+    }
+
+    bool enabled;
+    uint32_t settle_buffers;
+};
+
+/* The radio was just tuned to slice, start capturing it. */
+class SpectrumSweepStepMessage : public Message {
+   public:
+    constexpr SpectrumSweepStepMessage(
+        uint32_t slice)
+        : Message{ID::SpectrumSweepStep},
+          slice{slice} {
+    }
+
+    uint32_t slice;
+};
+
+/* Capture of slice is done, the radio may be retuned. Its spectrum follows
+ * through the ChannelSpectrum FIFO, tagged with the slice. */
+class SpectrumSweepCapturedMessage : public Message {
+   public:
+    constexpr SpectrumSweepCapturedMessage(
+        uint32_t slice)
+        : Message{ID::SpectrumSweepCaptured},
+          slice{slice} {
+    }
+
+    uint32_t slice;
+};
+
 struct AudioSpectrum {
     std::array<uint8_t, 128> db{{0}};
     // uint32_t sampling_rate { 0 };
@@ -303,6 +426,7 @@ struct ChannelSpectrum {
     int32_t channel_filter_low_frequency{0};
     int32_t channel_filter_high_frequency{0};
     int32_t channel_filter_transition{0};
+    uint32_t sweep_slice{0};
 };
 
 using ChannelSpectrumFIFO = FIFO<ChannelSpectrum>;
@@ -323,12 +447,16 @@ class ChannelSpectrumConfigMessage : public Message {
 class AISPacketMessage : public Message {
    public:
     constexpr AISPacketMessage(
-        const baseband::Packet& packet)
+        const baseband::Packet& packet,
+        const uint32_t channel = 0)
         : Message{ID::AISPacket},
-          packet{packet} {
+          packet{packet},
+          channel{channel} {
     }
 
     baseband::Packet packet;
+    /* Index into baseband::ais::channel_offsets. */
+    uint32_t channel;
 };
 
 class TPMSPacketMessage : public Message {
@@ -458,13 +586,25 @@ class BLEPacketMessage : public Message {
 
 class CodedSquelchMessage : public Message {
    public:
+    enum class Type : uint8_t {
+        CTCSS = 0,        // value is the tone in 0.01 Hz.
+        DCS = 1,          // value is the 9 bit code.
+        DCSInverted = 2,  // Same, received with inverted polarity.
+    };
+
     constexpr CodedSquelchMessage(
-        const uint32_t value)
+        const uint32_t value,
+        const Type type = Type::CTCSS,
+        const uint8_t confidence = 100)
         : Message{ID::CodedSquelch},
-          value{value} {
+          value{value},
+          type{type},
+          confidence{confidence} {
     }
 
     uint32_t value;
+    Type type;
+    uint8_t confidence;  // 0..100
 };
 
 class ShutdownMessage : public Message {
@@ -693,7 +833,7 @@ struct CaptureConfig {
             return 0;
         } else {
             const size_t percent = baseband_bytes_dropped * 100U / baseband_bytes_received;
-            return std::max(1U, percent);
+            return std::max<size_t>(1U, percent);
         }
     }
 };
@@ -738,6 +878,18 @@ class ReplayConfigMessage : public Message {
     ReplayConfig* const config;
 };
 
+/* Bits per I/Q component of a packed replay stream, see packed_iq.hpp. */
+class ReplayPackingMessage : public Message {
+   public:
+    constexpr ReplayPackingMessage(
+        const uint8_t bits)
+        : Message{ID::ReplayPacking},
+          bits{bits} {
+    }
+
+    const uint8_t bits;
+};
+
 class TXProgressMessage : public Message {
    public:
     constexpr TXProgressMessage()
@@ -782,11 +934,14 @@ class APRSRxConfigureMessage : public Message {
 class BTLERxConfigureMessage : public Message {
    public:
     constexpr BTLERxConfigureMessage(
-        const uint8_t channel_number)
+        const uint8_t channel_number,
+        const uint8_t access_address_tolerance)
         : Message{ID::BTLERxConfigure},
-          channel_number(channel_number) {
+          channel_number(channel_number),
+          access_address_tolerance(access_address_tolerance) {
     }
     const uint8_t channel_number;
+    const uint8_t access_address_tolerance;  // Max. bit errors accepted in the access address.
 };
 
 class BTLETxConfigureMessage : public Message {
@@ -1238,7 +1393,16 @@ class SpectrumPainterBufferConfigureRequestMessage : public Message {
     int32_t bw;
 };
 
-using SpectrumPainterFIFO = FIFO<std::vector<uint8_t>>;
+/* Greyscale picture line, passed by value: the FIFO slots are the line
+ * pool, nothing is allocated on one core and freed on the other. */
+struct SpectrumPainterLine {
+    static constexpr size_t max_width = 512;
+
+    uint16_t width{0};
+    std::array<uint8_t, max_width> pixels{};
+};
+
+using SpectrumPainterFIFO = FIFO<SpectrumPainterLine>;
 class SpectrumPainterBufferConfigureResponseMessage : public Message {
    public:
     static constexpr size_t fifo_k = 2;
@@ -23,14 +23,30 @@
 #define __MESSAGE_QUEUE_H__
 
 #include <cstdint>
+#include <cstring>
 
 #include "message.hpp"
-#include "fifo.hpp"
 
 #include <ch.h>
+#include <hal.h>
 
+/* Queue of variable sized messages in a ring buffer, shared between threads
+ * or cores. Records are 4 byte aligned and never wrap around the end of the
+ * buffer (a filler record takes the rest of it), so messages are dispatched
+ * in place.
+ * NB: data must be 4 byte aligned. */
 class MessageQueue {
    public:
+    /* Counters, for debugging the M0/M4 communication. */
+    struct Stats {
+        uint32_t pushed;
+        uint32_t dropped;          // Pushes that failed, queue full or busy.
+        uint32_t high_water;       // Most bytes queued.
+        uint32_t dispatched;
+        uint32_t dispatch_max;     // Longest handler run, in halGetCounterValue() ticks.
+        uint64_t dispatch_total;   // In halGetCounterValue() ticks.
+    };
+
     MessageQueue() = delete;
     MessageQueue(const MessageQueue&) = delete;
     MessageQueue(MessageQueue&&) = delete;
@@ -38,7 +54,8 @@ class MessageQueue {
     MessageQueue(
         uint8_t* const data,
         size_t k)
-        : fifo{data, k} {
+        : data_{data},
+          size_{1U << k} {
         chMtxInit(&mutex_write);
     }
 
@@ -50,66 +67,110 @@ class MessageQueue {
         return push(&message, sizeof(message));
     }
 
-    template <typename T>
-    bool push_and_wait(const T& message) {
-        const bool result = push(message);
-        if (result) {
-            // TODO: More graceful method of waiting for empty? Maybe sleep for a bit?
-            while (!is_empty())
-                ;
-        }
-        return result;
-    }
-
     template <typename HandlerFn>
     void handle(HandlerFn handler) {
-        std::array<uint8_t, Message::MAX_SIZE> message_buffer;
-        while (Message* const message = peek(message_buffer)) {
+        while (Message* const message = peek()) {
+            const halrtcnt_t start = halGetCounterValue();
             handler(message);
+            const uint32_t elapsed = halGetCounterValue() - start;
+
+            stats_.dispatched++;
+            stats_.dispatch_total += elapsed;
+            if (elapsed > stats_.dispatch_max)
+                stats_.dispatch_max = elapsed;
+
             skip();
         }
     }
 
     bool is_empty() const {
-        return fifo.is_empty();
+        return in_ == out_;
     }
 
     void reset() {
-        fifo.reset();
+        in_ = out_ = 0;
+    }
+
+    const Stats& stats() const {
+        return stats_;
+    }
+
+    void reset_stats() {
+        stats_ = {};
     }
 
    private:
-    FIFO<uint8_t> fifo;
+    static constexpr size_t header_size = 4;
+    static constexpr uint32_t filler_header = 0xffffffff;
+
+    uint8_t* const data_;
+    const size_t size_;
+    volatile size_t in_{0};
+    volatile size_t out_{0};
     Mutex mutex_write{};
+    Stats stats_{};
 
-    Message* peek(std::array<uint8_t, Message::MAX_SIZE>& buf) {
-        Message* const p = reinterpret_cast<Message*>(buf.data());
-        return fifo.peek_r(buf.data(), buf.size()) ? p : nullptr;
+    size_t mask() const {
+        return size_ - 1;
     }
 
-    bool skip() {
-        return fifo.skip();
+    static constexpr size_t record_size(const size_t len) {
+        return header_size + ((len + 3) & ~3U);
     }
 
-    Message* pop(std::array<uint8_t, Message::MAX_SIZE>& buf) {
-        Message* const p = reinterpret_cast<Message*>(buf.data());
-        return fifo.out_r(buf.data(), buf.size()) ? p : nullptr;
+    uint32_t header_at(const size_t offset) const {
+        return *reinterpret_cast<const uint32_t*>(&data_[offset]);
     }
 
-    size_t len() const {
-        return fifo.len();
+    Message* peek() {
+        while (!is_empty()) {
+            const size_t offset = out_ & mask();
+            if (header_at(offset) != filler_header)
+                return reinterpret_cast<Message*>(&data_[offset + header_size]);
+
+            out_ = out_ + (size_ - offset);
+        }
+        return nullptr;
+    }
+
+    void skip() {
+        const size_t len = header_at(out_ & mask());
+        __DMB();  // Done with the record before the producer may reuse it.
+        out_ = out_ + record_size(len);
     }
 
     bool push(const void* const buf, const size_t len) {
         bool lock_success = chMtxTryLock(&mutex_write);
         if (!lock_success) {
+            stats_.dropped++;
             return false;
         }
 
-        const auto result = fifo.in_r(buf, len);
+        const size_t in = in_;
+        const size_t offset = in & mask();
+        const size_t record = record_size(len);
+        const size_t filler = (record > size_ - offset) ? (size_ - offset) : 0;
+        const size_t queued = in - out_;
+
+        const bool success = (queued + filler + record) <= size_;
+        if (success) {
+            if (filler)
+                *reinterpret_cast<uint32_t*>(&data_[offset]) = filler_header;
+
+            const size_t record_offset = (in + filler) & mask();
+            *reinterpret_cast<uint32_t*>(&data_[record_offset]) = len;
+            memcpy(&data_[record_offset + header_size], buf, len);
+            __DMB();  // Record written before it is published.
+            in_ = in + filler + record;
+
+            stats_.pushed++;
+            if (queued + filler + record > stats_.high_water)
+                stats_.high_water = queued + filler + record;
+        } else {
+            stats_.dropped++;
+        }
         chMtxUnlock();
 
-        const bool success = (result == len);
         if (success) {
             signal();
         }
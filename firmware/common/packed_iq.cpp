@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "packed_iq.hpp"
+
+#include <array>
+#include <cstring>
+
+namespace packed_iq {
+
+namespace {
+
+constexpr uint8_t level(const uint32_t code, const uint8_t bits) {
+    const int32_t max_code = (1 << bits) - 1;
+    const int32_t scale = 128 >> (bits - 1);
+    return static_cast<uint8_t>((2 * static_cast<int32_t>(code) - max_code) * scale / 2);
+}
+
+/* One byte is one sample, real in the low byte as complex8_t lays it out. */
+constexpr std::array<uint16_t, 256> make_lut4() {
+    std::array<uint16_t, 256> lut{};
+    for (uint32_t b = 0; b < lut.size(); b++)
+        lut[b] = level(b & 0xF, 4) | (level(b >> 4, 4) << 8);
+    return lut;
+}
+
+/* One byte is two samples. */
+constexpr std::array<uint32_t, 256> make_lut2() {
+    std::array<uint32_t, 256> lut{};
+    for (uint32_t b = 0; b < lut.size(); b++) {
+        for (uint32_t i = 0; i < 4; i++)
+            lut[b] |= static_cast<uint32_t>(level((b >> (2 * i)) & 0x3, 2)) << (8 * i);
+    }
+    return lut;
+}
+
+constexpr std::array<uint16_t, 256> lut4 = make_lut4();
+constexpr std::array<uint32_t, 256> lut2 = make_lut2();
+
+static_assert(sizeof(complex8_t) == sizeof(uint16_t), "complex8_t is not two bytes");
+
+} /* namespace */
+
+size_t unpack(const uint8_t* src, const size_t bytes, complex8_t* dst, const uint8_t bits) {
+    auto out = reinterpret_cast<uint8_t*>(dst);
+
+    switch (bits) {
+        case 2:
+            for (size_t i = 0; i < bytes; i++) {
+                const uint32_t samples = lut2[src[i]];
+                memcpy(&out[i * 4], &samples, sizeof(samples));
+            }
+            return bytes * 2;
+
+        case 4:
+            for (size_t i = 0; i < bytes; i++) {
+                const uint16_t sample = lut4[src[i]];
+                memcpy(&out[i * 2], &sample, sizeof(sample));
+            }
+            return bytes;
+
+        case 8:
+            memmove(out, src, bytes & ~size_t{1});
+            return bytes / 2;
+
+        default:
+            return 0;
+    }
+}
+
+} /* namespace packed_iq */
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __PACKED_IQ_H__
+#define __PACKED_IQ_H__
+
+#include <cstdint>
+#include <cstddef>
+
+#include "complex.hpp"
+
+/* Packed IQ files: a 16 byte header, then interleaved I/Q components of
+ * 2, 4 or 8 bits. Narrow components are offset binary, unpacked to the
+ * symmetric levels (2 * code - (2^bits - 1)) scaled to fill an int8.
+ * Components are packed from the least significant bits of each byte:
+ * 4 bits is I | Q << 4, 2 bits is I0 | Q0 << 2 | I1 << 4 | Q1 << 6. */
+namespace packed_iq {
+
+constexpr uint32_t header_magic = 0x51494B50;  // "PKIQ"
+constexpr uint8_t header_version = 1;
+
+struct Header {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t bits;  // Per component.
+    uint16_t reserved;
+    uint32_t sample_rate;  // 0 when given by the metadata file.
+    uint32_t reserved2;
+};
+
+static_assert(sizeof(Header) == 16, "packed_iq::Header size wrong");
+
+constexpr bool is_valid_bits(const uint8_t bits) {
+    return (bits == 2) || (bits == 4) || (bits == 8);
+}
+
+constexpr bool is_valid(const Header& header) {
+    return (header.magic == header_magic) &&
+           (header.version == header_version) &&
+           is_valid_bits(header.bits);
+}
+
+/* Bytes holding samples complex samples. */
+constexpr size_t packed_size(const size_t samples, const uint8_t bits) {
+    return samples * bits / 4;
+}
+
+/* Samples held in bytes. */
+constexpr size_t sample_count(const size_t bytes, const uint8_t bits) {
+    return bytes * 4 / bits;
+}
+
+/* Unpacks bytes of packed components into dst through lookup tables,
+ * returns the number of samples written. dst may overlap src as long as
+ * src starts no earlier than bytes before the end of a full unpack, so a
+ * read into the tail of the destination buffer can be unpacked in place. */
+size_t unpack(const uint8_t* src, size_t bytes, complex8_t* dst, uint8_t bits);
+
+} /* namespace packed_iq */
+
+#endif /*__PACKED_IQ_H__*/
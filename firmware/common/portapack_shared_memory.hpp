@@ -27,6 +27,7 @@
 #include <cstddef>
 
 #include "message_queue.hpp"
+#include "baseband_profile.hpp"
 
 struct JammerChannel {
     bool enabled;
@@ -51,8 +52,9 @@ struct SharedMemory {
     static constexpr size_t application_queue_k = 11;
     static constexpr size_t app_local_queue_k = 11;
 
-    uint8_t application_queue_data[1 << application_queue_k]{0};
-    uint8_t app_local_queue_data[1 << app_local_queue_k]{0};
+    // MessageQueue records are read in place, keep them aligned.
+    alignas(4) uint8_t application_queue_data[1 << application_queue_k]{0};
+    alignas(4) uint8_t app_local_queue_data[1 << app_local_queue_k]{0};
     const Message* volatile baseband_message{nullptr};
     MessageQueue application_queue{application_queue_data, application_queue_k};
     MessageQueue app_local_queue{app_local_queue_data, app_local_queue_k};
@@ -75,6 +77,10 @@ struct SharedMemory {
     uint16_t volatile m4_stack_usage{0};
     uint32_t volatile m4_heap_usage{0};
     uint16_t volatile m4_buffer_missed{0};
+
+    // Per-stage M4 cycle counts, published while request_m4_profile is set.
+    bool volatile request_m4_profile{false};
+    baseband::profile::Snapshot m4_profile{};
 };
 
 extern SharedMemory& shared_memory;
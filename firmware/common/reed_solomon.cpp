@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "reed_solomon.hpp"
+
+#include <algorithm>
+
+namespace reed_solomon {
+
+namespace {
+
+constexpr uint32_t field_polynomial = 0x11D;
+
+struct Tables {
+    // Doubled, so the sum of two logs needs no modulo.
+    std::array<uint8_t, 2 * codeword_size> exp;
+    std::array<uint8_t, codeword_size + 1> log;
+};
+
+constexpr Tables make_tables() {
+    Tables tables{};
+    uint32_t x = 1;
+    for (size_t i = 0; i < codeword_size; i++) {
+        tables.exp[i] = x;
+        tables.exp[i + codeword_size] = x;
+        tables.log[x] = i;
+        x <<= 1;
+        if (x & 0x100)
+            x ^= field_polynomial;
+    }
+    return tables;
+}
+
+constexpr Tables tables = make_tables();
+
+uint8_t mul(const uint8_t a, const uint8_t b) {
+    if ((a == 0) || (b == 0))
+        return 0;
+    return tables.exp[tables.log[a] + tables.log[b]];
+}
+
+uint8_t div(const uint8_t a, const uint8_t b) {
+    if (a == 0)
+        return 0;
+    return tables.exp[tables.log[a] + codeword_size - tables.log[b]];
+}
+
+/* alpha^power, power taken modulo 255. */
+uint8_t alpha(const size_t power) {
+    return tables.exp[power % codeword_size];
+}
+
+/* Generator polynomial, lowest degree first, monic. */
+constexpr std::array<uint8_t, parity_size + 1> make_generator() {
+    std::array<uint8_t, parity_size + 1> g{};
+    g[0] = 1;
+    for (size_t i = 0; i < parity_size; i++) {
+        // g(x) *= (x + alpha^i)
+        const uint8_t root = tables.exp[i];
+        for (size_t j = i + 1; j > 0; j--) {
+            const uint8_t c = g[j];
+            const uint8_t product = ((c == 0) || (root == 0)) ? 0 : tables.exp[tables.log[c] + tables.log[root]];
+            g[j] = g[j - 1] ^ product;
+        }
+        g[0] = (g[0] == 0) ? 0 : tables.exp[tables.log[g[0]] + tables.log[root]];
+    }
+    return g;
+}
+
+constexpr std::array<uint8_t, parity_size + 1> generator = make_generator();
+
+} /* namespace */
+
+void encode(codeword_t& codeword) {
+    // Parity is message(x) * x^24 mod g(x), by long division from the top.
+    std::array<uint8_t, parity_size> remainder{};
+    for (size_t i = codeword_size; i > parity_size; i--) {
+        const uint8_t feedback = codeword[i - 1] ^ remainder[parity_size - 1];
+        for (size_t j = parity_size - 1; j > 0; j--)
+            remainder[j] = remainder[j - 1] ^ mul(feedback, generator[j]);
+        remainder[0] = mul(feedback, generator[0]);
+    }
+    std::copy(remainder.begin(), remainder.end(), codeword.begin());
+}
+
+int32_t decode(codeword_t& codeword, const size_t length) {
+    // Syndromes S_i = c(alpha^i), Horner from the top.
+    std::array<uint8_t, parity_size> syndromes{};
+    bool clean = true;
+    for (size_t i = 0; i < parity_size; i++) {
+        uint8_t s = 0;
+        const uint8_t root = alpha(i);
+        for (size_t j = length; j > 0; j--)
+            s = mul(s, root) ^ codeword[j - 1];
+        syndromes[i] = s;
+        clean = clean && (s == 0);
+    }
+    if (clean)
+        return 0;
+
+    // Berlekamp-Massey, error locator lambda(x).
+    std::array<uint8_t, parity_size + 1> lambda{1};
+    std::array<uint8_t, parity_size + 1> previous{1};
+    size_t degree = 0;
+    size_t shift = 1;
+    uint8_t previous_discrepancy = 1;
+    for (size_t r = 0; r < parity_size; r++) {
+        uint8_t discrepancy = syndromes[r];
+        for (size_t i = 1; i <= degree; i++)
+            discrepancy ^= mul(lambda[i], syndromes[r - i]);
+
+        if (discrepancy == 0) {
+            shift++;
+            continue;
+        }
+
+        const uint8_t scale = div(discrepancy, previous_discrepancy);
+        const auto saved = lambda;
+        for (size_t i = shift; i <= parity_size; i++)
+            lambda[i] ^= mul(scale, previous[i - shift]);
+
+        if (2 * degree <= r) {
+            degree = r + 1 - degree;
+            previous = saved;
+            previous_discrepancy = discrepancy;
+            shift = 1;
+        } else {
+            shift++;
+        }
+    }
+    if (degree > max_errors)
+        return -1;
+
+    // Chien search: an error at j makes lambda(alpha^-j) zero.
+    std::array<uint8_t, max_errors> positions{};
+    size_t found = 0;
+    for (size_t j = 0; j < codeword_size; j++) {
+        const uint8_t x_inv = alpha(codeword_size - j);
+        uint8_t value = 0;
+        for (size_t i = degree + 1; i > 0; i--)
+            value = mul(value, x_inv) ^ lambda[i - 1];
+
+        if (value == 0) {
+            if ((found == degree) || (j >= length))
+                return -1;
+            positions[found++] = j;
+        }
+    }
+    if (found != degree)
+        return -1;
+
+    // Error evaluator omega(x) = S(x) lambda(x) mod x^24.
+    std::array<uint8_t, parity_size> omega{};
+    for (size_t i = 0; i < parity_size; i++) {
+        for (size_t j = 0; (j <= i) && (j <= degree); j++)
+            omega[i] ^= mul(lambda[j], syndromes[i - j]);
+    }
+
+    // Forney with the first root at alpha^0: e = X omega(X^-1) / lambda'(X^-1).
+    std::array<uint8_t, max_errors> values{};
+    for (size_t k = 0; k < found; k++) {
+        const uint8_t x = alpha(positions[k]);
+        const uint8_t x_inv = alpha(codeword_size - positions[k]);
+
+        uint8_t numerator = 0;
+        for (size_t i = parity_size; i > 0; i--)
+            numerator = mul(numerator, x_inv) ^ omega[i - 1];
+
+        // Formal derivative: only odd powers remain in characteristic 2.
+        uint8_t denominator = 0;
+        for (size_t i = 1; i <= degree; i += 2)
+            denominator ^= mul(lambda[i], alpha((codeword_size - positions[k]) * (i - 1)));
+        if (denominator == 0)
+            return -1;
+
+        values[k] = mul(x, div(numerator, denominator));
+    }
+
+    for (size_t k = 0; k < found; k++)
+        codeword[positions[k]] ^= values[k];
+    return found;
+}
+
+} /* namespace reed_solomon */
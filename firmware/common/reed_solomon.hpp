@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __REED_SOLOMON_H__
+#define __REED_SOLOMON_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/* RS(255, 231) over GF(2^8), field polynomial 0x11D, generator roots
+ * alpha^0 .. alpha^23, as used by the Vaisala RS41. Corrects up to 12
+ * symbol errors per codeword. The log and antilog tables are constexpr,
+ * they live in flash.
+ *
+ * Codewords are stored lowest degree first: the parity in [0, 24), then
+ * the message. Shortened codes leave the top of the message at zero. */
+namespace reed_solomon {
+
+constexpr size_t codeword_size = 255;
+constexpr size_t parity_size = 24;
+constexpr size_t message_size = codeword_size - parity_size;
+constexpr size_t max_errors = parity_size / 2;
+
+using codeword_t = std::array<uint8_t, codeword_size>;
+
+/* Computes the parity of the message in codeword. */
+void encode(codeword_t& codeword);
+
+/* Corrects codeword in place. Symbols from length up are known to be zero
+ * padding, an error found there means the codeword can't be corrected.
+ * Returns the number of symbols corrected, or -1 when uncorrectable (the
+ * codeword is left untouched). */
+int32_t decode(codeword_t& codeword, const size_t length = codeword_size);
+
+} /* namespace reed_solomon */
+
+#endif /*__REED_SOLOMON_H__*/
@@ -22,7 +22,9 @@
  */
 
 #include "sonde_packet.hpp"
+#include "reed_solomon.hpp"
 #include "string_format.hpp"
+#include <algorithm>
 #include <cstring>
 // #include <complex>
 
@@ -35,6 +37,10 @@ static uint8_t calfrchk[51];        // so subframes are preserved while populate
 #define MASK_LEN 64
 
 // Following values include the 4 bytes less shift, consumed in detecting the header on proc_sonde
+#define rs41_parity 0x04    // 0x008  // 2 x 24 bytes, one block per codeword
+#define rs41_message 0x34   // 0x038  // codeword bytes interleaved from here to the end of the frame
+#define pos_FrameType 0x34  // 0x038  // 1 byte, 0x0F standard frame, 0xF0 extended frame
+#define frame_type_extended 0xF0
 #define block_status 0x35   // 0x039  // 40 bytes
 #define block_gpspos 0x10E  // 0x112  // 21 bytes
 #define block_meas 0x61     // 0x65  // 42 bytes
@@ -67,6 +73,9 @@ Packet::Packet(
         else if (id_byte == 0x4520)  // https://raw.githubusercontent.com/projecthorus/radiosonde_auto_rx/master/demod/mod/m20mod.c
             type_ = Type::Meteomodem_M20;
     }
+
+    if (type_ == Type::Vaisala_RS41_SG)
+        rs41_correct();
 }
 
 size_t Packet::length() const {
@@ -86,7 +95,14 @@ Packet::Type Packet::type() const {
 // The raw data is xor-scrambled with the values in the 64 bytes vaisala_mask (see.hpp)
 // from 0x008 to 0x037 (48 bytes reed-solomon error correction data)
 
-uint8_t Packet::vaisala_descramble(const uint32_t pos) const {  // vaisala_descramble(const uint32_t pos) const {
+uint8_t Packet::vaisala_descramble(const uint32_t pos) const {
+    // Reed-Solomon corrected copy of the standard frame, the raw bits past it.
+    if (pos < rs41_frame_.size())
+        return rs41_frame_[pos];
+    return vaisala_descramble_raw(pos);
+}
+
+uint8_t Packet::vaisala_descramble_raw(const uint32_t pos) const {
     // packet_[i]; its a bit;  packet_.size the total (should be 2560 bits)
     uint8_t value = 0;
     for (uint8_t i = 0; i < 8; i++)
@@ -321,6 +337,53 @@ FormattedSymbols Packet::symbols_formatted() const {
     }
 }
 
+// Two RS(255, 231) codewords share the frame: their parity blocks follow each other,
+// their message bytes alternate from rs41_message on. Both are shortened to
+// 24 + 132 bytes, the rest of the 231 message bytes being zero.
+void Packet::rs41_correct() {
+    constexpr size_t codewords = 2;
+    constexpr size_t message_length = (rs41_frame_size - rs41_message) / codewords;
+    constexpr size_t length = reed_solomon::parity_size + message_length;
+
+    const size_t bytes = std::min<size_t>(packet_.size() / 8, rs41_frame_.size());
+    for (size_t pos = 0; pos < bytes; pos++)
+        rs41_frame_[pos] = vaisala_descramble_raw(pos);
+
+    // An extended frame (518 bytes) runs past the captured 320, its codewords can't
+    // be rebuilt. It is left as received, the CRC check alone decides on it.
+    if (rs41_frame_[pos_FrameType] == frame_type_extended) {
+        rs_errors_ = -1;
+        return;
+    }
+
+    rs_errors_ = 0;
+    for (size_t k = 0; k < codewords; k++) {
+        reed_solomon::codeword_t codeword{};
+        const size_t parity = rs41_parity + k * reed_solomon::parity_size;
+        for (size_t i = 0; i < reed_solomon::parity_size; i++)
+            codeword[i] = rs41_frame_[parity + i];
+        for (size_t i = 0; i < message_length; i++)
+            codeword[reed_solomon::parity_size + i] = rs41_frame_[rs41_message + codewords * i + k];
+
+        const auto corrected = reed_solomon::decode(codeword, length);
+        if (corrected < 0) {
+            rs_errors_ = -1;
+            continue;
+        }
+        if (rs_errors_ >= 0)
+            rs_errors_ += corrected;
+
+        for (size_t i = 0; i < reed_solomon::parity_size; i++)
+            rs41_frame_[parity + i] = codeword[i];
+        for (size_t i = 0; i < message_length; i++)
+            rs41_frame_[rs41_message + codewords * i + k] = codeword[reed_solomon::parity_size + i];
+    }
+}
+
+int32_t Packet::rs_errors() const {
+    return rs_errors_;
+}
+
 bool Packet::crc_ok() const {
     switch (type_) {
         case Type::Meteomodem_M10:
@@ -23,6 +23,7 @@
 #ifndef __SONDE_PACKET_H__
 #define __SONDE_PACKET_H__
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
 
@@ -73,7 +74,15 @@ class Packet {
 
     bool crc_ok() const;
 
+    /* RS41: symbols fixed by Reed-Solomon over both codewords, -1 when
+     * either one was beyond repair or for an extended frame, which is left
+     * uncorrected. Always 0 for other types. */
+    int32_t rs_errors() const;
+
    private:
+    // RS41 frame bytes after the 4 consumed by proc_sonde, 320 byte standard frame.
+    static constexpr size_t rs41_frame_size = 320 - 4;
+
     static constexpr uint8_t vaisala_mask[64] = {
         0x96, 0x83, 0x3E, 0x51, 0xB1, 0x49, 0x08, 0x98,
         0x32, 0x05, 0x59, 0x0E, 0xF9, 0x44, 0xC6, 0x26,
@@ -87,11 +96,15 @@ class Packet {
     GPS_data ecef_to_gps() const;
 
     uint8_t vaisala_descramble(uint32_t pos) const;
+    uint8_t vaisala_descramble_raw(uint32_t pos) const;
+    void rs41_correct();
 
     const baseband::Packet packet_;
     const BiphaseMDecoder decoder_;
     const FieldReader<BiphaseMDecoder, BitRemapNone> reader_bi_m;
     Type type_;
+    std::array<uint8_t, rs41_frame_size> rs41_frame_{};
+    int32_t rs_errors_{0};
 
     using packetReader = FieldReader<baseband::Packet, BitRemapByteReverse>;  // baseband::Packet instead of BiphaseMDecoder
 
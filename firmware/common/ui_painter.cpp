@@ -26,6 +26,8 @@
 #include "portapack.hpp"
 using namespace portapack;
 
+#include <array>
+
 namespace ui {
 
 Style Style::invert() const {
@@ -51,10 +53,22 @@ int Painter::draw_string(
     Color foreground,
     Color background,
     std::string_view text) {
+    const Size glyph_size{font.char_width(), font.line_height()};
+    std::array<const uint8_t*, lcd::ILI9341::glyph_run_max> glyphs;
+    std::array<Color, lcd::ILI9341::glyph_run_max> pens;
+    size_t count = 0;
     bool escape = false;
     size_t width = 0;
     Color pen = foreground;
 
+    // Glyphs are collected into runs, each drawn in a single LCD write.
+    auto flush = [&]() {
+        display.draw_glyph_run(p, glyph_size, glyphs.data(), pens.data(), count, background);
+        p += {static_cast<int>(count) * glyph_size.width(), 0};
+        width += count * glyph_size.width();
+        count = 0;
+    };
+
     for (auto c : text) {
         if (escape) {
             if (c < std::size(term_colors))
@@ -66,15 +80,17 @@ int Painter::draw_string(
             if (c == '\x1B') {
                 escape = true;
             } else {
-                const auto glyph = font.glyph(c);
-                display.draw_glyph(p, glyph, pen, background);
-                const auto advance = glyph.advance();
-                p += advance;
-                width += advance.x();
+                glyphs[count] = font.glyph(c).pixels();
+                pens[count] = pen;
+                if (++count == glyphs.size())
+                    flush();
             }
         }
     }
 
+    if (count > 0)
+        flush();
+
     return width;
 }
 
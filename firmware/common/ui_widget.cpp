@@ -680,9 +680,23 @@ void Console::write(std::string message) {
     if (!hidden() && visible()) {
         const Style& s = style();
         const Font& font = s.font;
+        const Size glyph_size{font.char_width(), font.line_height()};
         auto rect = screen_rect();
         ui::Color pen_color = s.foreground;
 
+        // Glyphs on the current line are drawn as a run in a single LCD write.
+        std::array<const uint8_t*, lcd::ILI9341::glyph_run_max> glyphs;
+        std::array<ui::Color, lcd::ILI9341::glyph_run_max> pens;
+        size_t count = 0;
+        Point run_pos{};
+
+        auto flush = [&]() {
+            if (count > 0) {
+                display.draw_glyph_run(run_pos, glyph_size, glyphs.data(), pens.data(), count, s.background);
+                count = 0;
+            }
+        };
+
         for (auto c : message) {
             if (escape) {
                 if (c < std::size(term_colors))
@@ -692,8 +706,10 @@ void Console::write(std::string message) {
                 escape = false;
             } else {
                 if (c == '\n') {
+                    flush();
                     crlf();
                 } else if (c == '\r') {
+                    flush();
                     pos = {0, pos.y()};
                 } else if (c == '\x1B') {
                     escape = true;
@@ -701,17 +717,22 @@ void Console::write(std::string message) {
                     auto glyph = font.glyph(c);
                     auto advance = glyph.advance();
                     // Would drawing next character be off the end? Newline.
-                    if ((pos.x() + advance.x()) > rect.width())
+                    if ((pos.x() + advance.x()) > rect.width()) {
+                        flush();
                         crlf();
-
-                    Point pos_glyph{
-                        rect.left() + pos.x(),
-                        display.scroll_area_y(pos.y())};
-                    display.draw_glyph(pos_glyph, glyph, pen_color, s.background);
+                    }
+
+                    if (count == 0)
+                        run_pos = {rect.left() + pos.x(), display.scroll_area_y(pos.y())};
+                    glyphs[count] = glyph.pixels();
+                    pens[count] = pen_color;
+                    if (++count == glyphs.size())
+                        flush();
                     pos += {advance.x(), 0};
                 }
             }
         }
+        flush();
         buffer = message;
     } else {
         if (buffer.size() < 256) buffer += message;
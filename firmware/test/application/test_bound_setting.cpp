@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "mock_file.hpp"
+#include "bound_setting.hpp"
+#include "file_reader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace {
+
+/* Counts the writes, each is a round trip to the SD card on the device. */
+class CountingFile : public MockFile {
+   public:
+    using MockFile::MockFile;
+
+    Result<Size> write(const void* data, Size bytes_to_write) {
+        ++write_count;
+        return MockFile::write(data, bytes_to_write);
+    }
+
+    size_t write_count{0};
+};
+
+struct TestSettings {
+    int64_t i64{-1234567890123};
+    int32_t i32{-42};
+    uint32_t u32{4000000000};
+    uint8_t u8{200};
+    std::string str{"Hello World"};
+    bool flag{true};
+
+    SettingBindings bindings() {
+        return {
+            {"i64", &i64},
+            {"i32", &i32},
+            {"u32", &u32},
+            {"u8", &u8},
+            {"str", &str},
+            {"flag", &flag},
+        };
+    }
+};
+
+std::string to_file(SettingBindings& bindings) {
+    MockFile f{""};
+    write_settings(f, bindings);
+    return f.data_;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("Test BoundSetting");
+
+TEST_CASE("It writes name=value lines.") {
+    TestSettings s;
+    auto bindings = s.bindings();
+
+    CHECK_EQ(to_file(bindings), "i64=-1234567890123\r\ni32=-42\r\nu32=4000000000\r\nu8=200\r\nstr=Hello World\r\nflag=1\r\n");
+}
+
+TEST_CASE("It reads back what it writes.") {
+    TestSettings s;
+    auto bindings = s.bindings();
+    MockFile f{to_file(bindings)};
+
+    TestSettings r{0, 0, 0, 0, "", false};
+    auto read_bindings = r.bindings();
+    CHECK_EQ(read_settings(f, read_bindings), 6);
+
+    CHECK_EQ(r.i64, s.i64);
+    CHECK_EQ(r.i32, s.i32);
+    CHECK_EQ(r.u32, s.u32);
+    CHECK_EQ(r.u8, s.u8);
+    CHECK_EQ(r.str, s.str);
+    CHECK_EQ(r.flag, s.flag);
+}
+
+TEST_CASE("It reads lines in any order and skips bad lines.") {
+    MockFile f{"flag=0\nunknown=1\nu8=7\r\na=b=c\n\nnoequals\nstr=  padded  \ni32=-5"};
+    TestSettings r;
+    auto bindings = r.bindings();
+
+    CHECK_EQ(read_settings(f, bindings), 4);
+    CHECK_EQ(r.flag, false);
+    CHECK_EQ(r.u8, 7);
+    CHECK_EQ(r.str, "padded");
+    CHECK_EQ(r.i32, -5);
+    CHECK_EQ(r.i64, -1234567890123);  // Untouched.
+}
+
+TEST_CASE("It reads lines longer than the buffer.") {
+    const auto value = std::string(setting_buffer_size * 2, 'x');
+    MockFile f{"u8=1\nstr=" + value + "\nflag=0\n"};
+    TestSettings r;
+    auto bindings = r.bindings();
+
+    CHECK_EQ(read_settings(f, bindings), 3);
+    CHECK_EQ(r.u8, 1);
+    CHECK_EQ(r.str, value);
+    CHECK_EQ(r.flag, false);
+}
+
+TEST_CASE("It reads a long last line without a newline.") {
+    // Fills the buffer exactly, twice, so nothing is left in it at the end.
+    const auto value = std::string(setting_buffer_size * 2 - 4, 'x');
+    MockFile f{"str=" + value};
+    TestSettings r;
+    auto bindings = r.bindings();
+
+    CHECK_EQ(read_settings(f, bindings), 1);
+    CHECK_EQ(r.str, value);
+}
+
+TEST_CASE("It round trips settings longer than the buffer.") {
+    TestSettings s;
+    s.str = std::string(setting_buffer_size * 3 + 7, 'y');
+    auto bindings = s.bindings();
+    MockFile f{to_file(bindings)};
+
+    TestSettings r;
+    auto read_bindings = r.bindings();
+    read_settings(f, read_bindings);
+    CHECK_EQ(r.str, s.str);
+}
+
+TEST_CASE("It hashes the values.") {
+    TestSettings s;
+    auto bindings = s.bindings();
+    const auto hash = hash_settings(bindings);
+
+    CHECK_NE(hash, 0);
+    CHECK_EQ(hash_settings(bindings), hash);
+
+    s.u8++;
+    CHECK_NE(hash_settings(bindings), hash);
+    s.u8--;
+    CHECK_EQ(hash_settings(bindings), hash);
+}
+
+TEST_CASE("Benchmark app entry and exit.") {
+    // 19 common settings plus some app settings, for each of many apps.
+    constexpr size_t apps = 64;
+    constexpr size_t settings_per_app = 32;
+    constexpr int iterations = 50;
+
+    std::vector<uint32_t> values(settings_per_app);
+    std::vector<std::string> names;
+    SettingBindings bindings;
+    for (size_t i = 0; i < settings_per_app; i++)
+        names.push_back("setting_name_" + std::to_string(i));
+    for (size_t i = 0; i < settings_per_app; i++) {
+        values[i] = i * 100003;
+        bindings.emplace_back(names[i], &values[i]);
+    }
+
+    const auto contents = to_file(bindings);
+    size_t legacy_writes = 0;
+    size_t writes = 0;
+
+    // The previous implementation: a line reader and a string split per
+    // line, a linear search per setting and four writes per setting.
+    const auto legacy_start = std::chrono::steady_clock::now();
+    for (int n = 0; n < iterations; n++) {
+        for (size_t app = 0; app < apps; app++) {
+            CountingFile f{contents};
+            BufferLineReader<CountingFile> reader{f};
+            for (const auto& line : reader) {
+                auto cols = split_string(line, '=');
+                if (cols.size() != 2)
+                    continue;
+
+                auto it = std::find_if(bindings.begin(), bindings.end(), [name = cols[0]](auto& bound_setting) {
+                    return name == bound_setting.name();
+                });
+                if (it != bindings.end())
+                    it->parse(cols[1]);
+            }
+
+            CountingFile out{""};
+            StringFormatBuffer buffer;
+            for (const auto& setting : bindings) {
+                out.write(setting.name().data(), setting.name().length());
+                out.write("=", 1);
+                const auto value = setting.format(buffer);
+                out.write(value.data(), value.length());
+                out.write("\r\n", 2);
+            }
+            legacy_writes += out.write_count;
+        }
+    }
+    const std::chrono::duration<double> legacy_elapsed = std::chrono::steady_clock::now() - legacy_start;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < iterations; n++) {
+        for (size_t app = 0; app < apps; app++) {
+            CountingFile f{contents};
+            CHECK_EQ(read_settings(f, bindings), settings_per_app);
+            const auto saved_hash = hash_settings(bindings);
+
+            // Nothing changed, so nothing is written on exit.
+            if (hash_settings(bindings) != saved_hash) {
+                CountingFile out{""};
+                write_settings(out, bindings);
+                writes += out.write_count;
+            }
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    CountingFile changed{""};
+    write_settings(changed, bindings);
+
+    const auto exits = apps * iterations;
+    MESSAGE("Legacy: " << (legacy_elapsed.count() * 1e6 / exits) << " us and "
+                       << (legacy_writes / exits) << " writes per app entry/exit");
+    MESSAGE("Buffered: " << (elapsed.count() * 1e6 / exits) << " us and "
+                         << (writes / exits) << " writes per app entry/exit ("
+                         << changed.write_count << " writes when changed)");
+    CHECK_EQ(writes, 0);
+    CHECK_LT(changed.write_count, settings_per_app);
+}
+
+TEST_SUITE_END();
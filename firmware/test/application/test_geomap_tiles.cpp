@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "mock_file.hpp"
+#include "geomap_tiles.hpp"
+
+#include <cstdint>
+#include <string>
+
+using namespace geomap;
+
+/* Single level map of tiles_x * tiles_y tiles. Pixels encode their tile and
+ * position so a wrong tile or offset shows up in the data. */
+static uint16_t pixel_value(int32_t tx, int32_t ty, int32_t px, int32_t py) {
+    return (ty << 10) | (tx << 5) | ((px + py) & 31);
+}
+
+static std::string make_map(uint16_t tile_size, uint16_t tiles_x, uint16_t tiles_y) {
+    TileFileHeader header{{'P', 'P', 'M', 'T'}, 1, tile_size,
+                          static_cast<uint16_t>(tiles_x * tile_size),
+                          static_cast<uint16_t>(tiles_y * tile_size), 1, 0};
+    TileLevelHeader level{1, tiles_x, tiles_y, 0, sizeof(header) + sizeof(level)};
+
+    std::string data;
+    data.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    data.append(reinterpret_cast<const char*>(&level), sizeof(level));
+
+    for (int32_t ty = 0; ty < tiles_y; ty++)
+        for (int32_t tx = 0; tx < tiles_x; tx++)
+            for (int32_t py = 0; py < tile_size; py++)
+                for (int32_t px = 0; px < tile_size; px++) {
+                    const auto v = pixel_value(tx, ty, px, py);
+                    data.append(reinterpret_cast<const char*>(&v), sizeof(v));
+                }
+
+    return data;
+}
+
+/* Visits the tiles of a view the way GeoMap::draw_map_tiles() does and returns
+ * the cache hits of the redraw. */
+static uint32_t draw(TiledMap<MockFile>& map, int32_t x, int32_t y, int32_t width, int32_t height) {
+    const int32_t ts = map.tile_size();
+    const auto hits = map.cache_hits();
+    size_t tiles = 0;
+    bool pixels_ok = true;
+
+    map.for_each_tile(0, x / ts, y / ts, (x + width - 1) / ts + 1, (y + height - 1) / ts + 1,
+                      [&](int32_t tx, int32_t ty) {
+                          const auto* tile = map.tile(0, tx, ty);
+                          pixels_ok &= tile && tile[3 * ts + 5].v == pixel_value(tx, ty, 5, 3);
+                          tiles++;
+                      });
+
+    CHECK(pixels_ok);
+    CHECK(tiles == static_cast<size_t>(((x + width - 1) / ts - x / ts + 1) * ((y + height - 1) / ts - y / ts + 1)));
+    return map.cache_hits() - hits;
+}
+
+TEST_SUITE_BEGIN("TiledMap");
+
+TEST_CASE("init should reject a file without the magic.") {
+    auto data = make_map(16, 2, 2);
+    data[0] = 'X';
+    MockFile f{data};
+    TiledMap<MockFile> map{f};
+
+    CHECK_FALSE(map.init(240));
+    CHECK_FALSE(map.is_open());
+    CHECK(map.tile(0, 0, 0) == nullptr);
+}
+
+TEST_CASE("init should size the cache for a row of tiles within the budget.") {
+    MockFile small{make_map(16, 4, 4)};
+    TiledMap<MockFile> small_map{small};
+    REQUIRE(small_map.init(240));
+    CHECK(small_map.cache_entries() == 16);
+
+    MockFile large{make_map(32, 4, 4)};
+    TiledMap<MockFile> large_map{large};
+    REQUIRE(large_map.init(240));
+    CHECK(large_map.cache_entries() == TiledMap<MockFile>::cache_budget_bytes / (32 * 32 * 2));
+}
+
+TEST_CASE("tile should return nullptr outside the map.") {
+    MockFile f{make_map(16, 4, 4)};
+    TiledMap<MockFile> map{f};
+    REQUIRE(map.init(240));
+
+    CHECK(map.tile(0, -1, 0) == nullptr);
+    CHECK(map.tile(0, 0, 4) == nullptr);
+    CHECK(map.tile(1, 0, 0) == nullptr);
+    CHECK(map.tile(0, 3, 3) != nullptr);
+}
+
+TEST_CASE("A one tile pan should reuse the cached row.") {
+    MockFile f{make_map(16, 32, 32)};
+    TiledMap<MockFile> map{f};
+    REQUIRE(map.init(240));
+
+    // 240 x 272 view not aligned to the tiles: 16 x 18 tiles.
+    int32_t x = 40;
+    int32_t y = 24;
+    CHECK(draw(map, x, y, 240, 272) == 0);
+
+    SUBCASE("Right then left.") {
+        // The cached row is one tile wider than the new one.
+        CHECK(draw(map, x += 16, y, 240, 272) == 15);
+        CHECK(draw(map, x += 16, y, 240, 272) == 15);
+        CHECK(draw(map, x -= 16, y, 240, 272) == 15);
+    }
+
+    SUBCASE("Down then up.") {
+        CHECK(draw(map, x, y += 16, 240, 272) == 16);
+        CHECK(draw(map, x, y += 16, 240, 272) == 16);
+        CHECK(draw(map, x, y -= 16, 240, 272) == 16);
+    }
+
+    SUBCASE("Diagonal.") {
+        CHECK(draw(map, x += 16, y += 16, 240, 272) == 15);
+        CHECK(draw(map, x -= 16, y -= 16, 240, 272) == 15);
+    }
+
+    SUBCASE("Redraw in place.") {
+        CHECK(draw(map, x, y, 240, 272) == 16);
+        CHECK(draw(map, x + 5, y + 3, 240, 272) == 16);
+    }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,392 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "mock_file.hpp"
+#include "io_lz4.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/* Reference frames made with the lz4 command line tool (v1.9.4):
+ * text_frame:       lz4 -9 text()
+ * text_frame_flags: lz4 -9 -BD -BX --content-size text()
+ * noise_frame:      lz4 -1 noise()  (stored as an uncompressed block)
+ * far_frame:        lz4 -9 "0123456789abcdefghijklmnopqrstuv0123456789abcdefghij"
+ * distant_frame:    lz4 -9 distant() */
+static const uint8_t text_frame[] = {
+    0x04, 0x22, 0x4d, 0x18, 0x64, 0x40, 0xa7, 0xbf, 0x01, 0x00, 0x00, 0xf1,
+    0x17, 0x6c, 0x69, 0x6e, 0x65, 0x20, 0x30, 0x3a, 0x20, 0x74, 0x68, 0x65,
+    0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+    0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f,
+    0x76, 0x65, 0x72, 0x1f, 0x00, 0x91, 0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64,
+    0x6f, 0x67, 0x0a, 0x34, 0x00, 0x1f, 0x31, 0x34, 0x00, 0x20, 0x1f, 0x32,
+    0x34, 0x00, 0x20, 0x1f, 0x33, 0x34, 0x00, 0x20, 0x1f, 0x34, 0x34, 0x00,
+    0x20, 0x1f, 0x35, 0x34, 0x00, 0x20, 0x1f, 0x36, 0x34, 0x00, 0x20, 0x1f,
+    0x37, 0x34, 0x00, 0x20, 0x1f, 0x38, 0x34, 0x00, 0x20, 0x1f, 0x39, 0xd4,
+    0x01, 0x21, 0x0f, 0x09, 0x02, 0x22, 0x0f, 0x0a, 0x02, 0x21, 0x1f, 0x31,
+    0x0b, 0x02, 0x21, 0x1f, 0x31, 0x0c, 0x02, 0x21, 0x1f, 0x31, 0x0d, 0x02,
+    0x21, 0x1f, 0x31, 0x0e, 0x02, 0x21, 0x1f, 0x31, 0x0f, 0x02, 0x21, 0x1f,
+    0x31, 0x10, 0x02, 0x21, 0x1f, 0x31, 0x11, 0x02, 0x21, 0x1f, 0x31, 0x12,
+    0x02, 0x21, 0x1f, 0x32, 0x12, 0x02, 0x21, 0x1f, 0x32, 0x1c, 0x04, 0x22,
+    0x0f, 0x12, 0x02, 0x21, 0x1f, 0x32, 0x12, 0x02, 0x21, 0x1f, 0x32, 0x12,
+    0x02, 0x21, 0x1f, 0x32, 0x12, 0x02, 0x21, 0x1f, 0x32, 0x12, 0x02, 0x21,
+    0x1f, 0x32, 0x12, 0x02, 0x21, 0x1f, 0x32, 0x12, 0x02, 0x21, 0x1f, 0x32,
+    0x12, 0x02, 0x21, 0x1f, 0x33, 0x12, 0x02, 0x21, 0x1f, 0x33, 0x12, 0x02,
+    0x21, 0x1f, 0x33, 0x2f, 0x06, 0x22, 0x0f, 0x12, 0x02, 0x21, 0x1f, 0x33,
+    0x12, 0x02, 0x21, 0x1f, 0x33, 0x12, 0x02, 0x21, 0x1f, 0x33, 0x12, 0x02,
+    0x21, 0x1f, 0x33, 0x12, 0x02, 0x21, 0x1f, 0x33, 0x12, 0x02, 0x21, 0x1f,
+    0x33, 0x12, 0x02, 0x21, 0x1f, 0x34, 0x12, 0x02, 0x21, 0x1f, 0x34, 0x12,
+    0x02, 0x21, 0x1f, 0x34, 0x12, 0x02, 0x21, 0x1f, 0x34, 0x42, 0x08, 0x22,
+    0x0f, 0x12, 0x02, 0x21, 0x1f, 0x34, 0x12, 0x02, 0x21, 0x1f, 0x34, 0x12,
+    0x02, 0x21, 0x1f, 0x34, 0x12, 0x02, 0x21, 0x1f, 0x34, 0x12, 0x02, 0x21,
+    0x1f, 0x34, 0x12, 0x02, 0x21, 0x1f, 0x35, 0x12, 0x02, 0x21, 0x1f, 0x35,
+    0x12, 0x02, 0x21, 0x1f, 0x35, 0x12, 0x02, 0x21, 0x1f, 0x35, 0x12, 0x02,
+    0x21, 0x1f, 0x35, 0x55, 0x0a, 0x22, 0x0f, 0x12, 0x02, 0x21, 0x1f, 0x35,
+    0x12, 0x02, 0x21, 0x1f, 0x35, 0x12, 0x02, 0x21, 0x1f, 0x35, 0x12, 0x02,
+    0x21, 0x1f, 0x35, 0x12, 0x02, 0x21, 0x1f, 0x36, 0x12, 0x02, 0x21, 0x1f,
+    0x36, 0x12, 0x02, 0x21, 0x1f, 0x36, 0x12, 0x02, 0x21, 0x1f, 0x36, 0x12,
+    0x02, 0x21, 0x1f, 0x36, 0x12, 0x02, 0x21, 0x1f, 0x36, 0x68, 0x0c, 0x22,
+    0x0f, 0x12, 0x02, 0x21, 0x1f, 0x36, 0x12, 0x02, 0x21, 0x1f, 0x36, 0x12,
+    0x02, 0x21, 0x1f, 0x36, 0x12, 0x02, 0x21, 0x1f, 0x37, 0x12, 0x02, 0x21,
+    0x1f, 0x37, 0x12, 0x02, 0x21, 0x1f, 0x37, 0x12, 0x02, 0x21, 0x1f, 0x37,
+    0x12, 0x02, 0x21, 0x1f, 0x37, 0x12, 0x02, 0x21, 0x1f, 0x37, 0x12, 0x02,
+    0x21, 0x1f, 0x37, 0x7b, 0x0e, 0x22, 0x0f, 0x12, 0x02, 0x21, 0x1f, 0x37,
+    0x12, 0x02, 0x21, 0x1f, 0x37, 0x12, 0x02, 0x17, 0x50, 0x20, 0x64, 0x6f,
+    0x67, 0x0a, 0x00, 0x00, 0x00, 0x00, 0xa6, 0x65, 0xfc, 0xb8,
+};
+
+static const uint8_t text_frame_flags[] = {
+    0x04, 0x22, 0x4d, 0x18, 0x74, 0x40, 0xbd, 0xbf, 0x01, 0x00, 0x00, 0xf1,
+    0x17, 0x6c, 0x69, 0x6e, 0x65, 0x20, 0x30, 0x3a, 0x20, 0x74, 0x68, 0x65,
+    0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20, 0x62, 0x72, 0x6f, 0x77, 0x6e,
+    0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75, 0x6d, 0x70, 0x73, 0x20, 0x6f,
+    0x76, 0x65, 0x72, 0x1f, 0x00, 0x91, 0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64,
+    0x6f, 0x67, 0x0a, 0x34, 0x00, 0x1f, 0x31, 0x34, 0x00, 0x20, 0x1f, 0x32,
+    0x34, 0x00, 0x20, 0x1f, 0x33, 0x34, 0x00, 0x20, 0x1f, 0x34, 0x34, 0x00,
+    0x20, 0x1f, 0x35, 0x34, 0x00, 0x20, 0x1f, 0x36, 0x34, 0x00, 0x20, 0x1f,
+    0x37, 0x34, 0x00, 0x20, 0x1f, 0x38, 0x34, 0x00, 0x20, 0x1f, 0x39, 0xd4,
+    0x01, 0x21, 0x0f, 0x09, 0x02, 0x22, 0x0f, 0x0a, 0x02, 0x21, 0x1f, 0x31,
+    0x0b, 0x02, 0x21, 0x1f, 0x31, 0x0c, 0x02, 0x21, 0x1f, 0x31, 0x0d, 0x02,
+    0x21, 0x1f, 0x31, 0x0e, 0x02, 0x21, 0x1f, 0x31, 0x0f, 0x02, 0x21, 0x1f,
+    0x31, 0x10, 0x02, 0x21, 0x1f, 0x31, 0x11, 0x02, 0x21, 0x1f, 0x31, 0x12,
+    0x02, 0x21, 0x1f, 0x32, 0x12, 0x02, 0x21, 0x1f, 0x32, 0x1c, 0x04, 0x22,
+    0x0f, 0x12, 0x02, 0x21, 0x1f, 0x32, 0x12, 0x02, 0x21, 0x1f, 0x32, 0x12,
+    0x02, 0x21, 0x1f, 0x32, 0x12, 0x02, 0x21, 0x1f, 0x32, 0x12, 0x02, 0x21,
+    0x1f, 0x32, 0x12, 0x02, 0x21, 0x1f, 0x32, 0x12, 0x02, 0x21, 0x1f, 0x32,
+    0x12, 0x02, 0x21, 0x1f, 0x33, 0x12, 0x02, 0x21, 0x1f, 0x33, 0x12, 0x02,
+    0x21, 0x1f, 0x33, 0x2f, 0x06, 0x22, 0x0f, 0x12, 0x02, 0x21, 0x1f, 0x33,
+    0x12, 0x02, 0x21, 0x1f, 0x33, 0x12, 0x02, 0x21, 0x1f, 0x33, 0x12, 0x02,
+    0x21, 0x1f, 0x33, 0x12, 0x02, 0x21, 0x1f, 0x33, 0x12, 0x02, 0x21, 0x1f,
+    0x33, 0x12, 0x02, 0x21, 0x1f, 0x34, 0x12, 0x02, 0x21, 0x1f, 0x34, 0x12,
+    0x02, 0x21, 0x1f, 0x34, 0x12, 0x02, 0x21, 0x1f, 0x34, 0x42, 0x08, 0x22,
+    0x0f, 0x12, 0x02, 0x21, 0x1f, 0x34, 0x12, 0x02, 0x21, 0x1f, 0x34, 0x12,
+    0x02, 0x21, 0x1f, 0x34, 0x12, 0x02, 0x21, 0x1f, 0x34, 0x12, 0x02, 0x21,
+    0x1f, 0x34, 0x12, 0x02, 0x21, 0x1f, 0x35, 0x12, 0x02, 0x21, 0x1f, 0x35,
+    0x12, 0x02, 0x21, 0x1f, 0x35, 0x12, 0x02, 0x21, 0x1f, 0x35, 0x12, 0x02,
+    0x21, 0x1f, 0x35, 0x55, 0x0a, 0x22, 0x0f, 0x12, 0x02, 0x21, 0x1f, 0x35,
+    0x12, 0x02, 0x21, 0x1f, 0x35, 0x12, 0x02, 0x21, 0x1f, 0x35, 0x12, 0x02,
+    0x21, 0x1f, 0x35, 0x12, 0x02, 0x21, 0x1f, 0x36, 0x12, 0x02, 0x21, 0x1f,
+    0x36, 0x12, 0x02, 0x21, 0x1f, 0x36, 0x12, 0x02, 0x21, 0x1f, 0x36, 0x12,
+    0x02, 0x21, 0x1f, 0x36, 0x12, 0x02, 0x21, 0x1f, 0x36, 0x68, 0x0c, 0x22,
+    0x0f, 0x12, 0x02, 0x21, 0x1f, 0x36, 0x12, 0x02, 0x21, 0x1f, 0x36, 0x12,
+    0x02, 0x21, 0x1f, 0x36, 0x12, 0x02, 0x21, 0x1f, 0x37, 0x12, 0x02, 0x21,
+    0x1f, 0x37, 0x12, 0x02, 0x21, 0x1f, 0x37, 0x12, 0x02, 0x21, 0x1f, 0x37,
+    0x12, 0x02, 0x21, 0x1f, 0x37, 0x12, 0x02, 0x21, 0x1f, 0x37, 0x12, 0x02,
+    0x21, 0x1f, 0x37, 0x7b, 0x0e, 0x22, 0x0f, 0x12, 0x02, 0x21, 0x1f, 0x37,
+    0x12, 0x02, 0x21, 0x1f, 0x37, 0x12, 0x02, 0x17, 0x50, 0x20, 0x64, 0x6f,
+    0x67, 0x0a, 0xbb, 0x86, 0x98, 0x8c, 0x00, 0x00, 0x00, 0x00, 0xa6, 0x65,
+    0xfc, 0xb8,
+};
+
+static const uint8_t noise_frame[] = {
+    0x04, 0x22, 0x4d, 0x18, 0x64, 0x40, 0xa7, 0x40, 0x00, 0x00, 0x80, 0xdc,
+    0x04, 0x65, 0xaa, 0x1f, 0xad, 0x1d, 0x5a, 0xda, 0xe5, 0xac, 0x1b, 0x1e,
+    0x5f, 0x13, 0x70, 0x79, 0x6c, 0xfd, 0x10, 0xff, 0x19, 0xaf, 0x60, 0x1d,
+    0x04, 0xac, 0xb4, 0x1d, 0x02, 0x2b, 0x46, 0x78, 0x73, 0x3a, 0xf2, 0xdf,
+    0x5f, 0xae, 0xb7, 0x08, 0x59, 0xd1, 0xee, 0x39, 0x10, 0xcb, 0x48, 0x95,
+    0xb5, 0xcc, 0x89, 0x29, 0x11, 0xff, 0x06, 0xb6, 0x62, 0x2e, 0xdf, 0x3c,
+    0xf9, 0x35, 0xfd, 0x00, 0x00, 0x00, 0x00, 0x15, 0x15, 0xcf, 0x35,
+};
+
+static const uint8_t far_frame[] = {
+    0x04, 0x22, 0x4d, 0x18, 0x64, 0x40, 0xa7, 0x2a, 0x00, 0x00, 0x00, 0xfb,
+    0x11, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x61,
+    0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d,
+    0x6e, 0x6f, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x20, 0x00, 0x50,
+    0x66, 0x67, 0x68, 0x69, 0x6a, 0x00, 0x00, 0x00, 0x00, 0x76, 0x04, 0xa7,
+    0x1d,
+};
+
+static const uint8_t distant_frame[] = {
+    0x04, 0x22, 0x4d, 0x18, 0x64, 0x40, 0xa7, 0x85, 0x01, 0x00, 0x00, 0xff,
+    0xf2, 0xdc, 0x04, 0x65, 0xaa, 0x1f, 0xad, 0x1d, 0x5a, 0xda, 0xe5, 0xac,
+    0x1b, 0x1e, 0x5f, 0x13, 0x70, 0x79, 0x6c, 0xfd, 0x10, 0xff, 0x19, 0xaf,
+    0x60, 0x1d, 0x04, 0xac, 0xb4, 0x1d, 0x02, 0x2b, 0x46, 0x78, 0x73, 0x3a,
+    0xf2, 0xdf, 0x5f, 0xae, 0xb7, 0x08, 0x59, 0xd1, 0xee, 0x39, 0x10, 0xcb,
+    0x48, 0x95, 0xb5, 0xcc, 0x89, 0x29, 0x11, 0xff, 0x06, 0xb6, 0x62, 0x2e,
+    0xdf, 0x3c, 0xf9, 0x35, 0xfd, 0x4b, 0x94, 0x28, 0xca, 0x09, 0x7c, 0x44,
+    0xb3, 0x02, 0x5e, 0x96, 0x5f, 0xb3, 0xea, 0x6d, 0xac, 0xd4, 0x2d, 0x81,
+    0x6e, 0x69, 0xaf, 0xe0, 0xe6, 0x87, 0x4c, 0x9c, 0x04, 0xe7, 0xd2, 0x36,
+    0x5d, 0x2c, 0x60, 0xc9, 0xea, 0xf4, 0x79, 0xf6, 0x86, 0xa0, 0xeb, 0x93,
+    0x26, 0xe4, 0x62, 0x12, 0xd5, 0x0d, 0xcb, 0xb3, 0x77, 0x15, 0x6a, 0x6a,
+    0x3a, 0x68, 0xba, 0x8e, 0xdb, 0x74, 0x08, 0x46, 0x9e, 0xf3, 0xce, 0xb3,
+    0x0a, 0xf8, 0xd0, 0xdd, 0x68, 0xbb, 0xf8, 0x5f, 0xfa, 0x24, 0xf2, 0xd2,
+    0xfc, 0x18, 0x87, 0xfb, 0x5c, 0x87, 0xba, 0xb4, 0x38, 0x32, 0xa5, 0x9b,
+    0x1b, 0x3d, 0x10, 0x7c, 0xf7, 0x78, 0xd6, 0x7f, 0xe2, 0x6d, 0xf8, 0x11,
+    0x91, 0x29, 0x7e, 0x93, 0x95, 0xcb, 0x12, 0xc5, 0x57, 0xce, 0x5a, 0xf1,
+    0xd4, 0x16, 0x18, 0xd7, 0x19, 0xbc, 0x04, 0x5b, 0x7e, 0x99, 0x65, 0xf1,
+    0xa2, 0x94, 0x71, 0xc4, 0x2a, 0xac, 0x6a, 0xa9, 0x38, 0xc4, 0x75, 0xc7,
+    0xad, 0x32, 0x38, 0x02, 0x1f, 0x05, 0x3b, 0x2c, 0x99, 0x1a, 0xfc, 0xeb,
+    0x15, 0xde, 0xcf, 0x68, 0xba, 0xe0, 0x7c, 0xbc, 0xd6, 0x1e, 0x97, 0x1b,
+    0x9a, 0x0b, 0x9d, 0xbe, 0x97, 0x63, 0xd3, 0x92, 0xfc, 0xaf, 0xdf, 0xa2,
+    0x8c, 0x97, 0x23, 0x45, 0x62, 0xeb, 0xdd, 0x07, 0x65, 0x70, 0xff, 0x58,
+    0x89, 0x6a, 0xcf, 0xf7, 0xca, 0x00, 0x01, 0x00, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x91, 0x0f, 0x30, 0x76, 0xe8, 0x50, 0x89,
+    0x6a, 0xcf, 0xf7, 0xca, 0x00, 0x00, 0x00, 0x00, 0xe7, 0x4c, 0x42, 0x01,
+};
+
+static std::string text() {
+    std::string s;
+    for (int i = 0; i < 80; ++i)
+        s += "line " + std::to_string(i) + ": the quick brown fox jumps over the lazy dog\n";
+    return s;
+}
+
+static std::string noise() {
+    std::string s;
+    uint32_t x = 12345;
+    for (int i = 0; i < 64; ++i) {
+        x = (x * 1103515245 + 12345) & 0x7fffffff;
+        s += static_cast<char>((x >> 16) & 0xff);
+    }
+    return s;
+}
+
+/* Noise, a long run of zeros, then the noise again: the second copy is a
+ * match about 30 KB back. */
+static std::string distant() {
+    std::string n;
+    uint32_t x = 12345;
+    for (int i = 0; i < 256; ++i) {
+        x = (x * 1103515245 + 12345) & 0x7fffffff;
+        n += static_cast<char>((x >> 16) & 0xff);
+    }
+    return n + std::string(30000, '\0') + n;
+}
+
+template <size_t N>
+static std::string as_string(const uint8_t (&data)[N]) {
+    return {reinterpret_cast<const char*>(data), N};
+}
+
+/* Decodes everything, chunk bytes per read(). */
+template <typename Reader>
+static std::string decode_all(Reader& reader, size_t chunk, bool& ok) {
+    std::string out;
+    std::string buffer(chunk, '\0');
+    ok = true;
+
+    while (true) {
+        auto result = reader.read(&buffer[0], chunk);
+        if (result.is_error()) {
+            ok = false;
+            break;
+        }
+        if (*result == 0)
+            break;
+        out.append(buffer, 0, *result);
+    }
+    return out;
+}
+
+/* Decodes until the first error, returns its code or FR_OK. */
+template <typename Reader>
+static uint32_t decode_error(Reader& reader) {
+    char buffer[64];
+    while (true) {
+        auto result = reader.read(buffer, sizeof(buffer));
+        if (result.is_error())
+            return result.error().code();
+        if (*result == 0)
+            return FR_OK;
+    }
+}
+
+TEST_SUITE_BEGIN("Test BufferLZ4Reader");
+
+TEST_CASE("It decodes a reference frame.") {
+    MockFile f{as_string(text_frame)};
+    BufferLZ4Reader<MockFile> reader{f};
+    bool ok;
+
+    CHECK_EQ(decode_all(reader, 256, ok), text());
+    CHECK(ok);
+    CHECK_EQ(reader.compressed_bytes(), sizeof(text_frame));
+    CHECK_EQ(reader.decompressed_bytes(), text().size());
+}
+
+TEST_CASE("It decodes with any read size.") {
+    for (size_t chunk : {1, 3, 7, 64, 1000, 8192}) {
+        MockFile f{as_string(text_frame)};
+        BufferLZ4Reader<MockFile> reader{f};
+        bool ok;
+
+        CHECK_EQ(decode_all(reader, chunk, ok), text());
+        CHECK(ok);
+    }
+}
+
+TEST_CASE("It skips content size and checksums.") {
+    MockFile f{as_string(text_frame_flags)};
+    BufferLZ4Reader<MockFile> reader{f};
+    bool ok;
+
+    CHECK_EQ(decode_all(reader, 100, ok), text());
+    CHECK(ok);
+}
+
+TEST_CASE("It decodes uncompressed blocks.") {
+    MockFile f{as_string(noise_frame)};
+    BufferLZ4Reader<MockFile> reader{f};
+    bool ok;
+
+    CHECK_EQ(decode_all(reader, 10, ok), noise());
+    CHECK(ok);
+}
+
+TEST_CASE("It decodes concatenated and skippable frames.") {
+    const std::string skippable{"\x5a\x2a\x4d\x18\x03\x00\x00\x00xyz", 11};
+    MockFile f{as_string(noise_frame) + skippable + as_string(text_frame)};
+    BufferLZ4Reader<MockFile> reader{f};
+    bool ok;
+
+    CHECK_EQ(decode_all(reader, 33, ok), noise() + text());
+    CHECK(ok);
+}
+
+TEST_CASE("It returns 0 on an empty file.") {
+    MockFile f{""};
+    BufferLZ4Reader<MockFile> reader{f};
+    char c;
+
+    auto result = reader.read(&c, 1);
+    REQUIRE(result.is_ok());
+    CHECK_EQ(*result, 0);
+}
+
+TEST_CASE("It fails on a bad magic number.") {
+    auto data = as_string(text_frame);
+    data[0] ^= 0xff;
+    MockFile f{data};
+    BufferLZ4Reader<MockFile> reader{f};
+    bool ok;
+
+    decode_all(reader, 64, ok);
+    CHECK_FALSE(ok);
+}
+
+TEST_CASE("It fails on a truncated frame.") {
+    MockFile f{as_string(text_frame).substr(0, sizeof(text_frame) / 2)};
+    BufferLZ4Reader<MockFile> reader{f};
+    bool ok;
+
+    decode_all(reader, 64, ok);
+    CHECK_FALSE(ok);
+}
+
+TEST_CASE("It fails on a match beyond the window.") {
+    MockFile f{as_string(far_frame)};
+    BufferLZ4Reader<MockFile, 16> reader{f};
+    CHECK_EQ(decode_error(reader), FR_NOT_ENOUGH_CORE);
+
+    MockFile f2{as_string(far_frame)};
+    BufferLZ4Reader<MockFile> reader2{f2};
+    bool ok;
+    CHECK_EQ(decode_all(reader2, 64, ok), "0123456789abcdefghijklmnopqrstuv0123456789abcdefghij");
+    CHECK(ok);
+}
+
+TEST_CASE("It decodes matches far back with a larger window.") {
+    MockFile f{as_string(distant_frame)};
+    BufferLZ4Reader<MockFile> reader{f};
+    CHECK_EQ(decode_error(reader), FR_NOT_ENOUGH_CORE);
+
+    MockFile f2{as_string(distant_frame)};
+    BufferLZ4Reader<MockFile, 32768> reader2{f2};
+    bool ok;
+    CHECK(decode_all(reader2, 500, ok) == distant());
+    CHECK(ok);
+}
+
+TEST_CASE("It rejects frames that need more than 64 KiB blocks.") {
+    // Block max size ID 7, 4 MiB.
+    auto data = as_string(text_frame);
+    data[5] = 0x70;
+    MockFile f{data};
+    BufferLZ4Reader<MockFile> reader{f};
+
+    CHECK_EQ(decode_error(reader), FR_INVALID_PARAMETER);
+}
+
+TEST_CASE("It rejects frames with linked blocks.") {
+    auto data = as_string(text_frame);
+    data[4] &= ~0x20;
+    MockFile f{data};
+    BufferLZ4Reader<MockFile> reader{f};
+
+    CHECK_EQ(decode_error(reader), FR_INVALID_PARAMETER);
+}
+
+TEST_CASE("Benchmark decode throughput.") {
+    constexpr int iterations = 2000;
+    const auto frame = as_string(text_frame);
+    std::array<uint8_t, 512> buffer;
+    uint64_t total = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        MockFile f{frame};
+        BufferLZ4Reader<MockFile> reader{f};
+        while (true) {
+            auto result = reader.read(buffer.data(), buffer.size());
+            if (result.is_error() || *result == 0)
+                break;
+            total += *result;
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    CHECK_EQ(total, text().size() * iterations);
+    MESSAGE("LZ4 decode: " << (total / elapsed.count() / 1e6) << " MB/s");
+}
+
+TEST_SUITE_END();
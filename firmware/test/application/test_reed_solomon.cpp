@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "doctest.h"
+#include "reed_solomon.hpp"
+
+#include <chrono>
+
+using namespace reed_solomon;
+
+namespace {
+
+/* Small LCG, repeatable across runs. */
+uint32_t next_random(uint32_t& state) {
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+codeword_t make_codeword(uint32_t seed, size_t length = codeword_size) {
+    codeword_t codeword{};
+    for (size_t i = parity_size; i < length; i++)
+        codeword[i] = next_random(seed);
+    encode(codeword);
+    return codeword;
+}
+
+/* Flips count distinct symbols below length with non-zero patterns. */
+void inject_errors(codeword_t& codeword, size_t count, uint32_t seed, size_t length = codeword_size) {
+    std::array<bool, codeword_size> hit{};
+    while (count > 0) {
+        const auto pos = next_random(seed) % length;
+        const uint8_t pattern = (next_random(seed) % 255) + 1;
+        if (hit[pos])
+            continue;
+        hit[pos] = true;
+        codeword[pos] ^= pattern;
+        count--;
+    }
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("Reed-Solomon");
+
+TEST_CASE("decode should accept a clean codeword.") {
+    auto codeword = make_codeword(1);
+    const auto original = codeword;
+
+    CHECK_EQ(decode(codeword), 0);
+    CHECK(codeword == original);
+}
+
+TEST_CASE("decode should correct up to max_errors symbols.") {
+    for (size_t errors = 1; errors <= max_errors; errors++) {
+        const auto original = make_codeword(errors);
+        auto codeword = original;
+        inject_errors(codeword, errors, errors * 7);
+
+        CHECK_EQ(decode(codeword), errors);
+        CHECK(codeword == original);
+    }
+}
+
+TEST_CASE("decode should correct errors in the parity.") {
+    const auto original = make_codeword(2);
+    auto codeword = original;
+    for (size_t i = 0; i < max_errors; i++)
+        codeword[i * 2] ^= 0x55;
+
+    CHECK_EQ(decode(codeword), max_errors);
+    CHECK(codeword == original);
+}
+
+TEST_CASE("decode should leave an uncorrectable codeword untouched.") {
+    size_t failures = 0;
+    for (uint32_t seed = 0; seed < 20; seed++) {
+        auto codeword = make_codeword(seed);
+        inject_errors(codeword, max_errors + 4, seed + 100);
+        const auto corrupted = codeword;
+
+        // Past the bound a miscorrection to another codeword is possible, but rare.
+        if (decode(codeword) < 0) {
+            CHECK(codeword == corrupted);
+            failures++;
+        }
+    }
+    CHECK_GE(failures, 18);
+}
+
+TEST_CASE("decode should correct a shortened codeword.") {
+    constexpr size_t length = parity_size + 132;
+    const auto original = make_codeword(3, length);
+    auto codeword = original;
+    inject_errors(codeword, max_errors, 33, length);
+
+    CHECK_EQ(decode(codeword, length), max_errors);
+    CHECK(codeword == original);
+}
+
+TEST_CASE("decode should reject an error located in the padding.") {
+    constexpr size_t length = parity_size + 132;
+    // Parity of a lone symbol at 200: seen shortened, it is a clean codeword
+    // plus a single error in the padding, which can't be corrected.
+    codeword_t codeword{};
+    codeword[200] = 0x12;
+    encode(codeword);
+    codeword[200] = 0;
+    const auto corrupted = codeword;
+
+    CHECK_EQ(decode(codeword, length), -1);
+    CHECK(codeword == corrupted);
+    CHECK_EQ(decode(codeword), 1);
+}
+
+TEST_CASE("Benchmark decode.") {
+    constexpr size_t length = parity_size + 132;
+    constexpr size_t rounds = 1000;
+    const auto original = make_codeword(5, length);
+
+    using clock = std::chrono::steady_clock;
+    for (size_t errors : {size_t{0}, size_t{4}, max_errors}) {
+        auto codeword = original;
+        inject_errors(codeword, errors, 55, length);
+        const auto corrupted = codeword;
+
+        const auto start = clock::now();
+        for (size_t i = 0; i < rounds; i++) {
+            codeword = corrupted;
+            CHECK_EQ(decode(codeword, length), errors);
+        }
+        const auto elapsed = std::chrono::duration<double, std::micro>(clock::now() - start);
+
+        MESSAGE(errors << " errors: " << elapsed.count() / rounds << " us per codeword");
+    }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "reed_solomon.hpp"
+#include "sonde_packet.hpp"
+#include "string_format.hpp"
+
+#include <array>
+#include <string>
+
+namespace {
+
+/* Bytes after the 4 consumed by proc_sonde: the 316 byte standard frame, then
+ * 4 more that fill the 2560 bit packet. */
+constexpr size_t packet_bytes = 320;
+constexpr size_t frame_bytes = 316;
+constexpr size_t parity_pos = 0x04;
+constexpr size_t message_pos = 0x34;
+constexpr size_t message_length = (frame_bytes - message_pos) / 2;
+
+using frame_t = std::array<uint8_t, packet_bytes>;
+
+constexpr uint8_t vaisala_mask[64] = {
+    0x96, 0x83, 0x3E, 0x51, 0xB1, 0x49, 0x08, 0x98,
+    0x32, 0x05, 0x59, 0x0E, 0xF9, 0x44, 0xC6, 0x26,
+    0x21, 0x60, 0xC2, 0xEA, 0x79, 0x5D, 0x6D, 0xA1,
+    0x54, 0x69, 0x47, 0x0C, 0xDC, 0xE8, 0x5C, 0xF1,
+    0xF7, 0x76, 0x82, 0x7F, 0x07, 0x99, 0xA2, 0x2C,
+    0x93, 0x7C, 0x30, 0x63, 0xF5, 0x10, 0x2E, 0x61,
+    0xD0, 0xBC, 0xB4, 0xB6, 0x06, 0xAA, 0xF4, 0x23,
+    0x78, 0x6E, 0x3B, 0xAE, 0xBF, 0x7B, 0x4C, 0xC1};
+
+uint32_t next_random(uint32_t& state) {
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+/* Writes an RS41 block: ID, length, data, CRC16 (CCITT, 0xFFFF, LSB first). */
+size_t put_block(frame_t& frame, size_t pos, uint8_t id, const std::string& data) {
+    frame[pos++] = id;
+    frame[pos++] = data.size();
+
+    uint16_t crc = 0xFFFF;
+    for (const uint8_t c : data) {
+        frame[pos++] = c;
+        crc ^= c << 8;
+        for (size_t j = 0; j < 8; j++)
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+
+    frame[pos++] = crc & 0xFF;
+    frame[pos++] = crc >> 8;
+    return pos;
+}
+
+/* Standard RS41 frame with valid blocks and parity, as a sonde sends it. */
+frame_t make_frame(uint8_t frame_type = 0x0F) {
+    frame_t frame{};
+    uint32_t seed = 41;
+    for (auto& b : frame)
+        b = next_random(seed);
+
+    // Last 4 bytes of the header.
+    frame[0] = 0x93;
+    frame[1] = 0xDF;
+    frame[2] = 0x1A;
+    frame[3] = 0x60;
+    frame[message_pos] = frame_type;
+
+    // Status: frame number 0x1234, serial, battery 2.9 V, then filler.
+    std::string status{"\x34\x12P3213708\x1D"};
+    status.resize(40, '\x01');
+    size_t pos = put_block(frame, 0x35, 0x79, status);
+    pos = put_block(frame, pos, 0x7A, std::string(42, '\x55'));
+    CHECK(pos == 0x8F);
+    CHECK(put_block(frame, 0x10E, 0x7B, std::string(21, '\x33')) == 0x127);
+    CHECK(put_block(frame, 0x127, 0x76, std::string(17, '\0')) == frame_bytes);
+
+    for (size_t k = 0; k < 2; k++) {
+        reed_solomon::codeword_t codeword{};
+        for (size_t i = 0; i < message_length; i++)
+            codeword[reed_solomon::parity_size + i] = frame[message_pos + 2 * i + k];
+        reed_solomon::encode(codeword);
+        for (size_t i = 0; i < reed_solomon::parity_size; i++)
+            frame[parity_pos + k * reed_solomon::parity_size + i] = codeword[i];
+    }
+
+    return frame;
+}
+
+/* Scrambles the frame and packs its bits the way proc_sonde delivers them. */
+sonde::Packet make_packet(const frame_t& frame) {
+    baseband::Packet packet{};
+    for (size_t pos = 0; pos < frame.size(); pos++) {
+        const uint8_t value = frame[pos] ^ vaisala_mask[(pos + 4) % 64];
+        for (size_t bit = 0; bit < 8; bit++)
+            packet.add((value >> bit) & 1);
+    }
+    return {packet, sonde::Packet::Type::Vaisala_RS41_SG};
+}
+
+std::string to_hex(const frame_t& frame) {
+    std::string hex;
+    for (const auto b : frame)
+        hex += to_string_hex(b, 2);
+    return hex;
+}
+
+/* Flips one byte of codeword k at index i (parity first, then message). */
+void corrupt(frame_t& frame, size_t k, size_t i, uint8_t pattern) {
+    if (i < reed_solomon::parity_size)
+        frame[parity_pos + k * reed_solomon::parity_size + i] ^= pattern;
+    else
+        frame[message_pos + 2 * (i - reed_solomon::parity_size) + k] ^= pattern;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("RS41 frame");
+
+TEST_CASE("A clean frame should pass unchanged.") {
+    const auto frame = make_frame();
+    const auto packet = make_packet(frame);
+
+    CHECK(packet.crc_ok());
+    CHECK_EQ(packet.rs_errors(), 0);
+    CHECK_EQ(packet.symbols_formatted().data, to_hex(frame));
+    CHECK_EQ(packet.serial_number(), "P3213708");
+    CHECK_EQ(packet.frame(), 0x1234);
+}
+
+TEST_CASE("rs41_correct should restore a frame with byte errors.") {
+    const auto frame = make_frame();
+    auto received = frame;
+
+    // 12 errors per codeword, in the parity, the frame number, the serial
+    // and all three CRC checked blocks.
+    for (size_t k = 0; k < 2; k++) {
+        for (size_t i = 0; i < reed_solomon::max_errors; i++)
+            corrupt(received, k, i * 13 + k, 0xA5 >> k);
+    }
+    REQUIRE(received != frame);
+
+    const auto packet = make_packet(received);
+    CHECK(packet.crc_ok());
+    CHECK_EQ(packet.rs_errors(), 2 * reed_solomon::max_errors);
+    CHECK_EQ(packet.symbols_formatted().data, to_hex(frame));
+    CHECK_EQ(packet.serial_number(), "P3213708");
+    CHECK_EQ(packet.frame(), 0x1234);
+}
+
+TEST_CASE("rs41_correct should leave a frame beyond repair as received.") {
+    auto received = make_frame();
+    for (size_t i = 0; i <= reed_solomon::max_errors; i++)
+        corrupt(received, 1, reed_solomon::parity_size + i, 0xFF);
+
+    const auto packet = make_packet(received);
+    CHECK_EQ(packet.rs_errors(), -1);
+    CHECK_FALSE(packet.crc_ok());
+    CHECK_EQ(packet.symbols_formatted().data, to_hex(received));
+}
+
+TEST_CASE("rs41_correct should leave an extended frame uncorrected.") {
+    // The codewords of an extended frame run past the captured bytes, the
+    // frame is passed on as received and only the CRC check applies.
+    const auto frame = make_frame(0xF0);
+    CHECK(make_packet(frame).crc_ok());
+    CHECK_EQ(make_packet(frame).rs_errors(), -1);
+
+    auto received = frame;
+    corrupt(received, 0, reed_solomon::parity_size + 2, 0x01);
+    const auto packet = make_packet(received);
+    CHECK_EQ(packet.rs_errors(), -1);
+    CHECK_FALSE(packet.crc_ok());
+    CHECK_EQ(packet.symbols_formatted().data, to_hex(received));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "btle_access_address.hpp"
+#include "doctest.h"
+
+#include <vector>
+
+namespace {
+
+constexpr uint32_t access_address = 0x8E89BED6;
+
+/* Noise, the preamble, then the access address LSB first with the bits in
+ * error_mask flipped. */
+std::vector<uint32_t> make_bits(const uint32_t error_mask) {
+    std::vector<uint32_t> bits;
+    uint32_t seed = 27;
+    for (size_t i = 0; i < 40; i++) {
+        seed = seed * 1664525 + 1013904223;
+        bits.push_back(seed >> 31);
+    }
+    for (size_t i = 0; i < 8; i++)
+        bits.push_back(i & 1);  // 0xAA, sent before an address starting with 0.
+
+    const uint32_t received = access_address ^ error_mask;
+    for (size_t i = 0; i < 32; i++)
+        bits.push_back((received >> i) & 1);
+    return bits;
+}
+
+/* Index of the bit a match is reported on, -1 for none. */
+int find_hit(AccessAddressCorrelator<1>& correlator, const std::vector<uint32_t>& bits) {
+    correlator.reset();
+    for (size_t i = 0; i < bits.size(); i++) {
+        if (correlator.execute(0, bits[i]))
+            return i;
+    }
+    return -1;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("BTLE access address");
+
+TEST_CASE("A clean access address is found on its last bit.") {
+    AccessAddressCorrelator<1> correlator{access_address};
+    const auto bits = make_bits(0);
+
+    CHECK_EQ(find_hit(correlator, bits), bits.size() - 1);
+}
+
+TEST_CASE("Bit errors up to the tolerance are accepted.") {
+    AccessAddressCorrelator<1> correlator{access_address};
+    correlator.set_tolerance(2);
+
+    CHECK_EQ(find_hit(correlator, make_bits(0x00000001)), 79);
+    CHECK_EQ(find_hit(correlator, make_bits(0x80000100)), 79);
+}
+
+TEST_CASE("More bit errors than the tolerance are rejected.") {
+    AccessAddressCorrelator<1> correlator{access_address};
+
+    CHECK_EQ(find_hit(correlator, make_bits(0x00010000)), -1);
+
+    correlator.set_tolerance(2);
+    CHECK_EQ(find_hit(correlator, make_bits(0x80100100)), -1);
+}
+
+TEST_CASE("The tolerance is limited to max_tolerance.") {
+    AccessAddressCorrelator<1> correlator{access_address};
+    correlator.set_tolerance(10);
+
+    CHECK_EQ(find_hit(correlator, make_bits(0x0000000F)), 79);
+    CHECK_EQ(find_hit(correlator, make_bits(0x0000001F)), -1);
+}
+
+TEST_CASE("Nothing matches before 32 bits were received.") {
+    // A register cleared to zero already matches an all-zero address.
+    AccessAddressCorrelator<1> correlator{0};
+    const std::vector<uint32_t> bits(32, 0);
+
+    CHECK_EQ(find_hit(correlator, bits), 31);
+}
+
+TEST_CASE("Each sample phase is correlated on its own.") {
+    AccessAddressCorrelator<2> correlator{access_address};
+    const auto bits = make_bits(0);
+    int hit = -1;
+
+    // Phase 1 carries the packet, phase 0 its inverse.
+    for (size_t i = 0; (i < bits.size()) && (hit == -1); i++) {
+        CHECK_FALSE(correlator.execute(0, bits[i] ^ 1));
+        if (correlator.execute(1, bits[i]))
+            hit = i;
+    }
+
+    CHECK_EQ(hit, bits.size() - 1);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "channel_monitor.hpp"
+#include "doctest.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t sampling_rate = 384000;
+
+/* Feeds frames of a tone of amplitude until the first report. */
+ChannelMonitorMessage monitor_tone(
+    const float frequency,
+    const float amplitude,
+    const int32_t squelch_db,
+    const std::array<int32_t, ChannelMonitorConfigMessage::max_channels>& offsets = {{-25000, 0, 25000, 37500}}) {
+    ChannelMonitor monitor;
+    monitor.configure(ChannelMonitorConfigMessage{offsets, 4, 12500, squelch_db, 7}, sampling_rate);
+
+    std::array<std::complex<float>, ChannelMonitor::fft_size> frame{};
+    std::vector<ChannelMonitorMessage> reports{};
+
+    size_t n = 0;
+    for (size_t frame_index = 0; (frame_index < 100) && reports.empty(); frame_index++) {
+        // Bit reversed order for the FFT, as fft_swap() would on the M4.
+        for (size_t i = 0; i < frame.size(); i++) {
+            const float phase = 2 * M_PI * frequency * n++ / sampling_rate;
+            size_t i_rev = 0;
+            for (size_t b = 0; b < ChannelMonitor::fft_size_log2; b++)
+                i_rev |= ((i >> b) & 1) << (ChannelMonitor::fft_size_log2 - 1 - b);
+            frame[i_rev] = {
+                static_cast<float>(static_cast<int16_t>(amplitude * std::cos(phase))),
+                static_cast<float>(static_cast<int16_t>(amplitude * std::sin(phase)))};
+        }
+        fft_c_preswapped(frame, 0, ChannelMonitor::fft_size_log2);
+
+        monitor.feed_spectrum(frame.data(), [&reports](const ChannelMonitorMessage& message) {
+            reports.push_back(message);
+        });
+    }
+
+    REQUIRE(reports.size() == 1);
+    return reports.front();
+}
+
+}  // namespace
+
+TEST_CASE("channel monitor flags the channel holding a tone") {
+    const auto report = monitor_tone(25000.0f, 16384.0f, -30);
+    CHECK(report.sequence == 7);
+    CHECK(report.channel_count == 4);
+    CHECK(report.active == 0b0100);
+
+    // Half scale reads about -6 dB, less the Hamming window coherent gain.
+    CHECK(report.db[2] <= -6);
+    CHECK(report.db[2] >= -13);
+    CHECK(report.db[0] < -50);
+}
+
+TEST_CASE("channel monitor follows a tone at a negative offset") {
+    const auto report = monitor_tone(-27000.0f, 16384.0f, -30);
+    CHECK(report.active == 0b0001);
+}
+
+TEST_CASE("channel monitor stays quiet below squelch") {
+    const auto report = monitor_tone(0.0f, 100.0f, -30);
+    CHECK(report.active == 0);
+    CHECK(report.db[1] < -30);
+    CHECK(report.db[1] > -60);
+}
+
+TEST_CASE("channel monitor ignores channels beyond the maximum offset") {
+    const auto report = monitor_tone(100000.0f, 16384.0f, -30, {{-25000, 0, 25000, 100000}});
+    CHECK(report.active == 0);
+}
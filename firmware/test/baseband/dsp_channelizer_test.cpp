@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "dsp_channelizer.hpp"
+#include "dsp_fir_taps.hpp"
+#include "doctest.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t sampling_rate = 307200;
+
+/* Power of the output of each channel for a tone at frequency. */
+std::array<float, 2> channel_powers(const float frequency) {
+    dsp::channelizer::PolyphaseChannelizer<2> channelizer;
+    channelizer.configure(taps_11k0_decim_1.taps, {{-25000, 25000}}, sampling_rate);
+
+    std::vector<complex16_t> input(256);
+    std::array<std::vector<complex16_t>, 2> output{std::vector<complex16_t>(32), std::vector<complex16_t>(32)};
+    std::array<float, 2> power{};
+
+    size_t n = 0;
+    for (size_t block = 0; block < 8; block++) {
+        for (auto& s : input) {
+            const float phase = 2 * M_PI * frequency * n++ / sampling_rate;
+            s = {static_cast<int16_t>(8000 * std::cos(phase)), static_cast<int16_t>(8000 * std::sin(phase))};
+        }
+
+        const buffer_c16_t src{input.data(), input.size(), sampling_rate};
+        const auto count = channelizer.execute(src, {output[0].data(), output[1].data()});
+        REQUIRE(count == 32);
+
+        // Skip the first block, the filter is still filling.
+        if (block == 0) continue;
+        for (size_t c = 0; c < 2; c++) {
+            for (size_t i = 0; i < count; i++)
+                power[c] += std::norm(std::complex<float>(output[c][i].real(), output[c][i].imag()));
+        }
+    }
+    return power;
+}
+
+}  // namespace
+
+TEST_CASE("channelizer passes a tone to its channel only") {
+    const auto upper = channel_powers(25000.0f);
+    CHECK(10 * std::log10(upper[1] / upper[0]) > 40.0f);
+
+    const auto lower = channel_powers(-25000.0f);
+    CHECK(10 * std::log10(lower[0] / lower[1]) > 40.0f);
+}
+
+TEST_CASE("channelizer brings the channel to DC with unity gain") {
+    dsp::channelizer::PolyphaseChannelizer<1> channelizer;
+    channelizer.configure(taps_11k0_decim_1.taps, {{25000}}, sampling_rate);
+
+    std::vector<complex16_t> input(256);
+    std::vector<complex16_t> output(32);
+
+    size_t n = 0;
+    for (size_t block = 0; block < 4; block++) {
+        for (auto& s : input) {
+            const float phase = 2 * M_PI * 25000.0f * n++ / sampling_rate;
+            s = {static_cast<int16_t>(8000 * std::cos(phase)), static_cast<int16_t>(8000 * std::sin(phase))};
+        }
+        const buffer_c16_t src{input.data(), input.size(), sampling_rate};
+        channelizer.execute(src, {output.data()});
+    }
+
+    // A constant phasor of the input amplitude.
+    for (size_t i = 1; i < output.size(); i++) {
+        const std::complex<float> a{static_cast<float>(output[i - 1].real()), static_cast<float>(output[i - 1].imag())};
+        const std::complex<float> b{static_cast<float>(output[i].real()), static_cast<float>(output[i].imag())};
+        CHECK(std::abs(b - a) < 100.0f);
+        CHECK(std::abs(b) == doctest::Approx(8000.0f).epsilon(0.05));
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "dsp_coded_squelch.hpp"
+#include "dcs.hpp"
+#include "doctest.h"
+
+#include <cmath>
+
+namespace {
+
+constexpr uint32_t sampling_rate = 1500;
+
+/* Uniform noise without <random>. */
+int16_t noise(uint32_t& state, const int16_t amplitude) {
+    state = state * 1664525 + 1013904223;
+    return static_cast<int32_t>(state >> 16) % (2 * amplitude + 1) - amplitude;
+}
+
+dsp::CTCSSDetector::Detection detect_tone(const float frequency, const int16_t amplitude, const int16_t noise_amplitude) {
+    dsp::CTCSSDetector detector;
+    detector.configure(sampling_rate);
+
+    uint32_t state = 1;
+    for (size_t n = 0; n < 2 * dsp::CTCSSDetector::window_size; n++) {
+        const float tone = amplitude * std::sin(2 * M_PI * frequency * n / sampling_rate);
+        detector.execute(static_cast<int16_t>(tone) + noise(state, noise_amplitude));
+    }
+    return detector.detect();
+}
+
+}  // namespace
+
+TEST_CASE("CTCSS detector tells neighbouring tones apart") {
+    const auto low = detect_tone(67.0f, 4000, 500);
+    CHECK(low.tone_x100 == 6700);
+    CHECK(low.confidence >= 80);
+
+    const auto high = detect_tone(69.3f, 4000, 500);
+    CHECK(high.tone_x100 == 6930);
+    CHECK(high.confidence >= 80);
+
+    CHECK(detect_tone(254.1f, 4000, 500).tone_x100 == 25410);
+}
+
+TEST_CASE("CTCSS detector has no confidence in noise") {
+    CHECK(detect_tone(100.0f, 0, 4000).confidence < 10);
+}
+
+TEST_CASE("DCS match finds the code in any rotation") {
+    const uint32_t word = dcs::dcs_word(023);
+    CHECK(dsp::DCSDecoder::match(word) == 023);
+
+    const uint32_t rotated = ((word >> 5) | (word << 18)) & 0x7FFFFF;
+    CHECK(dsp::DCSDecoder::match(rotated) == 023);
+
+    // 076 is a rotation of the standard 754.
+    CHECK(dsp::DCSDecoder::match(dcs::dcs_word(0076)) == 0754);
+
+    CHECK(dsp::DCSDecoder::match(0x2AAAAA) < 0);
+}
+
+TEST_CASE("DCS decoder locks on a repeated word") {
+    dsp::DCSDecoder decoder;
+    decoder.configure(sampling_rate);
+
+    const uint32_t word = dcs::dcs_word(0754);
+    const float samples_per_bit = sampling_rate / 134.4f;
+    uint32_t state = 1;
+    for (size_t n = 0; n < sampling_rate; n++) {
+        // Start off the bit boundary so the clock has to catch up.
+        const size_t bit = static_cast<size_t>((n + 4) / samples_per_bit) % 23;
+        const int16_t level = ((word >> bit) & 1) ? 6000 : -6000;
+        decoder.execute(level + noise(state, 2000));
+    }
+
+    CHECK(decoder.locked());
+    CHECK(decoder.code() == 0754);
+    CHECK_FALSE(decoder.inverted());
+    CHECK(decoder.confidence() == 100);
+}
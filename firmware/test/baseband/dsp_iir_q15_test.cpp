@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "dsp_iir.hpp"
+#include "dsp_iir_config.hpp"
+#include "doctest.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+/* Runs the same tone through the float and Q15 filters and returns the
+ * largest difference in LSBs once both have settled. */
+int32_t max_error(const iir_biquad_config_t& config, const float frequency, const float fs, const int16_t amplitude) {
+    IIRBiquadFilter filter_f32{config};
+    IIRBiquadFilterQ15 filter_q15{config};
+
+    std::array<float, 32> block_f32;
+    std::array<int16_t, 32> block_s16;
+    const buffer_f32_t buffer_f32{block_f32.data(), block_f32.size()};
+    const buffer_s16_t buffer_s16{block_s16.data(), block_s16.size()};
+
+    int32_t error = 0;
+    size_t n = 0;
+    for (size_t block = 0; block < 200; block++) {
+        for (size_t i = 0; i < block_s16.size(); i++, n++) {
+            block_s16[i] = amplitude * std::sin(2 * M_PI * frequency * n / fs);
+            block_f32[i] = block_s16[i] / 32768.0f;
+        }
+
+        filter_f32.execute_in_place(buffer_f32);
+        filter_q15.execute_in_place(buffer_s16);
+
+        if (block >= 50) {
+            for (size_t i = 0; i < block_s16.size(); i++)
+                error = std::max<int32_t>(error, std::abs(block_s16[i] - std::lround(block_f32[i] * 32768.0f)));
+        }
+    }
+    return error;
+}
+
+}  // namespace
+
+TEST_CASE("Q15 biquad tracks the float filter") {
+    CHECK(max_error(audio_24k_hpf_300hz_config, 1000.0f, 24000.0f, 16000) <= 2);
+    CHECK(max_error(audio_24k_hpf_300hz_config, 100.0f, 24000.0f, 16000) <= 2);
+    CHECK(max_error(audio_24k_deemph_300_6_config, 3000.0f, 24000.0f, 16000) <= 2);
+    CHECK(max_error(non_audio_hpf_config, 5000.0f, 24000.0f, 8000) <= 2);
+}
+
+TEST_CASE("Q15 biquad settles to silence") {
+    IIRBiquadFilterQ15 filter{audio_24k_hpf_300hz_config};
+    std::array<int16_t, 32> block;
+    const buffer_s16_t buffer{block.data(), block.size()};
+
+    block.fill(20000);
+    filter.execute_in_place(buffer);
+    for (size_t i = 0; i < 100; i++) {
+        block.fill(0);
+        filter.execute_in_place(buffer);
+    }
+    CHECK(std::all_of(block.begin(), block.end(), [](int16_t s) { return s == 0; }));
+}
+
+TEST_CASE("Q15 biquad saturates instead of wrapping") {
+    // Gain of 2 on a full scale input.
+    constexpr iir_biquad_config_t gain_2{{{2.0f, 0.0f, 0.0f}}, {{1.0f, 0.0f, 0.0f}}};
+    IIRBiquadFilterQ15 filter{gain_2};
+    std::array<int16_t, 4> block{{30000, -30000, 1000, -1000}};
+    const buffer_s16_t buffer{block.data(), block.size()};
+
+    filter.execute_in_place(buffer);
+    CHECK(block[0] == 32767);
+    CHECK(block[1] == -32768);
+    CHECK(block[2] == 2000);
+    CHECK(block[3] == -2000);
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "dsp_spectrum_power.hpp"
+#include "doctest.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace dsp::spectrum;
+
+namespace {
+
+/* The float path: window, power relative to a Q15 full scale, dBV. */
+float float_db(
+    const std::complex<float>* const bins,
+    const size_t i,
+    const size_t mask,
+    const float scale,
+    const float c0,
+    const float c1,
+    const float c2) {
+    const auto b = [bins, mask, scale](const size_t j) { return bins[j & mask] * (scale / 32768.0f); };
+    const auto s = b(i) * c0 + (b(i - 1) + b(i + 1)) * c1 + (b(i - 2) + b(i + 2)) * c2;
+    return 10.0f * std::log10(std::norm(s));
+}
+
+/* Uniform in [-1, 1). */
+float next_random(uint32_t& state) {
+    state = state * 1664525 + 1013904223;
+    return static_cast<int32_t>(state) / 2147483648.0f;
+}
+
+float byte_to_db(const uint8_t byte) {
+    return (byte - 255) / 5.0f;
+}
+
+}  // namespace
+
+TEST_CASE("power_log2 is within 0.02 of log2") {
+    for (uint32_t power = 1; power <= power_full_scale; power += 1 + power / 97) {
+        const float expected = std::log2(static_cast<float>(power));
+        CHECK(std::abs(power_log2(power) / 256.0f - expected) < 0.02f);
+    }
+}
+
+TEST_CASE("power_to_db_byte maps full scale to 255 and clamps below the range") {
+    CHECK(power_to_db_byte(power_full_scale) == 255);
+    CHECK(power_to_db_byte(power_full_scale / 2) == 255 - 15);
+    CHECK(power_to_db_byte(1) == 0);
+    CHECK(power_to_db_byte(0) == 0);
+}
+
+TEST_CASE("fixed point bins are within 0.5 dB of the float path") {
+    constexpr size_t n = 256;
+    constexpr size_t mask = n - 1;
+    struct Case {
+        Window window;
+        float c0, c1, c2;
+    };
+    const Case cases[] = {
+        {window_none, 1.0f, 0.0f, 0.0f},
+        {window_hamming, 0.54f, -0.23f, 0.0f},
+        {window_blackman, 0.42f, -0.25f, 0.004f},
+    };
+
+    uint32_t rng = 1234;
+    std::vector<std::complex<float>> bins(n);
+    size_t compared = 0;
+
+    for (const auto& c : cases) {
+        for (size_t frame = 0; frame < 16; frame++) {
+            // Bins from the noise floor to above full scale, as an FFT of int16 samples would give.
+            const float level = std::pow(10.0f, (frame * 4.0f - 10.0f) / 20.0f) * 32768.0f;
+            for (auto& b : bins)
+                b = {next_random(rng) * level, next_random(rng) * level};
+
+            for (size_t i = 0; i < n; i++) {
+                const auto db = float_db(bins.data(), i, mask, 1.0f, c.c0, c.c1, c.c2);
+                const auto byte = power_to_db_byte(window_mag2(bins.data(), i, mask, 1.0f, c.window));
+
+                if (db > -50.0f && db < 0.0f) {
+                    CHECK(std::abs(byte_to_db(byte) - db) <= 0.5f);
+                    compared++;
+                } else if (db >= 0.0f) {
+                    CHECK(byte >= 254);
+                }
+            }
+        }
+    }
+    CHECK(compared > 1000);
+}
+
+TEST_CASE("shorter FFTs are scaled to the same level") {
+    constexpr size_t n = 64;
+    std::vector<std::complex<float>> bins(n, {0.0f, 0.0f});
+    bins[3] = {0.25f * 32768.0f * n, 0.0f};
+    const auto full = power_to_db_byte(window_mag2(bins.data(), 3, n - 1, 256.0f / n, window_none));
+
+    std::vector<std::complex<float>> long_bins(256, {0.0f, 0.0f});
+    long_bins[12] = {0.25f * 32768.0f * 256, 0.0f};
+    const auto reference = power_to_db_byte(window_mag2(long_bins.data(), 12, 255, 1.0f, window_none));
+
+    CHECK(full == reference);
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "dsp_tx_synth.hpp"
+#include "doctest.h"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace dsp::synth;
+
+namespace {
+
+constexpr uint32_t sampling_rate = 1536000;
+
+/* Frequency from the sign changes of a real signal. */
+float measure_frequency(const std::vector<int32_t>& samples) {
+    size_t crossings = 0;
+    for (size_t i = 1; i < samples.size(); i++) {
+        if ((samples[i - 1] < 0) != (samples[i] < 0))
+            crossings++;
+    }
+    return crossings * 0.5f * sampling_rate / samples.size();
+}
+
+/* Mean frequency of an IQ signal from its phase steps. */
+float measure_frequency(const std::vector<complex8_t>& samples) {
+    float sum = 0;
+    for (size_t i = 1; i < samples.size(); i++) {
+        const auto a = std::arg(std::complex<float>(samples[i - 1].real(), samples[i - 1].imag()));
+        const auto b = std::arg(std::complex<float>(samples[i].real(), samples[i].imag()));
+        sum += std::remainder(b - a, 2 * M_PI);
+    }
+    return sum / (samples.size() - 1) * sampling_rate / (2 * M_PI);
+}
+
+/* Source of alternating symbols, count of them. */
+struct Alternating {
+    size_t count;
+    size_t calls{0};
+
+    bool operator()(uint8_t& symbol) {
+        if (calls == count)
+            return false;
+        symbol = calls++ & 1;
+        return true;
+    }
+};
+
+template <typename F>
+double samples_per_second(const size_t samples, F&& f) {
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    f();
+    const std::chrono::duration<double> elapsed = clock::now() - start;
+    return samples / elapsed.count();
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("TX synthesis");
+
+TEST_CASE("NCO should run at the frequency of its delta.") {
+    NCO nco;
+    nco.set_delta(phase_delta(12000, sampling_rate));
+
+    std::vector<int32_t> samples(15360);
+    for (auto& s : samples)
+        s = nco.next();
+
+    CHECK(measure_frequency(samples) == doctest::Approx(12000).epsilon(0.01));
+}
+
+TEST_CASE("NCOBank should stay within the int8 range.") {
+    NCOBank<2> bank;
+    bank[0].set_delta(phase_delta(697, sampling_rate));
+    bank[1].set_delta(phase_delta(1209, sampling_rate));
+
+    int32_t minimum = 0;
+    int32_t maximum = 0;
+    for (size_t i = 0; i < 20000; i++) {
+        const auto sample = bank.next();
+        minimum = std::min(minimum, sample);
+        maximum = std::max(maximum, sample);
+    }
+
+    CHECK_GE(minimum, -128);
+    CHECK_LE(maximum, 127);
+    CHECK_GE(maximum, 100);
+}
+
+TEST_CASE("FMModulator should deviate with the modulating sample.") {
+    FMModulator fm;
+    fm.set_fm_delta(fm_delta(5000, sampling_rate));
+
+    std::vector<complex8_t> samples(4096);
+    for (auto& s : samples)
+        s = fm.modulate(64);
+
+    // Half scale, a quarter of the bandwidth (fm_delta rounds down).
+    const float expected = 64.0f * fm_delta(5000, sampling_rate) / 4294967296.0f * sampling_rate;
+    CHECK(measure_frequency(samples) == doctest::Approx(expected).epsilon(0.02));
+    CHECK(expected == doctest::Approx(1250).epsilon(0.1));
+}
+
+TEST_CASE("FSKModulator should hold each symbol for samples_per_symbol samples.") {
+    FSKModulator<2> fsk;
+    fsk.configure(64, {phase_delta(-10000, sampling_rate), phase_delta(10000, sampling_rate)});
+
+    std::vector<complex8_t> samples(1024);
+    Alternating source{10};
+    const buffer_c8_t buffer{samples.data(), samples.size(), sampling_rate};
+
+    CHECK_FALSE(fsk.execute(buffer, source));
+    CHECK_FALSE(fsk.running());
+    CHECK_EQ(source.calls, 10);
+
+    const std::vector<complex8_t> space(samples.begin(), samples.begin() + 64);
+    const std::vector<complex8_t> mark(samples.begin() + 64, samples.begin() + 128);
+    CHECK(measure_frequency(space) == doctest::Approx(-10000).epsilon(0.02));
+    CHECK(measure_frequency(mark) == doctest::Approx(10000).epsilon(0.02));
+
+    // Zero once the data is over.
+    CHECK_NE(samples[639], complex8_t{0, 0});
+    CHECK_EQ(samples[640], complex8_t{0, 0});
+    CHECK_EQ(samples[1023], complex8_t{0, 0});
+}
+
+TEST_CASE("AFSKModulator should carry each symbol's tone.") {
+    AFSKModulator<2> afsk;
+    afsk.configure(
+        sampling_rate / 100,
+        {phase_delta(2200, sampling_rate), phase_delta(1200, sampling_rate)},
+        fm_delta(3000, sampling_rate));
+
+    std::vector<complex8_t> samples(sampling_rate / 100);
+    Alternating source{1};
+    const buffer_c8_t buffer{samples.data(), samples.size(), sampling_rate};
+
+    CHECK(afsk.execute(buffer, source));
+    CHECK(afsk.running());
+
+    // The carrier phase moved over a few samples follows the audio tone, the
+    // int8 phasors are too coarse to look at single steps.
+    constexpr size_t lag = 64;
+    size_t transitions = 0;
+    bool positive = false;
+    for (size_t i = lag; i < samples.size(); i++) {
+        const auto a = std::arg(std::complex<float>(samples[i - lag].real(), samples[i - lag].imag()));
+        const auto b = std::arg(std::complex<float>(samples[i].real(), samples[i].imag()));
+        const auto step = std::remainder(b - a, 2 * M_PI);
+        if ((positive && (step < -0.2)) || (!positive && (step > 0.2))) {
+            positive = !positive;
+            transitions++;
+        }
+    }
+    const float frequency = transitions * 0.5f * sampling_rate / (samples.size() - lag);
+    CHECK(frequency == doctest::Approx(2200).epsilon(0.05));
+}
+
+TEST_CASE("IFFTSynthesizer should turn a bin into a tone.") {
+    IFFTSynthesizer<256> ifft;
+    std::vector<complex8_t> out(64);
+
+    ifft.clear(64);
+    CHECK_FALSE(ifft.synthesize(out.data()));
+    CHECK_EQ(out[10], complex8_t{0, 0});
+
+    ifft.clear(64);
+    ifft.set_centered_bin(0, {100, 0});
+    CHECK(ifft.synthesize(out.data()));
+    for (const auto& s : out)
+        CHECK_EQ(s, complex8_t{120, 0});
+
+    // Bin 8 of 64 is 1/8 of the sampling rate, negative bins wrap to the top.
+    ifft.clear(64);
+    ifft.set_centered_bin(-8, {100, 0});
+    CHECK(ifft.synthesize(out.data()));
+    CHECK(measure_frequency(out) == doctest::Approx(-(sampling_rate / 8.0f)).epsilon(0.02));
+}
+
+TEST_CASE("Benchmark TX synthesis.") {
+    constexpr size_t block = 2048;
+    constexpr size_t blocks = 500;
+    std::vector<complex8_t> samples(block);
+    const buffer_c8_t buffer{samples.data(), samples.size(), sampling_rate};
+
+    NCOBank<2> tones;
+    FMModulator fm;
+    tones[0].set_delta(phase_delta(697, sampling_rate));
+    tones[1].set_delta(phase_delta(1209, sampling_rate));
+    fm.set_fm_delta(fm_delta(5000, sampling_rate));
+    const auto tone_rate = samples_per_second(block * blocks, [&] {
+        for (size_t b = 0; b < blocks; b++) {
+            for (auto& s : samples)
+                s = fm.modulate(tones.next());
+        }
+    });
+
+    FSKModulator<2> fsk;
+    fsk.configure(32, {phase_delta(-10000, sampling_rate), phase_delta(10000, sampling_rate)});
+    Alternating fsk_source{block * blocks};
+    const auto fsk_rate = samples_per_second(block * blocks, [&] {
+        for (size_t b = 0; b < blocks; b++)
+            fsk.execute(buffer, fsk_source);
+    });
+
+    AFSKModulator<2> afsk;
+    afsk.configure(1280, {phase_delta(2200, sampling_rate), phase_delta(1200, sampling_rate)}, fm_delta(3000, sampling_rate));
+    Alternating afsk_source{block * blocks};
+    const auto afsk_rate = samples_per_second(block * blocks, [&] {
+        for (size_t b = 0; b < blocks; b++)
+            afsk.execute(buffer, afsk_source);
+    });
+
+    IFFTSynthesizer<1024> ifft;
+    std::vector<complex8_t> line(1024);
+    const auto ifft_rate = samples_per_second(line.size() * 50, [&] {
+        for (size_t b = 0; b < 50; b++) {
+            ifft.clear(line.size());
+            for (int32_t k = -256; k < 256; k++)
+                ifft.set_centered_bin(k, {100, 0});
+            ifft.synthesize(line.data());
+        }
+    });
+
+    MESSAGE("Dual tone FM: " << tone_rate / 1e6 << " Msamples/s");
+    MESSAGE("FSK: " << fsk_rate / 1e6 << " Msamples/s");
+    MESSAGE("AFSK: " << afsk_rate / 1e6 << " Msamples/s");
+    MESSAGE("IFFT (1024): " << ifft_rate / 1e6 << " Msamples/s");
+    CHECK(fsk.running());
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "matched_filter.hpp"
+#include "ais_baseband.hpp"
+#include "doctest.h"
+
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace dsp::matched_filter;
+
+namespace {
+
+// Same shape as the TPMS FSK filter: 16 taps, 2 cycles of sinusoid.
+constexpr std::array<std::complex<float>, 16> rect_taps_16{{
+    {6.2500000000e-02f, 0.0000000000e+00f},
+    {4.4194173824e-02f, 4.4194173824e-02f},
+    {0.0000000000e+00f, 6.2500000000e-02f},
+    {-4.4194173824e-02f, 4.4194173824e-02f},
+    {-6.2500000000e-02f, 0.0000000000e+00f},
+    {-4.4194173824e-02f, -4.4194173824e-02f},
+    {0.0000000000e+00f, -6.2500000000e-02f},
+    {4.4194173824e-02f, -4.4194173824e-02f},
+    {6.2500000000e-02f, 0.0000000000e+00f},
+    {4.4194173824e-02f, 4.4194173824e-02f},
+    {0.0000000000e+00f, 6.2500000000e-02f},
+    {-4.4194173824e-02f, 4.4194173824e-02f},
+    {-6.2500000000e-02f, 0.0000000000e+00f},
+    {-4.4194173824e-02f, -4.4194173824e-02f},
+    {0.0000000000e+00f, -6.2500000000e-02f},
+    {4.4194173824e-02f, -4.4194173824e-02f},
+}};
+
+/* FSK test signal: tone at +/-deviation switching every symbol, plus noise. */
+std::vector<complex16_t> make_fsk(size_t count, float deviation, size_t samples_per_symbol, float amplitude) {
+    std::vector<complex16_t> result;
+    std::srand(1234);
+    float phase = 0.0f;
+    float sign = 1.0f;
+    for (size_t n = 0; n < count; n++) {
+        if ((n % samples_per_symbol) == 0) sign = (std::rand() & 1) ? 1.0f : -1.0f;
+        phase += sign * 2.0f * pi * deviation;
+        const float noise_r = ((std::rand() % 2001) - 1000) * amplitude * 0.0001f;
+        const float noise_i = ((std::rand() % 2001) - 1000) * amplitude * 0.0001f;
+        result.push_back({static_cast<int16_t>(amplitude * std::cos(phase) + noise_r),
+                          static_cast<int16_t>(amplitude * std::sin(phase) + noise_i)});
+    }
+    return result;
+}
+
+template <class T>
+void check_equivalence(const T& taps, size_t decimation, const std::vector<complex16_t>& input) {
+    MatchedFilter mf_float{taps, decimation};
+    MatchedFilterQ15 mf_q15{taps, decimation};
+
+    std::vector<float> out_float;
+    std::vector<float> out_q15;
+    for (const auto& s : input) {
+        const bool a = mf_float.execute_once(s);
+        const bool b = mf_q15.execute_once(s);
+        REQUIRE(a == b);
+        if (a) {
+            out_float.push_back(mf_float.get_output());
+            out_q15.push_back(mf_q15.get_output());
+        }
+    }
+
+    REQUIRE(out_float.size() == input.size() / decimation);
+
+    float peak = 0.0f;
+    for (auto v : out_float) peak = std::max(peak, std::abs(v));
+    REQUIRE(peak > 0.0f);
+
+    size_t sign_mismatches = 0;
+    for (size_t i = 0; i < out_float.size(); i++) {
+        // Magnitude approximation is within ~3% of each term.
+        CHECK(std::abs(out_float[i] - out_q15[i]) <= peak * 0.08f);
+        if (std::abs(out_float[i]) > peak * 0.1f && ((out_float[i] < 0) != (out_q15[i] < 0)))
+            sign_mismatches++;
+    }
+    CHECK(sign_mismatches == 0);
+}
+
+}  // namespace
+
+TEST_CASE("MatchedFilterQ15 produces output on the same decimation phase") {
+    MatchedFilterQ15 mf{rect_taps_16, 8};
+    for (size_t i = 0; i < 7; i++)
+        CHECK_FALSE(mf.execute_once({100, 0}));
+    CHECK(mf.execute_once({100, 0}));
+}
+
+TEST_CASE("MatchedFilterQ15 of zero input is zero") {
+    MatchedFilterQ15 mf{rect_taps_16, 8};
+    for (size_t i = 0; i < 64; i++)
+        mf.execute_once({0, 0});
+    CHECK(mf.get_output() == 0.0f);
+}
+
+TEST_CASE("MatchedFilterQ15 matches float MatchedFilter, TPMS taps") {
+    // 307.2k sample rate, 38.4k deviation, 19.2k symbols.
+    check_equivalence(rect_taps_16, 8, make_fsk(4096, 38400.0f / 307200.0f, 16, 12000.0f));
+}
+
+TEST_CASE("MatchedFilterQ15 matches float MatchedFilter, AIS taps") {
+    // 38.4k sample rate, 2.4k deviation, 9.6k symbols.
+    check_equivalence(baseband::ais::square_taps_38k4_1t_p, 2, make_fsk(4096, 2400.0f / 38400.0f, 4, 20000.0f));
+}
+
+TEST_CASE("MatchedFilterQ15 does not overflow at full scale input") {
+    std::vector<complex16_t> input;
+    for (size_t n = 0; n < 1024; n++) {
+        // Worst case for the accumulators: samples aligned with every tap.
+        const auto tap = rect_taps_16[(15 - (n % 16))];
+        input.push_back({static_cast<int16_t>(tap.real() >= 0 ? 32767 : -32768),
+                         static_cast<int16_t>(tap.imag() >= 0 ? 32767 : -32768)});
+    }
+    check_equivalence(rect_taps_16, 8, input);
+}
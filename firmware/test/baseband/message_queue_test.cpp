@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <ch.h>
+#include <hal.h>
+
+// The queue's barriers and dispatch timer, on the host.
+#undef halGetCounterValue
+#define halGetCounterValue() 0
+#define __DMB() __sync_synchronize()
+
+#include "message_queue.hpp"
+#include "doctest.h"
+
+#include <cstdint>
+#include <vector>
+
+extern "C" {
+void chMtxInit(Mutex*) {}
+bool_t chMtxTryLock(Mutex*) {
+    return TRUE;
+}
+Mutex* chMtxUnlock(void) {
+    return nullptr;
+}
+}
+
+void MessageQueue::signal() {}
+
+namespace {
+
+/* A message with N bytes of payload, padded to 4 bytes like any message. */
+template <size_t N>
+struct TestMessage : public Message {
+    constexpr TestMessage(const uint8_t tag)
+        : Message{ID::RequestSignal} {
+        for (auto& b : payload)
+            b = tag;
+    }
+
+    uint8_t payload[N];
+};
+
+struct Dispatched {
+    uint8_t tag;
+    size_t offset;
+};
+
+/* Dispatches everything queued, records each message's tag and offset in data. */
+std::vector<Dispatched> drain(MessageQueue& queue, const uint8_t* const data) {
+    std::vector<Dispatched> dispatched{};
+    queue.handle([&dispatched, data](Message* const message) {
+        const auto p = reinterpret_cast<const uint8_t*>(message);
+        dispatched.push_back({p[sizeof(Message)], static_cast<size_t>(p - data)});
+    });
+    return dispatched;
+}
+
+}  // namespace
+
+TEST_CASE("message queue dispatches records in place, 4 byte aligned") {
+    alignas(4) uint8_t data[64]{};
+    MessageQueue queue{data, 6};
+
+    CHECK(queue.push(TestMessage<1>{1}));
+    CHECK(queue.push(TestMessage<2>{2}));
+    CHECK(queue.push(TestMessage<7>{3}));
+
+    // 4 byte headers, then messages of 8, 8 and 12 bytes.
+    const auto dispatched = drain(queue, data);
+    REQUIRE(dispatched.size() == 3);
+    CHECK(dispatched[0].tag == 1);
+    CHECK(dispatched[0].offset == 4);
+    CHECK(dispatched[1].tag == 2);
+    CHECK(dispatched[1].offset == 16);
+    CHECK(dispatched[2].tag == 3);
+    CHECK(dispatched[2].offset == 28);
+    CHECK(queue.is_empty());
+    CHECK(queue.stats().dispatched == 3);
+    CHECK(queue.stats().high_water == 40);
+}
+
+TEST_CASE("message queue pads the end of the buffer with a filler record") {
+    alignas(4) uint8_t data[64]{};
+    MessageQueue queue{data, 6};
+
+    // 24 byte messages, 28 byte records.
+    CHECK(queue.push(TestMessage<17>{1}));
+    CHECK(queue.push(TestMessage<17>{2}));
+    CHECK(drain(queue, data).size() == 2);
+
+    // 8 bytes are left at the end, the record goes to the start instead.
+    CHECK(queue.push(TestMessage<17>{3}));
+    CHECK(queue.push(TestMessage<1>{4}));
+
+    const auto dispatched = drain(queue, data);
+    REQUIRE(dispatched.size() == 2);
+    CHECK(dispatched[0].tag == 3);
+    CHECK(dispatched[0].offset == 4);
+    CHECK(dispatched[1].tag == 4);
+    CHECK(dispatched[1].offset == 32);
+    CHECK(queue.is_empty());
+    CHECK(queue.stats().dropped == 0);
+}
+
+TEST_CASE("message queue drops pushes when full") {
+    alignas(4) uint8_t data[64]{};
+    MessageQueue queue{data, 6};
+
+    CHECK(queue.push(TestMessage<17>{1}));
+    CHECK(queue.push(TestMessage<17>{2}));
+    // 8 bytes free, but the record doesn't fit at the end and the start is taken.
+    CHECK_FALSE(queue.push(TestMessage<1>{3}));
+    CHECK(queue.stats().pushed == 2);
+    CHECK(queue.stats().dropped == 1);
+
+    // Once drained, the next record goes to the start after a filler.
+    CHECK(drain(queue, data).size() == 2);
+    CHECK(queue.push(TestMessage<17>{4}));
+    CHECK(queue.push(TestMessage<17>{5}));
+    CHECK_FALSE(queue.push(TestMessage<1>{6}));
+    CHECK(queue.stats().dropped == 2);
+    CHECK(queue.stats().high_water == 64);
+
+    const auto dispatched = drain(queue, data);
+    REQUIRE(dispatched.size() == 2);
+    CHECK(dispatched[0].tag == 4);
+    CHECK(dispatched[1].tag == 5);
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2024 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "packed_iq.hpp"
+#include "doctest.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/* Packs offset binary codes the way packed_iq.hpp documents it. */
+std::vector<uint8_t> pack(const std::vector<uint8_t>& codes, const uint8_t bits) {
+    std::vector<uint8_t> packed(codes.size() * bits / 8);
+    for (size_t i = 0; i < codes.size(); i++)
+        packed[i * bits / 8] |= codes[i] << ((i * bits) % 8);
+    return packed;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("Packed IQ");
+
+TEST_CASE("unpack should map 2 bit codes to symmetric levels.") {
+    const auto packed = pack({0, 1, 2, 3, 3, 2, 1, 0}, 2);
+    std::vector<complex8_t> out(4);
+
+    REQUIRE_EQ(packed_iq::unpack(packed.data(), packed.size(), out.data(), 2), 4);
+    CHECK_EQ(out[0], complex8_t{-96, -32});
+    CHECK_EQ(out[1], complex8_t{32, 96});
+    CHECK_EQ(out[2], complex8_t{96, 32});
+    CHECK_EQ(out[3], complex8_t{-32, -96});
+}
+
+TEST_CASE("unpack should map 4 bit codes to symmetric levels.") {
+    const auto packed = pack({0, 15, 7, 8}, 4);
+    std::vector<complex8_t> out(2);
+
+    REQUIRE_EQ(packed_iq::unpack(packed.data(), packed.size(), out.data(), 4), 2);
+    CHECK_EQ(out[0], complex8_t{-120, 120});
+    CHECK_EQ(out[1], complex8_t{-8, 8});
+}
+
+TEST_CASE("unpack should pass 8 bit samples through.") {
+    const std::vector<uint8_t> packed{0x01, 0xFF, 0x80, 0x7F};
+    std::vector<complex8_t> out(2);
+
+    REQUIRE_EQ(packed_iq::unpack(packed.data(), packed.size(), out.data(), 8), 2);
+    CHECK_EQ(out[0], complex8_t{1, -1});
+    CHECK_EQ(out[1], complex8_t{-128, 127});
+}
+
+TEST_CASE("unpack should work in place from the tail of the buffer.") {
+    constexpr size_t count = 2048;
+
+    for (const uint8_t bits : {2, 4}) {
+        std::vector<uint8_t> codes(count * 2);
+        for (size_t i = 0; i < codes.size(); i++)
+            codes[i] = (i * 7 + i / 5) & ((1 << bits) - 1);
+        const auto packed = pack(codes, bits);
+
+        std::vector<complex8_t> expected(count);
+        packed_iq::unpack(packed.data(), packed.size(), expected.data(), bits);
+
+        std::vector<complex8_t> buffer(count);
+        const auto bytes = packed_iq::packed_size(count, bits);
+        REQUIRE_EQ(bytes, packed.size());
+        auto tail = reinterpret_cast<uint8_t*>(buffer.data() + count) - bytes;
+        std::copy(packed.begin(), packed.end(), tail);
+
+        // A short read leaves the packed bytes at the start of the tail.
+        const auto samples = packed_iq::unpack(tail, bytes / 2, buffer.data(), bits);
+        CHECK_EQ(samples, count / 2);
+        CHECK(std::equal(buffer.begin(), buffer.begin() + samples, expected.begin()));
+
+        std::copy(packed.begin(), packed.end(), tail);
+        CHECK_EQ(packed_iq::unpack(tail, bytes, buffer.data(), bits), count);
+        CHECK(buffer == expected);
+    }
+}
+
+TEST_CASE("is_valid should check the header.") {
+    packed_iq::Header header{packed_iq::header_magic, packed_iq::header_version, 4, 0, 2600000, 0};
+    CHECK(packed_iq::is_valid(header));
+
+    header.bits = 3;
+    CHECK_FALSE(packed_iq::is_valid(header));
+
+    header.bits = 2;
+    header.magic = 0;
+    CHECK_FALSE(packed_iq::is_valid(header));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2024 PortaPack Mayhem contributors
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+# Converts world_map.bin (u16 width, u16 height, RGB565 rows) into the tiled
+# world_map.tiles format read by GeoMap (see application/geomap_tiles.hpp).
+# Each zoom-out scale gets its own box-filtered level so the map view only
+# reads the pixels it shows.
+
+import argparse
+import struct
+import sys
+
+import numpy as np
+
+FILE_VERSION = 1
+FILE_HEADER = struct.Struct('<4sHHHHHH')
+LEVEL_HEADER = struct.Struct('<HHHHI')
+
+
+def ceil_div(a, b):
+    return -(-a // b)
+
+
+def rgb565_to_rgb(pixels):
+    r = (pixels >> 11) & 0x1f
+    g = (pixels >> 5) & 0x3f
+    b = pixels & 0x1f
+    return np.stack([r, g, b], axis=-1).astype(np.uint32)
+
+
+def rgb_to_rgb565(rgb):
+    rgb = np.rint(rgb).astype(np.uint16)
+    return (rgb[..., 0] << 11) | (rgb[..., 1] << 5) | rgb[..., 2]
+
+
+def downscale(pixels, scale):
+    # Box filter scale x scale blocks, replicating the edge for partial blocks.
+    if scale == 1:
+        return pixels
+    h, w = pixels.shape
+    pad_h = (-h) % scale
+    pad_w = (-w) % scale
+    rgb = rgb565_to_rgb(np.pad(pixels, ((0, pad_h), (0, pad_w)), mode='edge'))
+    rgb = rgb.reshape((h + pad_h) // scale, scale, (w + pad_w) // scale, scale, 3)
+    return rgb_to_rgb565(rgb.mean(axis=(1, 3)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert world_map.bin to tiled world_map.tiles')
+    parser.add_argument('input', nargs='?', default='../../sdcard/ADSB/world_map.bin')
+    parser.add_argument('output', nargs='?', default='../../sdcard/ADSB/world_map.tiles')
+    parser.add_argument('--tile-size', type=int, default=16,
+                        help='tile width/height in pixels (8-64); 16 lets the M0 cache a full row of tiles')
+    parser.add_argument('--scales', default='1,2,3,4,5,6,7,8,9,10',
+                        help='comma separated zoom-out scales, must include 1')
+    args = parser.parse_args()
+
+    ts = args.tile_size
+    scales = sorted(set(int(s) for s in args.scales.split(',')))
+    if not 8 <= ts <= 64 or scales[0] != 1 or len(scales) > 16:
+        sys.exit('invalid tile size or scales')
+
+    with open(args.input, 'rb') as f:
+        width, height = struct.unpack('<HH', f.read(4))
+    source = np.memmap(args.input, dtype='<u2', mode='r', offset=4, shape=(height, width))
+    print('image \t width=' + str(width) + '\theight=' + str(height) + ' pixels')
+
+    tile_bytes = ts * ts * 2
+    levels = []
+    offset = FILE_HEADER.size + LEVEL_HEADER.size * len(scales)
+    for scale in scales:
+        tiles_x = ceil_div(ceil_div(width, scale), ts)
+        tiles_y = ceil_div(ceil_div(height, scale), ts)
+        levels.append((scale, tiles_x, tiles_y, offset))
+        offset += tiles_x * tiles_y * tile_bytes
+
+    with open(args.output, 'wb') as out:
+        out.write(FILE_HEADER.pack(b'PPMT', FILE_VERSION, ts, width, height, len(scales), 0))
+        for scale, tiles_x, tiles_y, level_offset in levels:
+            out.write(LEVEL_HEADER.pack(scale, tiles_x, tiles_y, 0, level_offset))
+
+        for scale, tiles_x, tiles_y, level_offset in levels:
+            assert out.tell() == level_offset
+            band_rows = ts * scale
+            for ty in range(tiles_y):
+                band = downscale(np.asarray(source[ty * band_rows:(ty + 1) * band_rows]), scale)
+                # Pad with black to whole tiles.
+                padded = np.zeros((ts, tiles_x * ts), dtype='<u2')
+                padded[:band.shape[0], :band.shape[1]] = band
+                tiles = padded.reshape(ts, tiles_x, ts).transpose(1, 0, 2)
+                out.write(np.ascontiguousarray(tiles, dtype='<u2').tobytes())
+                print('scale ' + str(scale) + ': ' + str(ty + 1) + '/' + str(tiles_y) + '\r', end='')
+            print('')
+
+    print('Ready: ' + args.output)
+
+
+if __name__ == '__main__':
+    main()
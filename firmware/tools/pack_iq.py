@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+
+# Converts a C8 capture to a packed IQ file for the GPS Sim app.
+# Components are quantized to 2 or 4 bits offset binary, see
+# firmware/common/packed_iq.hpp for the format.
+
+import argparse
+import struct
+
+MAGIC = 0x51494B50  # "PKIQ"
+VERSION = 1
+
+parser = argparse.ArgumentParser(description="Pack a C8 IQ file to 2 or 4 bits per component.")
+parser.add_argument("input", help="C8 file")
+parser.add_argument("output", help="packed IQ file")
+parser.add_argument("-b", "--bits", type=int, choices=[2, 4], default=2, help="bits per component")
+parser.add_argument("-s", "--sample-rate", type=int, default=0, help="sample rate, 0 to use the metadata file")
+args = parser.parse_args()
+
+per_byte = 8 // args.bits
+shift = 8 - args.bits
+CHUNK_SIZE = 1 << 16  # Input bytes per read, a multiple of per_byte.
+
+# Per position in an output byte, the offset binary code of a signed
+# component, already shifted into place.
+luts = [bytes((((b ^ 0x80) >> shift) << (k * args.bits)) for b in range(256)) for k in range(per_byte)]
+
+def pack(chunk):
+	count = len(chunk) // per_byte
+	packed = 0
+	for k, lut in enumerate(luts):
+		packed |= int.from_bytes(chunk[k:count * per_byte:per_byte].translate(lut), "little")
+	return packed.to_bytes(count, "little")
+
+with open(args.input, "rb") as f_in, open(args.output, "wb") as f_out:
+	f_out.write(struct.pack("<IBBHII", MAGIC, VERSION, args.bits, 0, args.sample_rate, 0))
+	# A trailing partial byte of components is dropped.
+	while True:
+		chunk = f_in.read(CHUNK_SIZE)
+		if not chunk:
+			break
+		f_out.write(pack(chunk))